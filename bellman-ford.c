@@ -8,64 +8,37 @@
  * to all other vertices in a weighted graph. Unlike Dijkstra's algorithm,
  * it can handle negative edge weights and detect negative cycles.
  *
+ * The algorithm itself lives in libgraph (src/shortest_path.c); this
+ * program only builds the example graph and prints the result.
+ *
+ * Usage:
+ *   bellman-ford                         (demo on the built-in graph)
+ *   bellman-ford graph.gcsr source [--binary] [--output file] [--path t]...
+ *                [--checkpoint file [--interval seconds]]
+ *
+ * With a graph file the raw dist/parent arrays are written as text lines
+ * or in the binary result format (see graph_output.h), and full paths
+ * are only rebuilt for the --path targets. --checkpoint snapshots the
+ * distances every --interval seconds (default 60) and resumes from the
+ * snapshot if the file exists, so a killed run can be restarted with the
+ * same command line.
+ *
  * Time Complexity: O(VE)
  * Space Complexity: O(V)
  */
 
+#define _POSIX_C_SOURCE 200809L // For open()
+
 #include <stdio.h>
 #include <stdlib.h>
-#include <limits.h>
+#include <string.h>
 #include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
 
-#define INF INT_MAX
-
-/**
- * @brief Structure to represent an edge in the graph
- */
-struct Edge
-{
-    int src;    // Source vertex
-    int dest;   // Destination vertex
-    int weight; // Weight of the edge
-};
-
-/**
- * @brief Structure to represent a graph
- */
-struct Graph
-{
-    int V;             // Number of vertices
-    int E;             // Number of edges
-    struct Edge *edge; // Array of edges
-};
-/**
- * @brief Create a graph with V vertices and E edges
- * @param V Number of vertices
- * @param E Number of edges
- * @return Pointer to the created graph
- */
-struct Graph *createGraph(int V, int E)
-{
-    struct Graph *graph = (struct Graph *)malloc(sizeof(struct Graph));
-    if (!graph)
-    {
-        printf("Memory allocation failed!\n");
-        exit(1);
-    }
-
-    graph->V = V;
-    graph->E = E;
-    graph->edge = (struct Edge *)malloc(graph->E * sizeof(struct Edge));
-
-    if (!graph->edge)
-    {
-        printf("Memory allocation failed!\n");
-        free(graph);
-        exit(1);
-    }
-
-    return graph;
-}
+#include "graph.h"
+#include "graph_output.h"
+#include "checkpoint.h"
 
 /**
  * @brief Print the shortest distances and paths from source
@@ -85,7 +58,7 @@ void printSolution(int dist[], int n, int parent[])
     {
         printf("║   %d    │", i);
 
-        if (dist[i] == INF)
+        if (dist[i] == GRAPH_INF)
         {
             printf("    ∞    │ No path available");
         }
@@ -93,159 +66,188 @@ void printSolution(int dist[], int n, int parent[])
         {
             printf("   %3d   │ ", dist[i]);
 
-            // Print path by backtracking through parent array
+            // Print the path from the source
             int path[n], pathLength = 0;
-            int current = i;
-
-            // Build path in reverse order
-            while (current != -1)
-            {
-                path[pathLength++] = current;
-                current = parent[current];
-            }
-
-            // Print path in correct order
-            for (int j = pathLength - 1; j >= 0; j--)
+            graphPathTo(n, parent, i, path, &pathLength);
+            for (int j = 0; j < pathLength; j++)
             {
                 printf("%d", path[j]);
-                if (j > 0)
+                if (j < pathLength - 1)
                     printf(" → ");
             }
         }
 
         // Add padding for alignment
-        printf("%*s║\n", (int)(37 - (dist[i] == INF ? 18 : 0)), "");
+        printf("%*s║\n", (int)(37 - (dist[i] == GRAPH_INF ? 18 : 0)), "");
     }
     printf("╚═══════════════════════════════════════════════════════════════╝\n");
 }
 
 /**
- * @brief Implementation of Bellman-Ford shortest path algorithm
- * @param graph Pointer to the graph structure
+ * @brief Run Bellman-Ford from libgraph and print the result
+ * @param graph Graph to search
  * @param src Source vertex
  * @return true if no negative cycle exists, false otherwise
  */
-bool BellmanFord(struct Graph *graph, int src)
+bool BellmanFord(const struct Graph *graph, int src)
 {
-    int V = graph->V;
-    int E = graph->E;
+    int V = graphVertexCount(graph);
     int dist[V];
     int parent[V]; // Array to store parent vertices for path reconstruction
 
-    // Step 1: Initialize distances and parents
-    for (int i = 0; i < V; i++)
+    printf("🔄 Relaxing edges (at most V-1 = %d iterations)...\n", V - 1);
+    int status = graphBellmanFord(graph, src, dist, parent);
+
+    if (status == GRAPH_NEGATIVE_CYCLE)
+    {
+        printf("❌ Negative cycle detected!\n");
+        printf("   The graph contains a negative-weight cycle reachable from source.\n");
+        printf("   Shortest distances are not well-defined.\n");
+        return false;
+    }
+    if (status != GRAPH_OK)
     {
-        dist[i] = INF;
-        parent[i] = -1;
+        printf("❌ Bellman-Ford failed: %s\n", graphStatusMessage(status));
+        return false;
     }
-    dist[src] = 0;
 
-    // Step 2: Relax all edges V-1 times
-    printf("🔄 Relaxing edges (V-1 = %d iterations)...\n", V - 1);
-    for (int i = 1; i <= V - 1; i++)
+    printf("✅ No negative cycles found.\n\n");
+
+    // Print the computed distances and paths
+    printSolution(dist, V, parent);
+    return true;
+}
+
+/**
+ * @brief Run Bellman-Ford on a graph file and write the raw result
+ * @param argc Number of arguments
+ * @param argv graph.gcsr source [--binary] [--output file] [--path t]...
+ *             [--checkpoint file [--interval seconds]]
+ * @return 0 on success, 1 on failure, 2 on a usage error
+ */
+int solveFile(int argc, char *argv[])
+{
+    if (argc < 3)
     {
-        bool updated = false;
+        fprintf(stderr, "Usage: %s graph.gcsr source [--binary] [--output file] [--path t]...\n"
+                        "       [--checkpoint file [--interval seconds]]\n",
+                argv[0]);
+        return 2;
+    }
 
-        for (int j = 0; j < E; j++)
+    int format = GRAPH_OUTPUT_TEXT;
+    const char *output = NULL;
+    struct GraphCheckpointConfig checkpoint = {NULL, 60.0, true};
+    int *targets = malloc(argc * sizeof(int));
+    int targetCount = 0;
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--binary") == 0)
         {
-            int u = graph->edge[j].src;
-            int v = graph->edge[j].dest;
-            int weight = graph->edge[j].weight;
-
-            if (dist[u] != INF && dist[u] + weight < dist[v])
-            {
-                dist[v] = dist[u] + weight;
-                parent[v] = u; // Update parent for path reconstruction
-                updated = true;
-            }
+            format = GRAPH_OUTPUT_BINARY;
         }
-
-        // Early termination if no updates in this iteration
-        if (!updated)
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (strcmp(argv[i], "--path") == 0 && i + 1 < argc && targets)
         {
-            printf("✅ Converged early at iteration %d\n", i);
-            break;
+            targets[targetCount++] = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc)
+        {
+            checkpoint.path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc)
+        {
+            checkpoint.interval = atof(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            free(targets);
+            return 2;
         }
     }
 
-    // Step 3: Check for negative cycles
-    printf("🔍 Checking for negative cycles...\n");
-    for (int i = 0; i < E; i++)
+    struct Graph *graph = NULL;
+    int status = targets ? graphLoad(argv[1], &graph) : GRAPH_NO_MEMORY;
+    int n = graph ? graphVertexCount(graph) : 0;
+    int *dist = malloc(n * sizeof(int) + 1);
+    int *parent = malloc(n * sizeof(int) + 1);
+    if (status == GRAPH_OK)
     {
-        int u = graph->edge[i].src;
-        int v = graph->edge[i].dest;
-        int weight = graph->edge[i].weight;
-
-        if (dist[u] != INF && dist[u] + weight < dist[v])
-        {
-            printf("❌ Negative cycle detected!\n");
-            printf("   The graph contains a negative-weight cycle reachable from source.\n");
-            printf("   Shortest distances are not well-defined.\n");
-            return false;
-        }
+        status = !dist || !parent ? GRAPH_NO_MEMORY
+                 : checkpoint.path
+                     ? graphBellmanFordCheckpointed(graph, NULL, atoi(argv[2]), &checkpoint, dist,
+                                                    parent, NULL)
+                     : graphBellmanFord(graph, atoi(argv[2]), dist, parent);
     }
 
-    printf("✅ No negative cycles found.\n\n");
+    int fd = output ? open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDOUT_FILENO;
+    if (status == GRAPH_OK)
+    {
+        status = fd < 0 ? GRAPH_IO_ERROR : graphWriteResult(fd, format, n, atoi(argv[2]), dist, parent);
+    }
+    if (status == GRAPH_OK && targetCount > 0)
+    {
+        // Paths go next to the text result, or to stdout beside a binary file
+        int pathFd = format == GRAPH_OUTPUT_BINARY ? STDOUT_FILENO : fd;
+        status = graphWritePaths(pathFd, n, dist, parent, targets, targetCount);
+    }
+    if (output && fd >= 0 && close(fd) != 0 && status == GRAPH_OK)
+    {
+        status = GRAPH_IO_ERROR;
+    }
 
-    // Print the computed distances and paths
-    printSolution(dist, V, parent);
-    return true;
+    if (status != GRAPH_OK)
+    {
+        fprintf(stderr, "❌ Bellman-Ford failed: %s\n", graphStatusMessage(status));
+    }
+    graphFree(graph);
+    free(dist);
+    free(parent);
+    free(targets);
+    return status == GRAPH_OK ? 0 : 1;
 }
 
 /**
  * @brief Main function demonstrating Bellman-Ford algorithm
+ * @param argc Number of arguments
+ * @param argv Arguments (a graph file switches to solveFile())
  * @return 0 on successful execution
  */
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1)
+    {
+        return solveFile(argc, argv);
+    }
+
     printf("🔗 Graph Theory Algorithms - Bellman-Ford Shortest Path\n");
     printf("=======================================================\n\n");
 
     // Create a graph with 5 vertices and 8 edges
     int V = 5; // Number of vertices
     int E = 8; // Number of edges
-    struct Graph *graph = createGraph(V, E);
-
-    // Add edges to the graph
-    // Edge 0: 0 → 1 with weight -1
-    graph->edge[0].src = 0;
-    graph->edge[0].dest = 1;
-    graph->edge[0].weight = -1;
-
-    // Edge 1: 0 → 2 with weight 4
-    graph->edge[1].src = 0;
-    graph->edge[1].dest = 2;
-    graph->edge[1].weight = 4;
-
-    // Edge 2: 1 → 2 with weight 3
-    graph->edge[2].src = 1;
-    graph->edge[2].dest = 2;
-    graph->edge[2].weight = 3;
-
-    // Edge 3: 1 → 3 with weight 2
-    graph->edge[3].src = 1;
-    graph->edge[3].dest = 3;
-    graph->edge[3].weight = 2;
-
-    // Edge 4: 1 → 4 with weight 2
-    graph->edge[4].src = 1;
-    graph->edge[4].dest = 4;
-    graph->edge[4].weight = 2;
-
-    // Edge 5: 3 → 2 with weight 5
-    graph->edge[5].src = 3;
-    graph->edge[5].dest = 2;
-    graph->edge[5].weight = 5;
-
-    // Edge 6: 3 → 1 with weight 1
-    graph->edge[6].src = 3;
-    graph->edge[6].dest = 1;
-    graph->edge[6].weight = 1;
-
-    // Edge 7: 4 → 3 with weight -3
-    graph->edge[7].src = 4;
-    graph->edge[7].dest = 3;
-    graph->edge[7].weight = -3;
+    struct GraphEdge edges[] = {
+        {0, 1, -1}, // Edge 0: 0 → 1 with weight -1
+        {0, 2, 4},  // Edge 1: 0 → 2 with weight 4
+        {1, 2, 3},  // Edge 2: 1 → 2 with weight 3
+        {1, 3, 2},  // Edge 3: 1 → 3 with weight 2
+        {1, 4, 2},  // Edge 4: 1 → 4 with weight 2
+        {3, 2, 5},  // Edge 5: 3 → 2 with weight 5
+        {3, 1, 1},  // Edge 6: 3 → 1 with weight 1
+        {4, 3, -3}, // Edge 7: 4 → 3 with weight -3
+    };
+
+    struct Graph *graph;
+    int status = graphCreate(V, E, edges, true, &graph);
+    if (status != GRAPH_OK)
+    {
+        printf("❌ Cannot create graph: %s\n", graphStatusMessage(status));
+        return 1;
+    }
 
     // Display graph information
     printf("Input Graph (Edge List):\n");
@@ -253,10 +255,7 @@ int main()
     printf("Edge List:\n");
     for (int i = 0; i < E; i++)
     {
-        printf("  %d → %d (weight: %d)\n",
-               graph->edge[i].src,
-               graph->edge[i].dest,
-               graph->edge[i].weight);
+        printf("  %d → %d (weight: %d)\n", edges[i].u, edges[i].v, edges[i].weight);
     }
     printf("\nSource vertex: 0\n\n");
 
@@ -270,8 +269,7 @@ int main()
     }
 
     // Clean up memory
-    free(graph->edge);
-    free(graph);
+    graphFree(graph);
 
     return 0;
 }
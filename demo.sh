@@ -46,6 +46,7 @@ run_algorithm "Bellman-Ford Shortest Path Algorithm" "bellman-ford"
 run_algorithm "Kruskal's Minimum Spanning Tree Algorithm" "kruskal"
 run_algorithm "Prim's Minimum Spanning Tree Algorithm" "prim"
 run_algorithm "Ford-Fulkerson Maximum Flow Algorithm" "ford-fulkerson"
+run_algorithm "Min-Cost Maximum Flow Engine" "min-cost-flow"
 
 echo "🎉 Demo completed! All algorithms have been demonstrated."
 echo ""
@@ -55,5 +56,6 @@ echo "  ./build/bellman-ford"
 echo "  ./build/kruskal"
 echo "  ./build/prim"
 echo "  ./build/ford-fulkerson"
+echo "  ./build/min-cost-flow"
 echo ""
 echo "To recompile: make clean && make all"
@@ -7,38 +7,34 @@
  * Dijkstra's algorithm finds the shortest paths from a source vertex
  * to all other vertices in a weighted graph with non-negative edge weights.
  *
- * Time Complexity: O(V²)
+ * The algorithm itself lives in libgraph (src/shortest_path.c); this
+ * program only builds the example graph and prints the result.
+ *
+ * Usage:
+ *   dijkstra                         (demo on the built-in graph)
+ *   dijkstra graph.gcsr source [--binary] [--output file] [--path t]...
+ *
+ * With a graph file the raw dist/parent arrays are written as text lines
+ * or in the binary result format (see graph_output.h), and full paths
+ * are only rebuilt for the --path targets.
+ *
+ * Time Complexity: O((V + E) log V)
  * Space Complexity: O(V)
  */
 
+#define _POSIX_C_SOURCE 200809L // For open()
+
 #include <stdio.h>
-#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
 
-#define V 5 // Number of vertices in the graph
-#define INF INT_MAX
+#include "graph.h"
+#include "graph_output.h"
 
-/**
- * @brief Find the vertex with minimum distance value from the set of vertices
- *        not yet included in shortest path tree
- * @param dist Array of distance values
- * @param sptSet Array to track vertices included in shortest path tree
- * @return Index of the vertex with minimum distance
- */
-int minDistance(int dist[], bool sptSet[])
-{
-    int min = INF, min_index = -1;
-
-    for (int v = 0; v < V; v++)
-    {
-        if (!sptSet[v] && dist[v] <= min)
-        {
-            min = dist[v];
-            min_index = v;
-        }
-    }
-    return min_index;
-}
+#define V 5 // Number of vertices in the graph
 
 /**
  * @brief Print the shortest distances and paths from source to all vertices
@@ -57,22 +53,13 @@ void printSolution(int dist[], int parent[])
     {
         printf("║   %d    │    %2d    │ ", i, dist[i]);
 
-        // Print path by backtracking through parent array
+        // Print the path from the source
         int path[V], pathLength = 0;
-        int current = i;
-
-        // Build path in reverse order
-        while (current != -1)
-        {
-            path[pathLength++] = current;
-            current = parent[current];
-        }
-
-        // Print path in correct order
-        for (int j = pathLength - 1; j >= 0; j--)
+        graphPathTo(V, parent, i, path, &pathLength);
+        for (int j = 0; j < pathLength; j++)
         {
             printf("%d", path[j]);
-            if (j > 0)
+            if (j < pathLength - 1)
                 printf(" → ");
         }
 
@@ -88,65 +75,126 @@ void printSolution(int dist[], int parent[])
 }
 
 /**
- * @brief Implementation of Dijkstra's shortest path algorithm
+ * @brief Run Dijkstra's algorithm from libgraph and print the result
  * @param graph Adjacency matrix representation of the graph
  * @param src Source vertex
+ * @return GRAPH_OK, or the library status if the search failed
  */
-void dijkstra(int graph[V][V], int src)
+int dijkstra(int graph[V][V], int src)
 {
-    int dist[V];    // Array to hold shortest distance from src to each vertex
-    int parent[V];  // Array to store parent vertices for path reconstruction
-    bool sptSet[V]; // Boolean array to track vertices in shortest path tree
+    int dist[V];   // Array to hold shortest distance from src to each vertex
+    int parent[V]; // Array to store parent vertices for path reconstruction
 
-    // Initialize all distances as infinite and sptSet as false
-    for (int i = 0; i < V; i++)
+    struct Graph *g = NULL;
+    int status = graphFromMatrix(V, &graph[0][0], true, &g);
+    if (status == GRAPH_OK)
     {
-        dist[i] = INF;
-        sptSet[i] = false;
-        parent[i] = -1;
+        status = graphDijkstra(g, src, dist, parent);
     }
+    graphFree(g);
 
-    // Distance from source to itself is always 0
-    dist[src] = 0;
-
-    // Find shortest path for all vertices
-    for (int count = 0; count < V - 1; count++)
+    if (status != GRAPH_OK)
     {
-        // Pick the minimum distance vertex not yet processed
-        int u = minDistance(dist, sptSet);
+        printf("❌ Dijkstra failed: %s\n", graphStatusMessage(status));
+        return status;
+    }
 
-        if (u == -1)
-            break; // All remaining vertices are unreachable
+    // Print the computed distances and paths
+    printSolution(dist, parent);
+    return GRAPH_OK;
+}
 
-        // Mark the picked vertex as processed
-        sptSet[u] = true;
+/**
+ * @brief Run Dijkstra's algorithm on a graph file and write the raw result
+ * @param argc Number of arguments
+ * @param argv graph.gcsr source [--binary] [--output file] [--path t]...
+ * @return 0 on success, 1 on failure, 2 on a usage error
+ */
+int solveFile(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s graph.gcsr source [--binary] [--output file] [--path t]...\n",
+                argv[0]);
+        return 2;
+    }
 
-        // Update distance values of the adjacent vertices
-        for (int v = 0; v < V; v++)
+    int format = GRAPH_OUTPUT_TEXT;
+    const char *output = NULL;
+    int *targets = malloc(argc * sizeof(int));
+    int targetCount = 0;
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--binary") == 0)
         {
-            // Update dist[v] if:
-            // 1. v is not in sptSet
-            // 2. there is an edge from u to v
-            // 3. total weight of path from src to v through u is smaller than current value
-            if (!sptSet[v] && graph[u][v] && dist[u] != INF &&
-                dist[u] + graph[u][v] < dist[v])
-            {
-                dist[v] = dist[u] + graph[u][v];
-                parent[v] = u; // Set parent for path reconstruction
-            }
+            format = GRAPH_OUTPUT_BINARY;
+        }
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (strcmp(argv[i], "--path") == 0 && i + 1 < argc && targets)
+        {
+            targets[targetCount++] = atoi(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            free(targets);
+            return 2;
         }
     }
 
-    // Print the computed distances and paths
-    printSolution(dist, parent);
+    struct Graph *graph = NULL;
+    int status = targets ? graphLoad(argv[1], &graph) : GRAPH_NO_MEMORY;
+    int n = graph ? graphVertexCount(graph) : 0;
+    int *dist = malloc(n * sizeof(int) + 1);
+    int *parent = malloc(n * sizeof(int) + 1);
+    if (status == GRAPH_OK)
+    {
+        status = dist && parent ? graphDijkstra(graph, atoi(argv[2]), dist, parent) : GRAPH_NO_MEMORY;
+    }
+
+    int fd = output ? open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDOUT_FILENO;
+    if (status == GRAPH_OK)
+    {
+        status = fd < 0 ? GRAPH_IO_ERROR : graphWriteResult(fd, format, n, atoi(argv[2]), dist, parent);
+    }
+    if (status == GRAPH_OK && targetCount > 0)
+    {
+        // Paths go next to the text result, or to stdout beside a binary file
+        int pathFd = format == GRAPH_OUTPUT_BINARY ? STDOUT_FILENO : fd;
+        status = graphWritePaths(pathFd, n, dist, parent, targets, targetCount);
+    }
+    if (output && fd >= 0 && close(fd) != 0 && status == GRAPH_OK)
+    {
+        status = GRAPH_IO_ERROR;
+    }
+
+    if (status != GRAPH_OK)
+    {
+        fprintf(stderr, "❌ Dijkstra failed: %s\n", graphStatusMessage(status));
+    }
+    graphFree(graph);
+    free(dist);
+    free(parent);
+    free(targets);
+    return status == GRAPH_OK ? 0 : 1;
 }
 
 /**
  * @brief Main function demonstrating Dijkstra's algorithm
+ * @param argc Number of arguments
+ * @param argv Arguments (a graph file switches to solveFile())
  * @return 0 on successful execution
  */
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1)
+    {
+        return solveFile(argc, argv);
+    }
+
     printf("🔗 Graph Theory Algorithms - Dijkstra's Shortest Path\n");
     printf("=====================================================\n\n");
 
@@ -187,7 +235,10 @@ int main()
     printf("\nSource vertex: 0\n\n");
 
     // Run Dijkstra's algorithm starting from vertex 0
-    dijkstra(graph, 0);
+    if (dijkstra(graph, 0) != GRAPH_OK)
+    {
+        return 1;
+    }
 
     printf("\n💡 Note: This algorithm works only with non-negative edge weights.\n");
     printf("   For graphs with negative weights, use Bellman-Ford algorithm.\n");
@@ -0,0 +1,903 @@
+/**
+ * @file graph-bench.c
+ * @brief Benchmark harness for the libgraph algorithms on synthetic or
+ *        file-based graphs
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Usage:
+ *   graph-bench [--graph rmat|er|grid|bipartite] [--scale S] [--degree D]
+ *               [--max-weight W] [--directed] [--shuffle] [--seed N]
+ *               [--input graph.gcsr] [--reorder degree|rcm|gorder]
+ *               [--compress exact|w16|w8|matrix]
+ *               [--algo a,b,...] [--runs R] [--warmup K] [--threads T]
+ *               [--pin] [--pages normal|transparent|explicit]
+ *               [--numa local|interleave|first-touch] [--format csv|json] [--stats]
+ *               [--trace info|debug|verbose] [--trace-file path]
+ *
+ * The graph has 2^S vertices (a 2^(S/2) × 2^(S - S/2) grid; a bipartite
+ * network with 2^(S-1) vertices per side) and about D edges per vertex.
+ * Every algorithm runs K untimed warm-up queries and then R timed ones
+ * from pseudo-random sources. One row per algorithm reports the median,
+ * 90th and 99th percentile and extreme times, graph edges per second of
+ * the median run, the peak resident set size so far and the bytes the
+ * graph holds. Rows are written to stdout as CSV or JSON; errors go to
+ * stderr.
+ *
+ * With --compress the graph is replaced by its graphCompress() copy
+ * after reordering; algorithms that need the edge list are skipped.
+ *
+ * --threads T sizes the library's shared thread pool (see
+ * graphThreadPoolConfigure()) that bfs-parallel runs on, and --pin binds
+ * its workers to CPUs across NUMA nodes. --pages and --numa choose the
+ * page size and NUMA placement of the graph, workspace and result arrays
+ * (see graphMemoryConfigure()). JSON output describes the pool and the
+ * memory policies that took effect.
+ *
+ * With --stats (JSON only, libgraph built with make stats) every row of
+ * a workspace query also carries the struct GraphStats of its timed runs.
+ * With --trace (libgraph built with make trace) the library's JSON-lines
+ * trace goes to stderr or the --trace-file.
+ *
+ * Algorithms: dijkstra, dijkstra-ws, dijkstra-cached (source-to-target
+ * paths from BENCH_HOT_SOURCES sources through a path cache),
+ * bellman-ford, bellman-ford-batch (BENCH_BATCH sources per query), bfs,
+ * bfs-parallel, kruskal, prim, components, maxflow, maxflow-ws (default:
+ * all; spanning trees are skipped on directed graphs).
+ */
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime() and getrusage()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#include "graph.h"
+#include "graph_gen.h"
+
+#define DEFAULT_SCALE 14
+#define DEFAULT_DEGREE 8
+#define DEFAULT_MAX_WEIGHT 100
+#define DEFAULT_RUNS 5
+#define DEFAULT_WARMUP 1
+#define BENCH_BATCH 16 // Sources per bellman-ford-batch query
+#define BENCH_HOT_SOURCES 4                   // Distinct sources of dijkstra-cached
+#define BENCH_CACHE_BYTES (64LL * 1024 * 1024) // Budget of the dijkstra-cached path cache
+#define BENCH_LARGE_BYTES (2u << 20)           // Arrays from this size follow --pages and --numa
+
+/**
+ * @brief Structure to hold the command-line settings
+ */
+struct BenchConfig
+{
+    const char *generator;  // rmat, er, grid or bipartite
+    const char *input;      // Graph file to load instead (NULL = generate)
+    const char *algorithms; // Comma-separated list, or NULL for all
+    const char *reorderName; // Vertex order, or NULL to keep the input order
+    const char *compressName; // Compression, or NULL to keep the CSR arrays
+    int scale;              // log2 of the number of vertices
+    int degree;             // Edges per vertex
+    int maxWeight;          // Largest weight or capacity
+    int runs;               // Timed runs per algorithm
+    int warmup;             // Untimed runs per algorithm
+    int threads;            // Threads of the pool bfs-parallel runs on (0 = all CPUs)
+    bool pin;               // Bind the pool's workers to CPUs
+    int pages;              // enum GraphPagePolicy of the large arrays
+    int numa;               // enum GraphNumaPolicy of the large arrays
+    unsigned long long seed; // Seed of the generator and the query sources
+    bool directed;          // Generate a directed graph (rmat, er)
+    bool shuffle;           // Randomly relabel generated vertices
+    bool json;              // JSON instead of CSV
+    bool stats;             // Add the library statistics to every row
+    int traceLevel;         // enum GraphTraceLevel of the library trace
+    const char *traceFile;  // Trace destination (NULL = stderr)
+};
+
+/**
+ * @brief Structure to hold everything a benchmarked query needs
+ */
+struct BenchContext
+{
+    struct Graph *graph;
+    struct GraphWorkspace *workspace;
+    int threads;
+    int *dist;
+    int *parent;
+    int *weight;
+    int *edgeFlow;
+    struct GraphEdge *tree;
+    int *batchDist; // BENCH_BATCH × n distances of bellman-ford-batch
+    struct GraphPathCache *cache; // Path cache of dijkstra-cached
+};
+
+/**
+ * @brief Structure to describe one benchmarked algorithm
+ */
+struct BenchAlgorithm
+{
+    const char *name;
+    int (*run)(struct BenchContext *ctx, int source, int target);
+    bool usesWorkspace; // Runs on ctx->workspace, so its statistics apply
+};
+
+/**
+ * @brief Timing summary of one algorithm
+ */
+struct BenchResult
+{
+    double median, p90, p99, min, max; // Milliseconds
+};
+
+static int runDijkstra(struct BenchContext *ctx, int source, int target)
+{
+    (void)target;
+    return graphDijkstra(ctx->graph, source, ctx->dist, ctx->parent);
+}
+
+static int runDijkstraWs(struct BenchContext *ctx, int source, int target)
+{
+    (void)target;
+    return graphDijkstraWs(ctx->graph, ctx->workspace, source, ctx->dist, ctx->parent);
+}
+
+static int runDijkstraCached(struct BenchContext *ctx, int source, int target)
+{
+    // A few hot sources, as in depot traffic: all but the first queries hit
+    int length, distance;
+    return graphShortestPathCached(ctx->graph, ctx->workspace, ctx->cache,
+                                   source % BENCH_HOT_SOURCES, target, ctx->parent, &length,
+                                   &distance);
+}
+
+static int runBellmanFord(struct BenchContext *ctx, int source, int target)
+{
+    (void)target;
+    return graphBellmanFordWs(ctx->graph, ctx->workspace, source, ctx->dist, ctx->parent);
+}
+
+static int runBellmanFordBatch(struct BenchContext *ctx, int source, int target)
+{
+    (void)target;
+    int n = graphVertexCount(ctx->graph);
+    int sources[BENCH_BATCH], status[BENCH_BATCH];
+    for (int i = 0; i < BENCH_BATCH; i++)
+    {
+        sources[i] = (int)((source + (long long)i * n / BENCH_BATCH) % n);
+    }
+    return graphBellmanFordBatchWs(ctx->graph, ctx->workspace, sources, BENCH_BATCH,
+                                   ctx->batchDist, NULL, status);
+}
+
+static int runBfs(struct BenchContext *ctx, int source, int target)
+{
+    (void)target;
+    return graphBfsWs(ctx->graph, ctx->workspace, source, 1, ctx->dist, ctx->parent);
+}
+
+static int runBfsParallel(struct BenchContext *ctx, int source, int target)
+{
+    (void)target;
+    return graphBfsWs(ctx->graph, ctx->workspace, source, ctx->threads, ctx->dist, ctx->parent);
+}
+
+static int runKruskal(struct BenchContext *ctx, int source, int target)
+{
+    (void)source;
+    (void)target;
+    int count;
+    int status = graphKruskalWs(ctx->graph, ctx->workspace, ctx->tree, &count, NULL);
+    return status == GRAPH_NOT_CONNECTED ? GRAPH_OK : status;
+}
+
+static int runPrim(struct BenchContext *ctx, int source, int target)
+{
+    (void)target;
+    int status = graphPrimWs(ctx->graph, ctx->workspace, source, ctx->parent, ctx->weight, NULL);
+    return status == GRAPH_NOT_CONNECTED ? GRAPH_OK : status;
+}
+
+static int runComponents(struct BenchContext *ctx, int source, int target)
+{
+    (void)source;
+    (void)target;
+    int components, forestEdges;
+    return graphConnectedComponentsWs(ctx->graph, ctx->workspace, ctx->threads, ctx->dist,
+                                      ctx->parent, &components, ctx->tree, &forestEdges);
+}
+
+static int runMaxFlow(struct BenchContext *ctx, int source, int target)
+{
+    // Plain API: a fresh network per query, so no warm start hides the cost
+    int flow;
+    return graphMaxFlow(ctx->graph, source, target, &flow, ctx->edgeFlow);
+}
+
+static int runMaxFlowWs(struct BenchContext *ctx, int source, int target)
+{
+    int flow;
+    return graphMaxFlowWs(ctx->graph, ctx->workspace, source, target, &flow, ctx->edgeFlow);
+}
+
+static const struct BenchAlgorithm algorithms[] = {
+    {"dijkstra", runDijkstra, false},
+    {"dijkstra-ws", runDijkstraWs, true},
+    {"dijkstra-cached", runDijkstraCached, true},
+    {"bellman-ford", runBellmanFord, true},
+    {"bellman-ford-batch", runBellmanFordBatch, true},
+    {"bfs", runBfs, true},
+    {"bfs-parallel", runBfsParallel, true},
+    {"kruskal", runKruskal, true},
+    {"prim", runPrim, true},
+    {"components", runComponents, true},
+    {"maxflow", runMaxFlow, false},
+    {"maxflow-ws", runMaxFlowWs, true},
+};
+
+static const char *const pageNames[] = {"normal", "transparent", "explicit"};
+static const char *const numaNames[] = {"local", "interleave", "first-touch"};
+
+/**
+ * @brief Read a monotonic clock
+ * @return Current time in milliseconds
+ */
+static double nowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * @brief Report the peak resident set size of the process so far
+ * @return Peak RSS in kilobytes
+ */
+static long peakRssKb(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * @brief Draw the next query vertex (xorshift64)
+ * @param state Generator state (non-zero)
+ * @param n Number of vertices
+ * @return Vertex in 0 .. n - 1
+ */
+static int nextVertex(unsigned long long *state, int n)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (int)(*state % (unsigned long long)n);
+}
+
+/**
+ * @brief Order doubles ascending for qsort()
+ * @param a Pointer to the first double
+ * @param b Pointer to the second double
+ * @return Negative, zero or positive as for qsort()
+ */
+static int compareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Summarize a set of run times (nearest-rank percentiles)
+ * @param times Run times in milliseconds (sorted in place)
+ * @param count Number of runs (>= 1)
+ * @return Summary
+ */
+static struct BenchResult summarize(double times[], int count)
+{
+    qsort(times, count, sizeof(double), compareDoubles);
+
+    struct BenchResult r;
+    r.min = times[0];
+    r.max = times[count - 1];
+    r.median = count % 2 ? times[count / 2] : (times[count / 2 - 1] + times[count / 2]) / 2;
+    r.p90 = times[(int)((count * 90 + 99) / 100) - 1];
+    r.p99 = times[(int)((count * 99 + 99) / 100) - 1];
+    return r;
+}
+
+/**
+ * @brief Structure to describe the graph every row refers to
+ */
+struct BenchGraphInfo
+{
+    const char *name;
+    const char *reorder;
+    const char *compress;
+    long long bytes; // Memory the graph holds
+    int n;
+    int edges;
+    bool directed;
+};
+
+/**
+ * @brief Print one result row
+ * @param cfg Settings (output format)
+ * @param info Graph the row refers to
+ * @param algorithm Name of the measured step
+ * @param runs Number of timed runs
+ * @param r Timing summary
+ * @param stats Library statistics of the runs (NULL = none)
+ * @param first true for the first row
+ */
+static void printRow(const struct BenchConfig *cfg, const struct BenchGraphInfo *info,
+                     const char *algorithm, int runs, struct BenchResult r,
+                     const struct GraphStats *stats, bool first)
+{
+    double edgesPerSec = r.median > 0 ? info->edges / (r.median / 1000.0) : 0;
+    long rss = peakRssKb();
+
+    if (cfg->json)
+    {
+        printf("%s\n    {\"algorithm\": \"%s\", \"runs\": %d, \"median_ms\": %.4f, "
+               "\"p90_ms\": %.4f, \"p99_ms\": %.4f, \"min_ms\": %.4f, \"max_ms\": %.4f, "
+               "\"edges_per_sec\": %.0f, \"peak_rss_kb\": %ld, \"graph_bytes\": %lld",
+               first ? "" : ",", algorithm, runs, r.median, r.p90, r.p99, r.min, r.max,
+               edgesPerSec, rss, info->bytes);
+        if (stats)
+        {
+            char json[1024];
+            graphStatsJson(stats, json, sizeof(json));
+            printf(", \"stats\": %s", json);
+        }
+        printf("}");
+    }
+    else
+    {
+        printf("%s,%d,%d,%s,%s,%s,%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.0f,%ld,%lld\n", info->name,
+               info->n, info->edges, info->directed ? "directed" : "undirected", info->reorder,
+               info->compress, algorithm, runs, r.median, r.p90, r.p99, r.min, r.max, edgesPerSec,
+               rss, info->bytes);
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief Check whether an algorithm was selected with --algo
+ * @param list Comma-separated names, or NULL for all
+ * @param name Algorithm name
+ * @return true if the algorithm should run
+ */
+static bool selected(const char *list, const char *name)
+{
+    if (!list)
+    {
+        return true;
+    }
+    size_t len = strlen(name);
+    for (const char *p = list; *p;)
+    {
+        const char *end = strchr(p, ',');
+        size_t itemLen = end ? (size_t)(end - p) : strlen(p);
+        if (itemLen == len && strncmp(p, name, len) == 0)
+        {
+            return true;
+        }
+        p += itemLen + (end ? 1 : 0);
+    }
+    return false;
+}
+
+/**
+ * @brief Find a command-line value in a table of names
+ * @param names Names, indexed by the enum value they stand for
+ * @param count Number of names
+ * @param value Value to look up
+ * @return Index of value, or -1 if it is not in the table
+ */
+static int lookUp(const char *const names[], int count, const char *value)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(value, names[i]) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Write buffered library trace records to a stream
+ * @param context FILE * to write to
+ * @param data Records
+ * @param length Number of bytes
+ */
+static void writeTrace(void *context, const char *data, int length)
+{
+    fwrite(data, 1, length, context);
+}
+
+/**
+ * @brief Generate the edge list described by the settings
+ * @param cfg Settings
+ * @param n Output: number of vertices
+ * @param edgeCount Output: number of edges
+ * @param directed Output: whether the edges are directed
+ * @return Edge list, or NULL on a bad setting or out of memory
+ */
+static struct GraphEdge *generate(const struct BenchConfig *cfg, int *n, int *edgeCount,
+                                  bool *directed)
+{
+    struct GraphEdge *edges = NULL;
+    *directed = cfg->directed;
+
+    if (strcmp(cfg->generator, "rmat") == 0)
+    {
+        *n = 1 << cfg->scale;
+        edges = generateRmat(cfg->scale, cfg->degree, cfg->maxWeight, cfg->seed, edgeCount);
+    }
+    else if (strcmp(cfg->generator, "er") == 0)
+    {
+        *n = 1 << cfg->scale;
+        *edgeCount = cfg->degree * *n;
+        edges = generateErdosRenyi(*n, *edgeCount, cfg->maxWeight, cfg->seed);
+    }
+    else if (strcmp(cfg->generator, "grid") == 0)
+    {
+        int rows = 1 << (cfg->scale / 2), cols = 1 << (cfg->scale - cfg->scale / 2);
+        *n = rows * cols;
+        *directed = false;
+        edges = generateGrid(rows, cols, cfg->maxWeight, cfg->seed, edgeCount);
+    }
+    else if (strcmp(cfg->generator, "bipartite") == 0)
+    {
+        int side = 1 << (cfg->scale - 1);
+        *n = 2 * side + 2;
+        *directed = true;
+        edges = generateBipartiteFlow(side, side, cfg->degree, cfg->maxWeight, cfg->seed,
+                                      edgeCount);
+    }
+
+    if (edges && cfg->shuffle && shuffleVertexIds(*n, edges, *edgeCount, cfg->seed + 1) != GRAPH_OK)
+    {
+        free(edges);
+        edges = NULL;
+    }
+    return edges;
+}
+
+/**
+ * @brief Create the graph to benchmark and report the setup steps
+ * @param cfg Settings
+ * @param info Output: description of the graph
+ * @param rows Number of rows printed so far (updated)
+ * @return Graph, or NULL on failure
+ */
+static struct Graph *setUpGraph(const struct BenchConfig *cfg, struct BenchGraphInfo *info,
+                                int *rows)
+{
+    struct Graph *graph = NULL;
+    struct BenchResult r;
+    int status;
+
+    info->name = cfg->input ? cfg->input : cfg->generator;
+    info->reorder = cfg->reorderName ? cfg->reorderName : "none";
+    info->compress = cfg->compressName ? cfg->compressName : "none";
+
+    if (cfg->input)
+    {
+        double start = nowMs();
+        status = graphLoad(cfg->input, &graph);
+        r.median = r.p90 = r.p99 = r.min = r.max = nowMs() - start;
+        if (status != GRAPH_OK)
+        {
+            fprintf(stderr, "graph-bench: cannot load %s: %s\n", cfg->input,
+                    graphStatusMessage(status));
+            return NULL;
+        }
+        info->n = graphVertexCount(graph);
+        info->edges = graphEdgeCount(graph);
+        info->directed = graphIsDirected(graph);
+        info->bytes = graphMemoryUsage(graph);
+        printRow(cfg, info, "load", 1, r, NULL, (*rows)++ == 0);
+    }
+    else
+    {
+        int n, edgeCount;
+        bool directed;
+        double start = nowMs();
+        struct GraphEdge *edges = generate(cfg, &n, &edgeCount, &directed);
+        r.median = r.p90 = r.p99 = r.min = r.max = nowMs() - start;
+        if (!edges)
+        {
+            fprintf(stderr, "graph-bench: cannot generate a %s graph at scale %d\n",
+                    cfg->generator, cfg->scale);
+            return NULL;
+        }
+        info->n = n;
+        info->edges = edgeCount;
+        info->directed = directed;
+        info->bytes = 0;
+        printRow(cfg, info, "generate", 1, r, NULL, (*rows)++ == 0);
+
+        start = nowMs();
+        status = graphCreate(n, edgeCount, edges, directed, &graph);
+        r.median = r.p90 = r.p99 = r.min = r.max = nowMs() - start;
+        free(edges);
+        if (status != GRAPH_OK)
+        {
+            fprintf(stderr, "graph-bench: %s\n", graphStatusMessage(status));
+            return NULL;
+        }
+        info->bytes = graphMemoryUsage(graph);
+        printRow(cfg, info, "build", 1, r, NULL, (*rows)++ == 0);
+    }
+
+    if (cfg->reorderName)
+    {
+        int order = strcmp(cfg->reorderName, "degree") == 0 ? GRAPH_ORDER_DEGREE
+                    : strcmp(cfg->reorderName, "rcm") == 0  ? GRAPH_ORDER_RCM
+                    : strcmp(cfg->reorderName, "gorder") == 0 ? GRAPH_ORDER_GORDER
+                                                                : -1;
+        struct Graph *reordered = NULL;
+        double start = nowMs();
+        status = graphReorder(graph, order, &reordered);
+        r.median = r.p90 = r.p99 = r.min = r.max = nowMs() - start;
+        graphFree(graph);
+        if (status != GRAPH_OK)
+        {
+            fprintf(stderr, "graph-bench: cannot reorder by %s: %s\n", cfg->reorderName,
+                    graphStatusMessage(status));
+            return NULL;
+        }
+        graph = reordered;
+        info->bytes = graphMemoryUsage(graph);
+        printRow(cfg, info, "reorder", 1, r, NULL, (*rows)++ == 0);
+    }
+
+    if (cfg->compressName)
+    {
+        int compression = strcmp(cfg->compressName, "exact") == 0    ? GRAPH_COMPRESS_EXACT
+                          : strcmp(cfg->compressName, "w16") == 0    ? GRAPH_COMPRESS_WEIGHT16
+                          : strcmp(cfg->compressName, "w8") == 0     ? GRAPH_COMPRESS_WEIGHT8
+                          : strcmp(cfg->compressName, "matrix") == 0 ? GRAPH_COMPRESS_MATRIX
+                                                                     : -1;
+        struct Graph *compressed = NULL;
+        double start = nowMs();
+        status = graphCompress(graph, compression, &compressed);
+        r.median = r.p90 = r.p99 = r.min = r.max = nowMs() - start;
+        graphFree(graph);
+        if (status != GRAPH_OK)
+        {
+            fprintf(stderr, "graph-bench: cannot compress as %s: %s\n", cfg->compressName,
+                    graphStatusMessage(status));
+            return NULL;
+        }
+        graph = compressed;
+        info->bytes = graphMemoryUsage(graph);
+        printRow(cfg, info, "compress", 1, r, NULL, (*rows)++ == 0);
+    }
+    return graph;
+}
+
+/**
+ * @brief Run the benchmark described by the settings
+ * @param cfg Settings
+ * @return 0 on success, 1 on failure
+ */
+static int benchmark(const struct BenchConfig *cfg)
+{
+    struct BenchGraphInfo info;
+    int rows = 0;
+
+    if (cfg->json)
+    {
+        printf("{\n  \"results\": [");
+    }
+    else
+    {
+        printf("graph,vertices,edges,kind,reorder,compress,algorithm,runs,median_ms,p90_ms,p99_ms,"
+               "min_ms,max_ms,edges_per_sec,peak_rss_kb,graph_bytes\n");
+    }
+
+    struct Graph *graph = setUpGraph(cfg, &info, &rows);
+    if (!graph)
+    {
+        return 1;
+    }
+
+    int n = info.n;
+    struct BenchContext ctx = {graph, NULL, cfg->threads, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    ctx.dist = graphAllocLarge(n * sizeof(int) + 1);
+    ctx.parent = graphAllocLarge(n * sizeof(int) + 1);
+    ctx.weight = malloc(n * sizeof(int) + 1);
+    ctx.edgeFlow = malloc(info.edges * sizeof(int) + 1);
+    ctx.tree = malloc(n * sizeof(struct GraphEdge) + 1);
+    ctx.batchDist = graphAllocLarge((size_t)BENCH_BATCH * n * sizeof(int) + 1);
+    double *times = malloc(cfg->runs * sizeof(double));
+    int result = 0;
+
+    if (!ctx.dist || !ctx.parent || !ctx.weight || !ctx.edgeFlow || !ctx.tree || !ctx.batchDist || !times ||
+        graphWorkspaceCreate(&ctx.workspace) != GRAPH_OK ||
+        graphPathCacheCreate(BENCH_CACHE_BYTES, GRAPH_CACHE_LFU, &ctx.cache) != GRAPH_OK)
+    {
+        fprintf(stderr, "graph-bench: out of memory\n");
+        result = 1;
+    }
+
+    // The bipartite generator's terminals are its first and last vertex
+    bool fixedTerminals = !cfg->input && strcmp(cfg->generator, "bipartite") == 0;
+    for (size_t a = 0; result == 0 && a < sizeof(algorithms) / sizeof(algorithms[0]); a++)
+    {
+        const struct BenchAlgorithm *algo = &algorithms[a];
+        if (!selected(cfg->algorithms, algo->name))
+        {
+            continue;
+        }
+
+        unsigned long long state = cfg->seed * 2 + 1;
+        int status = GRAPH_OK;
+        for (int i = 0; i < cfg->warmup + cfg->runs && status == GRAPH_OK; i++)
+        {
+            int source = fixedTerminals ? 0 : nextVertex(&state, n);
+            int target = fixedTerminals ? n - 1 : nextVertex(&state, n);
+
+            if (i == cfg->warmup && ctx.workspace)
+            {
+                graphWorkspaceResetStats(ctx.workspace); // Count the timed runs only
+            }
+
+            double start = nowMs();
+            status = algo->run(&ctx, source, target);
+            if (i >= cfg->warmup)
+            {
+                times[i - cfg->warmup] = nowMs() - start;
+            }
+        }
+
+        if (status == GRAPH_NEEDS_UNDIRECTED || status == GRAPH_NEGATIVE_WEIGHT ||
+            status == GRAPH_NEEDS_EDGE_LIST)
+        {
+            continue; // Not defined on this graph: no row
+        }
+        if (status != GRAPH_OK)
+        {
+            fprintf(stderr, "graph-bench: %s failed: %s\n", algo->name, graphStatusMessage(status));
+            result = 1;
+            break;
+        }
+        struct GraphStats stats;
+        graphWorkspaceStats(ctx.workspace, &stats);
+        printRow(cfg, &info, algo->name, cfg->runs, summarize(times, cfg->runs),
+                 cfg->stats && algo->usesWorkspace ? &stats : NULL, rows++ == 0);
+    }
+
+    if (cfg->json)
+    {
+        struct GraphThreadPoolInfo pool;
+        struct GraphMemoryInfo memory;
+        graphThreadPoolInfo(&pool);
+        graphMemoryInfo(&memory);
+        printf("\n  ],\n  \"graph\": {\"name\": \"%s\", \"vertices\": %d, \"edges\": %d, "
+               "\"directed\": %s, \"reorder\": \"%s\", \"compress\": \"%s\", "
+               "\"bytes\": %lld},\n",
+               info.name, info.n, info.edges, info.directed ? "true" : "false", info.reorder,
+               info.compress, info.bytes);
+        printf("  \"pool\": {\"threads\": %d, \"nodes\": %d, \"pinned\": %s},\n",
+               pool.threads, pool.nodes, pool.pinned ? "true" : "false");
+        printf("  \"memory\": {\"pages\": \"%s\", \"numa\": \"%s\", \"nodes\": %d, "
+               "\"transparent_available\": %s, \"normal_bytes\": %lld, "
+               "\"transparent_bytes\": %lld, \"explicit_bytes\": %lld, "
+               "\"fallbacks\": %lld}\n}\n",
+               pageNames[memory.pages], numaNames[memory.numa], memory.nodes,
+               memory.transparentAvailable ? "true" : "false", memory.normalBytes,
+               memory.transparentBytes, memory.explicitBytes, memory.fallbacks);
+    }
+
+    graphWorkspaceFree(ctx.workspace);
+    graphPathCacheFree(ctx.cache);
+    graphFree(graph);
+    graphFreeLarge(ctx.dist);
+    graphFreeLarge(ctx.parent);
+    free(ctx.weight);
+    free(ctx.edgeFlow);
+    free(ctx.tree);
+    graphFreeLarge(ctx.batchDist);
+    free(times);
+    return result;
+}
+
+/**
+ * @brief Print the usage text
+ * @param program Program name
+ */
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [--graph rmat|er|grid|bipartite] [--scale S] [--degree D]\n"
+            "       [--max-weight W] [--directed] [--shuffle] [--seed N]\n"
+            "       [--input graph.gcsr] [--reorder degree|rcm|gorder]\n"
+            "       [--compress exact|w16|w8|matrix]\n"
+            "       [--algo a,b,...] [--runs R] [--warmup K] [--threads T]\n"
+            "       [--pin] [--pages normal|transparent|explicit]\n"
+            "       [--numa local|interleave|first-touch] [--format csv|json] [--stats]\n"
+            "       [--trace info|debug|verbose] [--trace-file path]\n",
+            program);
+}
+
+/**
+ * @brief Main function of the benchmark harness
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return 0 on success, 1 on failure, 2 on a usage error
+ */
+int main(int argc, char *argv[])
+{
+    struct BenchConfig cfg = {"rmat", NULL, NULL, NULL, NULL, DEFAULT_SCALE, DEFAULT_DEGREE,
+                              DEFAULT_MAX_WEIGHT, DEFAULT_RUNS, DEFAULT_WARMUP, 0,
+                              false, GRAPH_PAGES_NORMAL, GRAPH_NUMA_LOCAL, 1, false, false,
+                              false, false, GRAPH_TRACE_OFF, NULL};
+    static const char *const traceLevels[] = {"off", "info", "debug", "verbose"};
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool takesValue = true;
+
+        if (strcmp(arg, "--directed") == 0)
+        {
+            cfg.directed = true;
+            takesValue = false;
+        }
+        else if (strcmp(arg, "--stats") == 0)
+        {
+            cfg.stats = true;
+            takesValue = false;
+        }
+        else if (strcmp(arg, "--shuffle") == 0)
+        {
+            cfg.shuffle = true;
+            takesValue = false;
+        }
+        else if (strcmp(arg, "--pin") == 0)
+        {
+            cfg.pin = true;
+            takesValue = false;
+        }
+        else if (!value)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else if (strcmp(arg, "--graph") == 0)
+        {
+            cfg.generator = value;
+        }
+        else if (strcmp(arg, "--input") == 0)
+        {
+            cfg.input = value;
+        }
+        else if (strcmp(arg, "--algo") == 0)
+        {
+            cfg.algorithms = value;
+        }
+        else if (strcmp(arg, "--reorder") == 0)
+        {
+            cfg.reorderName = value;
+        }
+        else if (strcmp(arg, "--compress") == 0)
+        {
+            cfg.compressName = value;
+        }
+        else if (strcmp(arg, "--scale") == 0)
+        {
+            cfg.scale = atoi(value);
+        }
+        else if (strcmp(arg, "--degree") == 0)
+        {
+            cfg.degree = atoi(value);
+        }
+        else if (strcmp(arg, "--max-weight") == 0)
+        {
+            cfg.maxWeight = atoi(value);
+        }
+        else if (strcmp(arg, "--runs") == 0)
+        {
+            cfg.runs = atoi(value);
+        }
+        else if (strcmp(arg, "--warmup") == 0)
+        {
+            cfg.warmup = atoi(value);
+        }
+        else if (strcmp(arg, "--threads") == 0)
+        {
+            cfg.threads = atoi(value);
+        }
+        else if (strcmp(arg, "--seed") == 0)
+        {
+            cfg.seed = strtoull(value, NULL, 10);
+        }
+        else if (strcmp(arg, "--trace") == 0)
+        {
+            cfg.traceLevel = -1;
+            for (int level = GRAPH_TRACE_OFF; level <= GRAPH_TRACE_VERBOSE; level++)
+            {
+                if (strcmp(value, traceLevels[level]) == 0)
+                {
+                    cfg.traceLevel = level;
+                }
+            }
+        }
+        else if (strcmp(arg, "--pages") == 0)
+        {
+            cfg.pages = lookUp(pageNames, 3, value);
+        }
+        else if (strcmp(arg, "--numa") == 0)
+        {
+            cfg.numa = lookUp(numaNames, 3, value);
+        }
+        else if (strcmp(arg, "--trace-file") == 0)
+        {
+            cfg.traceFile = value;
+        }
+        else if (strcmp(arg, "--format") == 0 && (strcmp(value, "csv") == 0 || strcmp(value, "json") == 0))
+        {
+            cfg.json = strcmp(value, "json") == 0;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i += takesValue;
+    }
+
+    if (cfg.scale < 2 || cfg.scale > 30 || cfg.degree < 0 || cfg.maxWeight < 1 || cfg.runs < 1 ||
+        cfg.warmup < 0 || cfg.threads < 0 || cfg.pages < 0 || cfg.numa < 0 ||
+        cfg.traceLevel < 0 || (cfg.stats && !cfg.json))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    if (cfg.stats && !graphStatsEnabled())
+    {
+        fprintf(stderr, "graph-bench: libgraph was built without statistics (make clean stats)\n");
+        return 2;
+    }
+    if (cfg.traceLevel > graphTraceMaxLevel())
+    {
+        fprintf(stderr, "graph-bench: libgraph was built without %s tracing (make clean trace)\n",
+                traceLevels[cfg.traceLevel]);
+        return 2;
+    }
+
+    FILE *trace = stderr;
+    if (cfg.traceLevel > GRAPH_TRACE_OFF)
+    {
+        trace = cfg.traceFile ? fopen(cfg.traceFile, "w") : stderr;
+        if (!trace)
+        {
+            fprintf(stderr, "graph-bench: cannot open %s\n", cfg.traceFile);
+            return 1;
+        }
+        graphTraceSet(cfg.traceLevel, writeTrace, trace);
+    }
+
+    graphThreadPoolConfigure(cfg.threads, cfg.pin);
+    struct GraphMemoryConfig memory = {cfg.pages, cfg.numa, BENCH_LARGE_BYTES};
+    graphMemoryConfigure(&memory);
+    int result = benchmark(&cfg);
+    graphThreadPoolShutdown();
+
+    if (cfg.traceLevel > GRAPH_TRACE_OFF)
+    {
+        graphTraceSet(GRAPH_TRACE_OFF, NULL, NULL); // Flushes the last records
+        if (trace != stderr)
+        {
+            fclose(trace);
+        }
+    }
+    return result;
+}
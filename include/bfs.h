@@ -0,0 +1,114 @@
+/**
+ * @file bfs.h
+ * @brief Direction-optimizing parallel breadth-first search engine
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * The engine answers reachability and hop-count queries on graphs stored
+ * as adjacency arrays (CSR). Each level is expanded either top-down (scan
+ * the arcs of the frontier) or bottom-up (let every unvisited vertex look
+ * for a parent in the frontier), whichever is expected to touch fewer
+ * arcs. Frontiers and the visited set are bitmaps, and each level is
+ * split by bitmap words into parts that run on the shared thread pool.
+ */
+
+#ifndef BFS_H
+#define BFS_H
+
+#include <stdbool.h>
+
+struct BfsCounters;
+struct Graph;
+
+/**
+ * @brief Structure to describe a graph for the BFS engine
+ *
+ * Out-arcs of u are target[offset[u] .. offset[u + 1] - 1]. In-arcs of v,
+ * used by bottom-up levels, are inSource[inOffset[v] .. inOffset[v + 1] - 1];
+ * for an undirected graph they can point at the out-arc arrays. If alive
+ * is set, arc a is only followed while alive[a] > 0 (e.g. residual
+ * capacity), which needs inArc to map in-arc k to its out-arc index.
+ *
+ * If compressed is set, arcs are decoded from that graph instead of read
+ * from target and inSource (an undirected graph's out-arcs double as its
+ * in-arcs), and parentArc is not filled in. Without inOffset every level
+ * is expanded top-down.
+ */
+struct BfsGraph
+{
+    int n;               // Number of vertices
+    const int *offset;   // Out-arc offsets (n + 1 entries)
+    const int *target;   // Head of every out-arc
+    const int *inOffset; // In-arc offsets (n + 1 entries)
+    const int *inSource; // Tail of every in-arc
+    const int *inArc;    // Out-arc index of every in-arc (may be NULL)
+    const int *alive;    // Arc filter indexed by out-arc (NULL = all arcs)
+    const struct Graph *compressed; // Compressed graph to decode arcs from (NULL = CSR)
+};
+
+/**
+ * @brief Structure to hold the reusable state of the BFS engine
+ */
+struct BfsEngine
+{
+    int n;                        // Number of vertices the engine was sized for
+    int words;                    // Number of 64-bit words per bitmap
+    int threads;                  // Number of parts each level is split into
+    unsigned long long *visited;  // Visited bitmap
+    unsigned long long *current;  // Frontier bitmap of the level being expanded
+    unsigned long long *next;     // Frontier bitmap being built
+    int levels;                   // Levels expanded by the last search
+    int bottomUpLevels;           // Levels of the last search expanded bottom-up
+    long long arcsScanned;        // Arcs examined by all searches (GRAPH_STATS builds only)
+    struct BfsCounters *counters; // Per-part level counters
+};
+
+/**
+ * @brief Create a BFS engine for graphs with up to n vertices
+ * @param n Number of vertices
+ * @param threads Number of parts per level (0 = threads of the shared pool)
+ * @return Pointer to the created engine, or NULL if memory ran out
+ */
+struct BfsEngine *createBfsEngine(int n, int threads);
+
+/**
+ * @brief Free a BFS engine
+ * @param engine Engine to free (may be NULL)
+ */
+void freeBfsEngine(struct BfsEngine *engine);
+
+/**
+ * @brief Run a breadth-first search from a source vertex
+ *
+ * Every output array is optional (NULL) and has n entries. Unreached
+ * vertices get dist -1 and parent -1; the source gets dist 0 and
+ * parent -1. With target >= 0 the search stops after the level that
+ * reaches target. A search allocates no memory; its levels run on the
+ * shared thread pool, which has the calling thread help with the parts.
+ *
+ * @param engine BFS engine
+ * @param graph Graph to search
+ * @param source Source vertex
+ * @param target Vertex that ends the search early, or -1
+ * @param dist Output: hop distance of every vertex
+ * @param parent Output: BFS tree parent of every vertex
+ * @param parentArc Output: out-arc from the parent (needs graph->inArc
+ *                  for vertices reached by a bottom-up level)
+ * @return Number of vertices reached, including the source
+ */
+int bfsSearch(struct BfsEngine *engine, const struct BfsGraph *graph, int source, int target,
+              int dist[], int parent[], int parentArc[]);
+
+/**
+ * @brief Build the in-arc arrays of a directed CSR graph
+ * @param n Number of vertices
+ * @param offset Out-arc offsets (n + 1 entries)
+ * @param target Head of every out-arc
+ * @param inOffset Output: in-arc offsets (n + 1 entries)
+ * @param inSource Output: tail of every in-arc (offset[n] entries)
+ * @param inArc Output: out-arc index of every in-arc (offset[n] entries)
+ */
+void buildInArcs(int n, const int offset[], const int target[],
+                 int inOffset[], int inSource[], int inArc[]);
+
+#endif // BFS_H
@@ -0,0 +1,138 @@
+/**
+ * @file checkpoint.h
+ * @brief Checkpoint and resume for long Bellman-Ford and max-flow runs
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * A checkpointed run hands its state to a background writer thread every
+ * few seconds: dist[] and parent[] after a Bellman-Ford pass, or the
+ * residual capacities after a max-flow augmenting path. The solver only
+ * pays for one memcpy(); if the previous snapshot is still being written,
+ * the new one is skipped instead of waiting. Snapshots are written to
+ * "path.tmp", flushed and renamed over path, so path always holds a
+ * complete snapshot even if the process is killed mid-write.
+ *
+ * A run started with resume set continues from the snapshot in path
+ * after checking that it was taken on the same graph (a fingerprint of
+ * its stored edges) with the same terminals.
+ *
+ * Layout (integers in the byte order of the writing machine):
+ *   64-byte struct GraphSnapshotHeader, then arrays × count int32 values:
+ *   dist and parent by slot for Bellman-Ford, residual capacities by
+ *   arc of the flow network for max flow (net flow by stored edge when
+ *   the capacity sums may overflow int, as the residuals then can).
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define GRAPH_SNAPSHOT_MAGIC "GRAPHCKP"
+#define GRAPH_SNAPSHOT_VERSION 1
+#define GRAPH_SNAPSHOT_BYTE_ORDER 0x01020304u
+
+/**
+ * @brief Solvers whose state a snapshot holds
+ */
+enum GraphSnapshotKind
+{
+    GRAPH_SNAPSHOT_BELLMAN_FORD = 1, // dist and parent after a pass
+    GRAPH_SNAPSHOT_MAX_FLOW = 2      // Residual capacities after an augmenting path
+};
+
+/**
+ * @brief Structure of the 64-byte snapshot header
+ */
+struct GraphSnapshotHeader
+{
+    char magic[8];        // GRAPH_SNAPSHOT_MAGIC, not NUL-terminated
+    uint32_t version;     // GRAPH_SNAPSHOT_VERSION
+    uint32_t byteOrder;   // GRAPH_SNAPSHOT_BYTE_ORDER as written
+    uint32_t kind;        // enum GraphSnapshotKind
+    int32_t source;       // Source vertex
+    int32_t sink;         // Sink vertex (-1 for Bellman-Ford)
+    int32_t count;        // Values per array
+    uint32_t arrays;      // Number of arrays
+    uint32_t reserved;    // Zero
+    uint64_t fingerprint; // Hash of the graph the snapshot belongs to
+    int64_t progress;     // Completed passes, or the flow value
+    uint64_t checksum;    // Hash of the arrays
+};
+
+/**
+ * @brief Structure to configure checkpoints
+ */
+struct GraphCheckpointConfig
+{
+    const char *path; // Snapshot file
+    double interval;  // Minimum seconds between snapshots (0 = whenever the writer is idle)
+    bool resume;      // Continue from the snapshot in path if there is one
+};
+
+/**
+ * @brief Structure to report the checkpoints of a run
+ */
+struct GraphCheckpointReport
+{
+    long long resumedFrom; // Progress of the snapshot the run resumed from, -1 if none
+    int written;           // Snapshots written
+    int skipped;           // Snapshots dropped while the writer was busy
+    int failed;            // Snapshots that could not be written
+};
+
+/**
+ * @brief Bellman-Ford that checkpoints dist[] and parent[] between passes
+ *
+ * Results are those of graphBellmanFord(). A failing snapshot write does
+ * not stop the run; it is only counted in the report.
+ *
+ * @param graph Graph
+ * @param workspace Workspace (NULL = temporary)
+ * @param source Source vertex
+ * @param config Snapshot file, interval and resume flag
+ * @param dist Output: n shortest distances
+ * @param parent Output: n shortest-path tree parents (may be NULL)
+ * @param report Output: checkpoint counters (may be NULL)
+ * @return As graphBellmanFord(), plus GRAPH_INVALID_ARGUMENT if the
+ *         snapshot to resume from is damaged or belongs to another query,
+ *         and GRAPH_WEIGHT_TYPE for typed graphs whose weights do not fit int
+ */
+int graphBellmanFordCheckpointed(const struct Graph *graph, struct GraphWorkspace *workspace,
+                                 int source, const struct GraphCheckpointConfig *config,
+                                 int dist[], int parent[], struct GraphCheckpointReport *report);
+
+/**
+ * @brief Edmonds-Karp max flow that checkpoints the residual capacities
+ *
+ * Results are those of graphMaxFlow(); resuming keeps the flow found so
+ * far and only searches for the remaining augmenting paths.
+ *
+ * @param graph Graph with non-negative weights
+ * @param workspace Workspace (NULL = temporary)
+ * @param source Source vertex
+ * @param sink Sink vertex
+ * @param config Snapshot file, interval and resume flag
+ * @param flow Output: maximum flow value
+ * @param edgeFlow Output: flow on every input edge (may be NULL)
+ * @param report Output: checkpoint counters (may be NULL)
+ * @return As graphMaxFlow(), plus the resume and GRAPH_WEIGHT_TYPE
+ *         failures of graphBellmanFordCheckpointed()
+ */
+int graphMaxFlowCheckpointed(const struct Graph *graph, struct GraphWorkspace *workspace,
+                             int source, int sink, const struct GraphCheckpointConfig *config,
+                             int *flow, int edgeFlow[], struct GraphCheckpointReport *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHECKPOINT_H
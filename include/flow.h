@@ -0,0 +1,386 @@
+/**
+ * @file flow.h
+ * @brief Flow networks with warm restarts, min cuts, Gomory-Hu trees,
+ *        bipartite matching and min-cost flow
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * This is the stateful side of libgraph's maximum flow: a struct
+ * FlowNetwork keeps its residual graph between solves, so capacity
+ * changes are re-optimized from the previous flow instead of from zero.
+ * One-shot callers can use graphMaxFlow() from graph.h instead. A
+ * struct CostNetwork finds the cheapest of all maximum flows.
+ */
+
+#ifndef FLOW_H
+#define FLOW_H
+
+#include <stdbool.h>
+
+#include "graph.h"
+
+/**
+ * @brief Structure to represent a flow network that keeps its residual state
+ *        between solves
+ *
+ * Arcs are stored grouped by tail vertex. Every arc u → v has a mate
+ * v → u, so pushing flow along one arc hands residual capacity back to
+ * the other. residual[a] is always capacity[a] - flow[a], where the flow
+ * is skew-symmetric (flow on v → u is minus the flow on u → v).
+ */
+struct FlowNetwork
+{
+    int n;                 // Number of vertices
+    int arcCount;          // Number of arcs (two per connected vertex pair)
+    int *firstArc;         // Arcs leaving u are firstArc[u] .. firstArc[u + 1] - 1
+    int *head;             // head[a] = vertex that arc a points to
+    int *mate;             // mate[a] = reverse arc of arc a
+    int *capacity;         // Current capacity of every arc
+    int *residual;         // Current residual capacity of every arc
+    int source;            // Source of the stored flow (-1 before the first solve)
+    int sink;              // Sink of the stored flow (-1 before the first solve)
+    int flow;              // Value of the stored flow
+    int augmentations;     // Paths pushed by the most recent solve or update
+    int *parentArc;        // BFS scratch: arc used to reach each vertex
+    int *queue;            // BFS scratch: vertex queue
+    unsigned *seen;        // BFS scratch: seen[v] == epoch once a search reaches v
+    unsigned epoch;        // Stamp of the current search
+    int *excess;           // Repair scratch: inflow minus outflow, zero between updates
+    struct BfsEngine *bfs; // Engine that finds shortest augmenting paths
+};
+
+/**
+ * @brief Structure to describe one capacity change of an existing edge
+ */
+struct CapacityChange
+{
+    int u;        // Tail of the edge
+    int v;        // Head of the edge
+    int capacity; // New capacity of the edge u → v
+};
+
+/**
+ * @brief Structure to describe one edge crossing a minimum cut
+ */
+struct CutEdge
+{
+    int u;        // Endpoint on the source side
+    int v;        // Endpoint on the sink side
+    int capacity; // Capacity of the edge u → v
+};
+
+/**
+ * @brief Structure to represent a Gomory-Hu tree of an undirected graph
+ *
+ * Vertex 0 is the root and parent[v] < v for every other vertex. The min
+ * cut between any two vertices equals the smallest weight on the tree
+ * path between them.
+ */
+struct GomoryHuTree
+{
+    int n;         // Number of vertices
+    int *parent;   // parent[v] = tree neighbour of v towards vertex 0
+    int *weight;   // weight[v] = min cut value between v and parent[v]
+    int *depth;    // depth[v] = number of tree edges between v and vertex 0
+    int flowCalls; // Max-flow runs, including discarded speculative ones
+};
+
+/**
+ * @brief Structure to describe one matched pair of a bipartite matching
+ */
+struct MatchPair
+{
+    int u; // Left vertex
+    int v; // Right vertex
+};
+
+/**
+ * @brief Create a flow network from an edge list
+ *
+ * One arc pair is created for every vertex pair joined by at least one
+ * edge; parallel edges add up their capacities. Only these pairs can be
+ * changed later by updateCapacities(). Self-loops carry no flow.
+ *
+ * @param n Number of vertices
+ * @param edgeCount Number of edges
+ * @param edges Edges with non-negative capacities in their weight field
+ * @param directed false to give every edge its capacity in both directions
+ * @param edgeArc Output: arc u → v of every edge, -1 for self-loops (may be NULL)
+ * @return Pointer to the created network with zero flow, or NULL if
+ *         memory ran out
+ */
+struct FlowNetwork *createFlowNetworkFromEdges(int n, int edgeCount, const struct GraphEdge edges[],
+                                               bool directed, int edgeArc[]);
+
+/**
+ * @brief Create a flow network from a capacity matrix
+ *
+ * An arc pair is created for every vertex pair that has a non-zero
+ * capacity in at least one direction; every vertex's arcs are sorted by
+ * head.
+ *
+ * @param n Number of vertices
+ * @param graph Capacity matrix, graph[u][v] = capacity of edge u → v
+ * @return Pointer to the created network with zero flow, or NULL if
+ *         memory ran out
+ */
+struct FlowNetwork *createFlowNetwork(int n, int graph[n][n]);
+
+/**
+ * @brief Free a flow network and all of its arrays
+ * @param net Network to free (may be NULL)
+ */
+void freeFlowNetwork(struct FlowNetwork *net);
+
+/**
+ * @brief Find the arc u → v of a flow network
+ * @param net Flow network
+ * @param u Tail vertex
+ * @param v Head vertex
+ * @return Arc index, or -1 if the pair has no arcs
+ */
+int findArc(const struct FlowNetwork *net, int u, int v);
+
+/**
+ * @brief Compute a maximum flow, warm-starting from the stored flow
+ *
+ * The first call, or a call with a different source or sink, starts
+ * from zero flow. Later calls continue from the stored residual graph.
+ *
+ * @param net Flow network
+ * @param s Source vertex
+ * @param t Sink vertex
+ * @return Maximum flow value from s to t
+ */
+int solveMaxFlow(struct FlowNetwork *net, int s, int t);
+
+/**
+ * @brief Apply a batch of capacity changes and re-optimize the stored flow
+ *
+ * Capacity increases only enlarge residual arcs. A decrease below the
+ * current flow of an arc cuts that flow back, leaving an excess at the
+ * tail and a deficit at the head. Excess is pushed forward to a deficit
+ * or a terminal (or back to the source), remaining deficits are refilled
+ * from a terminal, and then augmentation resumes.
+ *
+ * The repair only visits the endpoints of the changed edges and what
+ * its searches reach from them: each search is a BFS that stops at the
+ * first goal, and costs O(vertices + arcs it visits). Resuming the
+ * augmentation is not local: proving the flow maximum takes at least one
+ * residual BFS from the source, O(V + E), plus one per augmenting path
+ * the changes opened.
+ *
+ * @param net Flow network solved earlier with solveMaxFlow()
+ * @param changes Array of capacity changes
+ * @param count Number of changes
+ * @return false if a change names an unknown edge or a negative capacity
+ *         (nothing is applied in that case), true otherwise
+ */
+bool updateCapacities(struct FlowNetwork *net, const struct CapacityChange changes[], int count);
+
+/**
+ * @brief Extract a minimum s-t cut from a solved flow network
+ *
+ * The source side is every vertex still reachable from the source in
+ * the final residual graph. The cut edges are the saturated edges that
+ * leave it; their capacities add up to the maximum flow.
+ *
+ * @param net Flow network solved with solveMaxFlow()
+ * @param sourceSide Output array of n flags, true for source-side vertices
+ * @param cutEdges Output array for the cut edges (may be NULL); arcCount
+ *                 entries are always enough
+ * @return Number of cut edges
+ */
+int minCut(struct FlowNetwork *net, bool sourceSide[], struct CutEdge cutEdges[]);
+
+/**
+ * @brief Build a Gomory-Hu tree with Gusfield's algorithm
+ *
+ * Gusfield's algorithm needs only n - 1 max-flow runs and no graph
+ * contraction. Vertex s is cut from parent[s]; every later vertex on
+ * the s side that shared that parent is then re-attached to s. The runs
+ * for a window of consecutive vertices run as tasks of the shared thread
+ * pool, one per vertex, and are committed in order. A run whose parent was
+ * changed by an earlier commit in the same window is discarded and
+ * repeated in the next window, so the result always matches the
+ * sequential algorithm.
+ *
+ * @param n Number of vertices
+ * @param graph Symmetric capacity matrix of an undirected graph
+ * @param threads Max-flow runs per window (0 = threads of the shared pool)
+ * @return Pointer to the tree (with no vertices for n = 0), or NULL if the
+ *         matrix is not symmetric or memory ran out
+ */
+struct GomoryHuTree *buildGomoryHuTree(int n, int graph[n][n], int threads);
+
+/**
+ * @brief Query the min cut value between two vertices of a Gomory-Hu tree
+ * @param tree Tree built by buildGomoryHuTree()
+ * @param u First vertex
+ * @param v Second vertex
+ * @return Min cut value between u and v (GRAPH_INF if u == v)
+ */
+int gomoryHuMinCut(const struct GomoryHuTree *tree, int u, int v);
+
+/**
+ * @brief Free a Gomory-Hu tree
+ * @param tree Tree to free (may be NULL)
+ */
+void freeGomoryHuTree(struct GomoryHuTree *tree);
+
+/**
+ * @brief Hopcroft-Karp maximum bipartite matching
+ *
+ * Each phase runs one BFS from all free left vertices to layer the graph
+ * by shortest alternating path length, then a DFS that augments along a
+ * maximal set of vertex-disjoint shortest augmenting paths. O(√V) phases
+ * suffice, so the total time is O(E√V).
+ *
+ * @param nLeft Number of left vertices
+ * @param nRight Number of right vertices
+ * @param firstEdge Neighbours of left vertex u are adj[firstEdge[u] .. firstEdge[u + 1] - 1]
+ * @param adj Right-vertex neighbours of all left vertices
+ * @param matchLeft Output: right partner of every left vertex, -1 if free
+ * @param matchRight Output: left partner of every right vertex, -1 if free
+ * @return Size of the maximum matching, or -1 if memory ran out
+ */
+int hopcroftKarp(int nLeft, int nRight, const int firstEdge[], const int adj[],
+                 int matchLeft[], int matchRight[]);
+
+/**
+ * @brief Check whether a flow network is a unit-capacity bipartite network
+ *
+ * Such a network has only capacities 0 and 1, edges s → L, L → R and
+ * R → t for disjoint vertex sets L and R, and no other edges. Its
+ * maximum flow equals the maximum matching between the L vertices that
+ * have an edge from s and the R vertices that have an edge to t.
+ *
+ * @param n Number of vertices
+ * @param graph Capacity matrix
+ * @param s Source vertex
+ * @param t Sink vertex
+ * @param side Output: 1 for L, 2 for R, 0 for vertices without edges
+ * @return true if the network has the bipartite matching shape
+ */
+bool isUnitBipartiteNetwork(int n, int graph[n][n], int s, int t, char side[]);
+
+/**
+ * @brief Compute a maximum flow, using Hopcroft-Karp for matching networks
+ *
+ * Unit-capacity bipartite networks go to hopcroftKarp(), which also
+ * reports the matched pairs. All other networks are solved with
+ * Edmonds-Karp on a struct FlowNetwork. graphMaxFlow() takes the same
+ * fast path for directed graphs of that shape.
+ *
+ * @param n Number of vertices
+ * @param graph Capacity matrix
+ * @param s Source vertex
+ * @param t Sink vertex
+ * @param pairs Output for the matched pairs (n / 2 entries are enough)
+ * @param pairCount Output: number of pairs, or -1 if the network is not
+ *                  a matching network
+ * @return Maximum flow value from s to t, or -1 if memory ran out
+ */
+int maxFlowAuto(int n, int graph[n][n], int s, int t, struct MatchPair pairs[], int *pairCount);
+
+/**
+ * @brief Structure to represent a flow network with edge costs
+ *
+ * Every edge u → v is stored as arc 2k with a reverse arc 2k + 1, so the
+ * mate of arc a is a ^ 1. Reverse arcs start with zero capacity and the
+ * negated cost.
+ */
+struct CostNetwork
+{
+    int V;          // Number of vertices
+    int E;          // Number of edges added so far
+    int maxEdges;   // Number of edges the arrays can hold
+    int *firstOut;  // firstOut[u] = first arc leaving u, -1 if none
+    int *nextOut;   // nextOut[a] = next arc with the same tail, -1 at the end
+    int *head;      // head[a] = vertex arc a points to
+    int *capacity;  // Original capacity of every arc
+    int *residual;  // Residual capacity of every arc
+    int *cost;      // Cost per unit of flow on every arc
+};
+
+/**
+ * @brief Structure to hold the result of a min-cost flow computation
+ */
+struct CostFlowResult
+{
+    int flow;          // Maximum flow value
+    long long cost;    // Total cost of the flow
+    int augmentations; // Number of shortest paths augmented
+};
+
+/**
+ * @brief Create an empty cost network
+ * @param V Number of vertices
+ * @param E Maximum number of edges
+ * @return Pointer to the created network, or NULL if memory ran out or
+ *         a size is negative
+ */
+struct CostNetwork *createCostNetwork(int V, int E);
+
+/**
+ * @brief Free a cost network
+ * @param net Network to free (may be NULL)
+ */
+void freeCostNetwork(struct CostNetwork *net);
+
+/**
+ * @brief Add a directed edge with a capacity and a cost per unit of flow
+ * @param net Cost network
+ * @param u Tail vertex
+ * @param v Head vertex
+ * @param capacity Non-negative capacity of the edge
+ * @param cost Cost per unit of flow (may be negative)
+ * @return Index of the new edge, or -1 if the network is full or an
+ *         argument is out of range
+ */
+int addCostEdge(struct CostNetwork *net, int u, int v, int capacity, int cost);
+
+/**
+ * @brief Get the flow currently sent along an edge
+ * @param net Cost network
+ * @param edge Edge index returned by addCostEdge()
+ * @return Flow on the edge
+ */
+int costEdgeFlow(const struct CostNetwork *net, int edge);
+
+/**
+ * @brief Compute a min-cost maximum flow with successive shortest paths
+ *
+ * After Bellman-Ford initializes the potentials, each iteration runs
+ * Dijkstra on reduced costs from s, adds the distances to the potentials
+ * (which keeps every residual reduced cost non-negative) and pushes the
+ * bottleneck capacity along the cheapest s-t path.
+ *
+ * @param net Cost network (its current flow is discarded)
+ * @param s Source vertex
+ * @param t Sink vertex
+ * @param result Output: flow value, total cost and augmentation count
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NEGATIVE_CYCLE if the
+ *         network has a negative-cost cycle, or GRAPH_NO_MEMORY
+ */
+int minCostMaxFlow(struct CostNetwork *net, int s, int t, struct CostFlowResult *result);
+
+/**
+ * @brief Compute a min-cost maximum flow with capacity scaling
+ *
+ * The maximum flow value F is found first and becomes a supply of F at
+ * s and a demand of F at t. Each Δ-phase saturates arcs with residual of
+ * at least Δ and negative reduced cost, then moves Δ units at a time
+ * along cheapest paths of the Δ-residual graph from a vertex with excess
+ * of at least Δ to a vertex with deficit of at least Δ. Halving Δ down
+ * to 1 leaves every excess at zero with optimal cost.
+ *
+ * @param net Cost network (its current flow is discarded)
+ * @param s Source vertex
+ * @param t Sink vertex
+ * @param result Output: flow value, total cost and augmentation count
+ * @return As minCostMaxFlow()
+ */
+int minCostMaxFlowScaling(struct CostNetwork *net, int s, int t, struct CostFlowResult *result);
+
+#endif // FLOW_H
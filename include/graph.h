@@ -0,0 +1,908 @@
+/**
+ * @file graph.h
+ * @brief Public C API of libgraph: graph construction, reordering, shortest
+ *        paths, spanning trees and maximum flow
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * The library never prints and never terminates the process. Every
+ * function returns a GraphStatus code and writes its results into
+ * arrays supplied by the caller; the caller owns those arrays and sizes
+ * them as documented. A struct Graph is immutable once created, so any
+ * number of threads may run queries on the same graph at once.
+ *
+ * Every query also has a ...Ws() variant that takes a struct
+ * GraphWorkspace. A workspace holds the query's scratch arrays and is
+ * reused by the next query, so a caller that keeps one workspace per
+ * thread does no allocation once the workspace has seen its largest
+ * query. The plain functions create a temporary workspace per call.
+ *
+ * graphReorder() renumbers the vertices of a copy for cache locality.
+ * Every function still takes and returns the caller's vertex IDs and
+ * edge indices on the reordered copy; only the speed changes.
+ *
+ * graphCompress() makes a copy that keeps only delta-encoded adjacency
+ * lists (or a bit matrix), for graphs that do not fit in memory as CSR.
+ * Dijkstra, Prim and BFS decode it on the fly; the algorithms that work
+ * on the edge list return GRAPH_NEEDS_EDGE_LIST for it.
+ *
+ * graphCreateTyped() takes int64, float or double weights. The weighted
+ * int queries return GRAPH_WEIGHT_TYPE for a graph whose weights do not
+ * fit int; the ...Typed() queries answer it in its own type. Queries
+ * whose distance or flow value does not fit int return GRAPH_OVERFLOW;
+ * create the graph with GRAPH_WEIGHT_INT64 weights to get 64-bit sums.
+ *
+ * Link with -lgraph (static: libgraph.a, shared: libgraph.so) and
+ * -pthread.
+ */
+
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <limits.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define GRAPH_API_VERSION 1 // Raised whenever a declaration below changes incompatibly
+#define GRAPH_INF INT_MAX   // Distance of unreachable vertices
+
+/**
+ * @brief Result codes of the library functions
+ */
+enum GraphStatus
+{
+    GRAPH_OK,
+    GRAPH_NO_MEMORY,          // An internal allocation failed; outputs are undefined
+    GRAPH_INVALID_ARGUMENT,   // Vertex out of range, negative count or NULL pointer
+    GRAPH_NEGATIVE_WEIGHT,    // Dijkstra or max flow on a graph with negative weights
+    GRAPH_NEGATIVE_CYCLE,     // Bellman-Ford reached a negative cycle
+    GRAPH_NOT_CONNECTED,      // Spanning tree covers only part of the graph (outputs still valid)
+    GRAPH_NEEDS_UNDIRECTED,   // Spanning trees are only defined on undirected graphs
+    GRAPH_IO_ERROR,           // Writing results to a file descriptor failed
+    GRAPH_NEEDS_EDGE_LIST,    // Algorithm needs the edge list, which a compressed graph drops
+    GRAPH_WEIGHT_TYPE,        // Weights do not fit int: use the ...Typed() functions
+    GRAPH_OVERFLOW            // A distance or flow does not fit int: use int64 weights
+};
+
+/**
+ * @brief Weight types for graphCreateTyped()
+ *
+ * Each type has its own infinity (the distance of unreachable vertices):
+ * INT_MAX, LLONG_MAX, or IEEE infinity for float and double.
+ */
+enum GraphWeightType
+{
+    GRAPH_WEIGHT_INT32,  // int
+    GRAPH_WEIGHT_INT64,  // long long
+    GRAPH_WEIGHT_FLOAT,  // float
+    GRAPH_WEIGHT_DOUBLE  // double
+};
+
+/**
+ * @brief Vertex orders for graphReorder()
+ */
+enum GraphOrder
+{
+    GRAPH_ORDER_DEGREE, // Highest degree first, so the most used rows share cache lines
+    GRAPH_ORDER_RCM,    // Reverse Cuthill-McKee: BFS order, arcs span few slots
+    GRAPH_ORDER_GORDER  // Gorder: vertices with shared neighbours are placed together
+};
+
+/**
+ * @brief Encodings for graphCompress()
+ *
+ * Adjacency lists store every vertex's heads sorted, as varint gaps
+ * (one byte per arc when neighbours have nearby IDs, e.g. after
+ * graphReorder() with GRAPH_ORDER_RCM), each followed by a fixed-width
+ * weight. A w-bit weight stores (weight - smallest weight) / step with
+ * the smallest step that fits, so narrow widths round weights to the
+ * nearest multiple of the step (see graphWeightStep()).
+ */
+enum GraphCompression
+{
+    GRAPH_COMPRESS_EXACT,    // Lossless: 0, 8, 16 or 32-bit weights, or a bit matrix if smaller
+    GRAPH_COMPRESS_WEIGHT16, // Lists with 16-bit weights
+    GRAPH_COMPRESS_WEIGHT8,  // Lists with 8-bit weights
+    GRAPH_COMPRESS_MATRIX    // n × n bit matrix; needs equal weights, merges parallel edges
+};
+
+/**
+ * @brief Structure to describe one weighted edge u → v (u - v if undirected)
+ *
+ * Maximum flow uses the weight as the capacity of the edge.
+ */
+struct GraphEdge
+{
+    int u;      // First endpoint (tail if directed)
+    int v;      // Second endpoint (head if directed)
+    int weight; // Weight or capacity of the edge
+};
+
+/**
+ * @brief Opaque graph handle
+ */
+struct Graph;
+
+/**
+ * @brief Eviction policies for graphPathCacheCreate()
+ */
+enum GraphCachePolicy
+{
+    GRAPH_CACHE_LRU, // Evict the tree used least recently
+    GRAPH_CACHE_LFU  // Evict the tree used least often, aged so stale trees still leave
+};
+
+/**
+ * @brief Structure to report the state of a shortest-path-tree cache
+ */
+struct GraphPathCacheInfo
+{
+    long long budget;    // Byte budget given at creation
+    long long bytes;     // Bytes held by the cached trees
+    int entries;         // Number of cached trees
+    long long hits;      // Queries answered from the cache
+    long long misses;    // Queries that ran Dijkstra
+    long long evictions; // Trees evicted to stay within the budget
+};
+
+/**
+ * @brief Opaque shortest-path-tree cache handle (see graphPathCacheCreate())
+ */
+struct GraphPathCache;
+
+/**
+ * @brief Opaque workspace handle: scratch memory reused across queries
+ *
+ * A workspace must not be used by two queries at the same time; give
+ * every thread its own. It also keeps the BFS engine, the in-arcs of
+ * the last directed graph searched and the flow network (with its last
+ * flow) of the last graph passed to graphMaxFlowWs(), so queries that
+ * keep hitting the same graph skip that setup as well.
+ */
+struct GraphWorkspace;
+
+/**
+ * @brief Report the API version the library was built with
+ * @return GRAPH_API_VERSION of the library binary
+ */
+int graphApiVersion(void);
+
+/**
+ * @brief Create a graph from an edge list
+ *
+ * Parallel edges and self-loops are allowed. The edge array is copied,
+ * so the caller may free it afterwards.
+ *
+ * @param n Number of vertices
+ * @param edgeCount Number of edges
+ * @param edges Edge list
+ * @param directed true for a directed graph
+ * @param graph Output: the created graph
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int graphCreate(int n, int edgeCount, const struct GraphEdge edges[], bool directed,
+                struct Graph **graph);
+
+/**
+ * @brief Create a graph whose weights have one of the types of enum GraphWeightType
+ *
+ * The weight of edges[i] is weights[i] of the given type; edges[i].weight
+ * is ignored. If every weight is integral and all path sums fit int, the
+ * graph stores them as int and runs on the int32 kernels, so the int API
+ * answers it too and it can be reordered and compressed. Otherwise only
+ * the ...Typed() queries accept it, with kernels specialised for the
+ * type, and graphReorder() and graphCompress() return GRAPH_WEIGHT_TYPE.
+ *
+ * @param n Number of vertices
+ * @param edgeCount Number of edges
+ * @param edges Edge list (endpoints only)
+ * @param weightType One of enum GraphWeightType
+ * @param weights edgeCount weights of that type
+ * @param directed true for a directed graph
+ * @param graph Output: the created graph
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT (also for NaN weights) or GRAPH_NO_MEMORY
+ */
+int graphCreateTyped(int n, int edgeCount, const struct GraphEdge edges[], int weightType,
+                     const void *weights, bool directed, struct Graph **graph);
+
+/**
+ * @brief Report the weight type of a graph
+ * @param graph Graph
+ * @return enum GraphWeightType the graph was created with (GRAPH_WEIGHT_INT32
+ *         unless it came from graphCreateTyped())
+ */
+int graphWeightType(const struct Graph *graph);
+
+/**
+ * @brief Report whether a graph runs on the int32 kernels
+ * @param graph Graph
+ * @return true if the int API accepts the graph
+ */
+bool graphHasIntWeights(const struct Graph *graph);
+
+/**
+ * @brief Create a graph from a weight matrix
+ *
+ * matrix[u * n + v] is the weight of edge u → v and 0 means no edge.
+ * An undirected graph reads only the entries with u < v.
+ *
+ * @param n Number of vertices
+ * @param matrix Row-major n × n weight matrix
+ * @param directed true for a directed graph
+ * @param graph Output: the created graph
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int graphFromMatrix(int n, const int matrix[], bool directed, struct Graph **graph);
+
+/**
+ * @brief Create a graph from a binary graph file (see graph_file.h)
+ *
+ * Arcs without a weight section get weight 1.
+ *
+ * @param path Graph file path
+ * @param graph Output: the created graph
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT if the file cannot be used,
+ *         or GRAPH_NO_MEMORY
+ */
+int graphLoad(const char *path, struct Graph **graph);
+
+/**
+ * @brief Create a copy of a graph with its vertices stored in a cache-friendly order
+ *
+ * The copy stores vertex v in slot position[v] (see graphVertexPositions())
+ * and its edges sorted by slot, so traversals touch nearby memory. All
+ * query functions on the copy still take and return the original vertex
+ * IDs and edge indices, so results are identical up to ties. Reordering
+ * costs about as much as a few traversals and pays off when the graph is
+ * queried repeatedly. GRAPH_ORDER_DEGREE suits skewed (power-law) graphs,
+ * GRAPH_ORDER_RCM meshes and road networks, GRAPH_ORDER_GORDER both at a
+ * higher preprocessing cost. Directed graphs are ordered by their
+ * underlying undirected graph.
+ *
+ * @param graph Graph to reorder (may itself be reordered)
+ * @param order One of enum GraphOrder
+ * @param reordered Output: the reordered copy, freed with graphFree()
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NEEDS_EDGE_LIST,
+ *         GRAPH_WEIGHT_TYPE (weights that do not fit int) or GRAPH_NO_MEMORY
+ */
+int graphReorder(const struct Graph *graph, int order, struct Graph **reordered);
+
+/**
+ * @brief Create a compressed copy of a graph that keeps only its adjacency
+ *
+ * The copy answers graphDijkstra(), graphPrim() and graphBfs() (and
+ * their ...Ws() variants) for the same vertex IDs, decoding arcs as it
+ * scans them; a reordered graph keeps its vertex order. Bellman-Ford,
+ * Kruskal, max flow and graphReorder() need the edge list and return
+ * GRAPH_NEEDS_EDGE_LIST. BFS on a compressed directed graph has no
+ * in-arcs and expands every level top-down. The narrow weight codes round
+ * every weight to the nearest multiple of graphWeightStep() above the
+ * smallest weight (down where that would pass INT_MAX), and overflow
+ * checks use the rounded weights.
+ *
+ * @param graph Graph to compress (not itself compressed)
+ * @param compression One of enum GraphCompression
+ * @param compressed Output: the compressed copy, freed with graphFree()
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT (including GRAPH_COMPRESS_MATRIX
+ *         on unequal weights), GRAPH_NEEDS_EDGE_LIST, GRAPH_WEIGHT_TYPE (as
+ *         for graphReorder()) or GRAPH_NO_MEMORY
+ */
+int graphCompress(const struct Graph *graph, int compression, struct Graph **compressed);
+
+/**
+ * @brief Report the weight resolution of a graph
+ * @param graph Graph
+ * @return 1 if weights are stored exactly, otherwise the step of a
+ *         narrow compressed weight
+ */
+int graphWeightStep(const struct Graph *graph);
+
+/**
+ * @brief Report the memory a graph holds
+ * @param graph Graph
+ * @return Bytes of all arrays the graph owns
+ */
+long long graphMemoryUsage(const struct Graph *graph);
+
+/**
+ * @brief Report where every vertex is stored
+ * @param graph Graph
+ * @param position Output: n storage slots (position[v] = v unless reordered)
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+int graphVertexPositions(const struct Graph *graph, int position[]);
+
+/**
+ * @brief Free a graph
+ * @param graph Graph to free (may be NULL)
+ */
+void graphFree(struct Graph *graph);
+
+/**
+ * @brief Create an empty workspace
+ *
+ * It grows to the size of the largest query it serves and then stays
+ * at that size.
+ *
+ * @param workspace Output: the created workspace
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int graphWorkspaceCreate(struct GraphWorkspace **workspace);
+
+/**
+ * @brief Free a workspace and everything it caches
+ * @param workspace Workspace to free (may be NULL)
+ */
+void graphWorkspaceFree(struct GraphWorkspace *workspace);
+
+/**
+ * @brief Count the system allocations a workspace has made
+ *
+ * Stays constant once the workspace is warm; useful to check that a
+ * query path is allocation-free.
+ *
+ * @param workspace Workspace
+ * @return Number of malloc() calls made so far, including the ones
+ *         inside cached engines and networks
+ */
+long long graphWorkspaceAllocations(const struct GraphWorkspace *workspace);
+
+/**
+ * @brief Phases of a query timed by the statistics
+ */
+enum GraphPhase
+{
+    GRAPH_PHASE_SETUP,  // Scratch arrays, initial labels, cached in-arcs or flow network
+    GRAPH_PHASE_SORT,   // Kruskal's edge sort
+    GRAPH_PHASE_SEARCH, // Main loop: relaxations, tree growth, BFS levels, augmenting paths
+    GRAPH_PHASE_EXPORT, // Results copied to the caller's arrays
+    GRAPH_PHASE_COUNT
+};
+
+/**
+ * @brief Structure to hold the counters and phase times of the queries
+ *        run on one workspace
+ *
+ * Filled in only if libgraph was built with -DGRAPH_STATS (make stats);
+ * otherwise the instrumentation is compiled out and every field stays 0.
+ */
+struct GraphStats
+{
+    long long queries;         // Queries started on the workspace
+    long long relaxations;     // Distance or key labels lowered
+    long long heapPushes;      // Vertices inserted into a heap
+    long long heapDecreases;   // Keys lowered in place in a heap
+    long long heapPops;        // Vertices removed from a heap
+    long long edgesScanned;    // Arcs or edges examined
+    long long augmentingPaths; // Augmenting paths pushed by max flow
+    long long unionCalls;      // Union-find sets merged
+    long long findCalls;       // Union-find representative lookups
+    long long passes;          // Bellman-Ford passes, BFS levels
+    double phaseMs[GRAPH_PHASE_COUNT]; // Wall time per enum GraphPhase in milliseconds
+};
+
+/**
+ * @brief Report whether libgraph was built with statistics
+ * @return true if the ...Ws() queries fill in struct GraphStats
+ */
+bool graphStatsEnabled(void);
+
+/**
+ * @brief Read the statistics a workspace has gathered since it was
+ *        created or last reset
+ *
+ * The plain functions use a temporary workspace, so only the ...Ws()
+ * variants are counted.
+ *
+ * @param workspace Workspace
+ * @param stats Output: accumulated statistics
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+int graphWorkspaceStats(const struct GraphWorkspace *workspace, struct GraphStats *stats);
+
+/**
+ * @brief Zero the statistics of a workspace
+ * @param workspace Workspace
+ */
+void graphWorkspaceResetStats(struct GraphWorkspace *workspace);
+
+/**
+ * @brief Format statistics as a one-line JSON object
+ * @param stats Statistics
+ * @param buffer Output: NUL-terminated JSON (may be NULL if size is 0)
+ * @param size Size of buffer in bytes
+ * @return Length of the full JSON text, as for snprintf(); the text was
+ *         truncated if this is >= size
+ */
+int graphStatsJson(const struct GraphStats *stats, char buffer[], int size);
+
+/**
+ * @brief Trace levels, from a summary per query to one record per step
+ */
+enum GraphTraceLevel
+{
+    GRAPH_TRACE_OFF,
+    GRAPH_TRACE_INFO,   // One record per query: result and size of the work
+    GRAPH_TRACE_DEBUG,  // One record per pass, BFS level or augmenting path
+    GRAPH_TRACE_VERBOSE // One record per settled vertex or considered edge
+};
+
+/**
+ * @brief Receiver of trace output: called with whole JSON-lines records
+ * @param context Pointer given to graphTraceSet()
+ * @param data Records, each ending in a newline (not NUL-terminated)
+ * @param length Number of bytes in data
+ */
+typedef void (*GraphTraceSink)(void *context, const char *data, int length);
+
+/**
+ * @brief Report the most detailed trace level compiled into libgraph
+ *
+ * Levels above it cost nothing because their trace points are not in the
+ * binary. The default build has GRAPH_TRACE_OFF; make trace builds all
+ * levels (-DGRAPH_TRACE=3).
+ *
+ * @return enum GraphTraceLevel
+ */
+int graphTraceMaxLevel(void);
+
+/**
+ * @brief Start or stop tracing for the whole process
+ *
+ * Records are JSON objects, one per line, with the time since tracing
+ * started, the level, the algorithm and the event. They collect in an
+ * internal buffer that is handed to the sink when it is full and by
+ * graphTraceFlush(), so the sink sees a few large writes. Output still
+ * buffered for the previous sink is flushed to it first.
+ *
+ * @param level enum GraphTraceLevel; capped at graphTraceMaxLevel()
+ * @param sink Receiver of the records (NULL stops tracing)
+ * @param context Passed to every sink call
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+int graphTraceSet(int level, GraphTraceSink sink, void *context);
+
+/**
+ * @brief Hand all buffered trace records to the sink
+ */
+void graphTraceFlush(void);
+
+/**
+ * @brief Structure to describe the thread pool of the parallel queries
+ */
+struct GraphThreadPoolInfo
+{
+    int threads;  // Threads running tasks, the calling thread included
+    int nodes;    // NUMA nodes the workers are spread over
+    bool pinned;  // true if every worker is bound to one CPU
+    bool running; // false until the first parallel query starts the pool
+};
+
+/**
+ * @brief Size the thread pool shared by all parallel queries
+ *
+ * Parallel BFS levels and Gomory-Hu trees split their work into tasks
+ * that run on one process-wide pool of worker threads; idle workers
+ * steal tasks from busy ones. The pool starts with the first parallel
+ * query. With pin, workers are bound to the CPUs the process may use,
+ * spread over NUMA nodes in turn. A running pool is stopped and the new
+ * one starts with the next parallel query, so no parallel query may be
+ * running during the call.
+ *
+ * @param threads Threads running tasks (0 = number of online CPUs; 1 runs
+ *                every task on the calling thread)
+ * @param pin true to bind workers to CPUs
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+int graphThreadPoolConfigure(int threads, bool pin);
+
+/**
+ * @brief Describe the thread pool (the configured one if not started yet)
+ * @param info Output: pool description
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+int graphThreadPoolInfo(struct GraphThreadPoolInfo *info);
+
+/**
+ * @brief Stop the pool's worker threads (restarted by the next parallel query)
+ */
+void graphThreadPoolShutdown(void);
+
+/**
+ * @brief Page sizes for large arrays (see graphMemoryConfigure())
+ */
+enum GraphPagePolicy
+{
+    GRAPH_PAGES_NORMAL,      // Base pages from malloc() or mmap()
+    GRAPH_PAGES_TRANSPARENT, // 2 MB aligned mapping advised with MADV_HUGEPAGE
+    GRAPH_PAGES_EXPLICIT     // MAP_HUGETLB pages from the reserved huge page pool
+};
+
+/**
+ * @brief NUMA placement of large arrays (see graphMemoryConfigure())
+ */
+enum GraphNumaPolicy
+{
+    GRAPH_NUMA_LOCAL,      // Kernel default: pages land where they are first written
+    GRAPH_NUMA_INTERLEAVE, // Pages spread round-robin over all nodes (mbind)
+    GRAPH_NUMA_FIRST_TOUCH // Pages first written in parallel by the pinned workers of the pool
+};
+
+/**
+ * @brief Structure to configure the allocation of large arrays
+ */
+struct GraphMemoryConfig
+{
+    int pages;        // enum GraphPagePolicy
+    int numa;         // enum GraphNumaPolicy
+    size_t threshold; // Arrays below this many bytes always come from malloc()
+};
+
+/**
+ * @brief Structure to report which allocation policies took effect
+ */
+struct GraphMemoryInfo
+{
+    int pages;                  // enum GraphPagePolicy of the last large array
+    int numa;                   // enum GraphNumaPolicy of the last large array
+    int nodes;                  // NUMA nodes found in sysfs
+    bool transparentAvailable;  // Transparent huge pages are not disabled
+    long long normalBytes;      // Bytes held in base pages
+    long long transparentBytes; // Bytes held in mappings advised for huge pages
+    long long explicitBytes;    // Bytes held in MAP_HUGETLB pages
+    long long fallbacks;        // Large arrays that got a weaker policy than configured
+};
+
+/**
+ * @brief Choose page size and NUMA placement of the library's large arrays
+ *
+ * Applies to the CSR and edge arrays of new graphs, workspace arenas,
+ * flow network residual arrays and graphAllocLarge(). A policy that is
+ * unavailable falls back step by step (explicit → transparent → normal
+ * pages; first touch → interleave unless the thread pool's workers are
+ * pinned over several nodes; interleave → local on a single node or when
+ * mbind() is refused) and the fallback is counted. The default is
+ * normal pages, local placement and a 2 MB threshold. No large array
+ * may be allocated during the call.
+ *
+ * @param config New configuration
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+int graphMemoryConfigure(const struct GraphMemoryConfig *config);
+
+/**
+ * @brief Report the policies in effect and the bytes held under each
+ * @param info Output: allocation report
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+int graphMemoryInfo(struct GraphMemoryInfo *info);
+
+/**
+ * @brief Allocate an array under the configured page and NUMA policy
+ *
+ * The array is 64-byte aligned; its contents are undefined. Callers can
+ * use it for result arrays such as dist[] and parent[] of huge graphs.
+ *
+ * @param bytes Size in bytes
+ * @return Array to release with graphFreeLarge(), or NULL if memory ran out
+ */
+void *graphAllocLarge(size_t bytes);
+
+/**
+ * @brief Release an array from graphAllocLarge()
+ * @param array Array (may be NULL)
+ */
+void graphFreeLarge(void *array);
+
+/**
+ * @brief Query the size and kind of a graph
+ * @param graph Graph
+ * @return Number of vertices, number of edges, or whether the graph is directed
+ */
+int graphVertexCount(const struct Graph *graph);
+int graphEdgeCount(const struct Graph *graph);
+bool graphIsDirected(const struct Graph *graph);
+
+/**
+ * @brief Single-source shortest paths with Dijkstra's algorithm (binary heap)
+ *
+ * Unreachable vertices get dist GRAPH_INF and parent -1; the source gets
+ * dist 0 and parent -1. If the distance of a reachable vertex does not
+ * fit int, it is clamped to ±GRAPH_INF and the query returns
+ * GRAPH_OVERFLOW.
+ *
+ * @param graph Graph with non-negative weights
+ * @param workspace Workspace for the ...Ws() variant (NULL = temporary)
+ * @param source Source vertex
+ * @param dist Output: n shortest distances
+ * @param parent Output: n shortest-path tree parents (may be NULL)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NEGATIVE_WEIGHT, GRAPH_OVERFLOW
+ *         or GRAPH_NO_MEMORY
+ */
+int graphDijkstra(const struct Graph *graph, int source, int dist[], int parent[]);
+int graphDijkstraWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                    int dist[], int parent[]);
+
+/**
+ * @brief Create a cache of completed shortest-path trees
+ *
+ * Trees are keyed by graph version and source. Every graph gets a new
+ * version when it is created (reordered and compressed copies included)
+ * and versions are never reused, so a tree is never returned for any
+ * graph but the one it was computed on; trees of freed or replaced
+ * graphs simply stop being hit and are evicted. Each tree is stored in
+ * the narrowest of 1, 2 or 4 bytes per distance and per parent. One
+ * cache may be shared by any number of threads.
+ *
+ * @param budget Bytes the cached trees may hold (trees larger than this
+ *               are answered but not kept)
+ * @param policy One of enum GraphCachePolicy
+ * @param cache Output: the created cache
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int graphPathCacheCreate(long long budget, int policy, struct GraphPathCache **cache);
+
+/**
+ * @brief Drop the cached trees of one graph version, or of all graphs
+ * @param cache Cache
+ * @param graph Graph whose trees to drop (NULL = every tree)
+ */
+void graphPathCacheDrop(struct GraphPathCache *cache, const struct Graph *graph);
+
+/**
+ * @brief Report the size and hit counts of a cache
+ * @param cache Cache
+ * @param info Output: current state
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+int graphPathCacheInfo(struct GraphPathCache *cache, struct GraphPathCacheInfo *info);
+
+/**
+ * @brief Free a cache and every tree in it
+ * @param cache Cache to free (may be NULL)
+ */
+void graphPathCacheFree(struct GraphPathCache *cache);
+
+/**
+ * @brief graphDijkstra() through a shortest-path-tree cache
+ *
+ * A hit copies the cached tree into dist and parent without searching;
+ * a miss runs graphDijkstraWs() and caches the tree.
+ *
+ * @param graph Graph with non-negative weights
+ * @param workspace Workspace for a miss (NULL = temporary)
+ * @param cache Cache
+ * @param source Source vertex
+ * @param dist Output: n shortest distances
+ * @param parent Output: n shortest-path tree parents (may be NULL)
+ * @return As graphDijkstra()
+ */
+int graphDijkstraCached(const struct Graph *graph, struct GraphWorkspace *workspace,
+                        struct GraphPathCache *cache, int source, int dist[], int parent[]);
+
+/**
+ * @brief Shortest path between two vertices through a shortest-path-tree cache
+ *
+ * A hit walks the cached parents from target back to source, so it
+ * costs O(path length) and touches no other vertex.
+ *
+ * @param graph Graph with non-negative weights
+ * @param workspace Workspace for a miss (NULL = temporary)
+ * @param cache Cache
+ * @param source Source vertex
+ * @param target Target vertex
+ * @param path Output: up to n vertices from source to target
+ * @param length Output: number of vertices in path (0 if unreachable)
+ * @param distance Output: length of the path (GRAPH_INF if unreachable, may be NULL)
+ * @return As graphDijkstra()
+ */
+int graphShortestPathCached(const struct Graph *graph, struct GraphWorkspace *workspace,
+                            struct GraphPathCache *cache, int source, int target, int path[],
+                            int *length, int *distance);
+
+/**
+ * @brief Single-source shortest paths with Bellman-Ford (negative weights allowed)
+ *
+ * Outputs are filled as for graphDijkstra(). On GRAPH_NEGATIVE_CYCLE
+ * they hold the state after V - 1 passes and are not shortest distances.
+ *
+ * @param graph Graph
+ * @param workspace Workspace for the ...Ws() variant (NULL = temporary)
+ * @param source Source vertex
+ * @param dist Output: n shortest distances
+ * @param parent Output: n shortest-path tree parents (may be NULL)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NEGATIVE_CYCLE,
+ *         GRAPH_OVERFLOW or GRAPH_NEEDS_EDGE_LIST
+ */
+int graphBellmanFord(const struct Graph *graph, int source, int dist[], int parent[]);
+int graphBellmanFordWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                       int dist[], int parent[]);
+
+/**
+ * @brief Bellman-Ford from several sources with one edge sweep per pass
+ *
+ * Sources are relaxed in groups of 16 whose distances are interleaved
+ * per vertex, so every pass loads each edge once per group instead of
+ * once per source, and the 16 relaxations of an edge compile to vector
+ * min/add. Groups run as tasks of the shared thread pool. Each source
+ * gets the result graphBellmanFord() would give it.
+ *
+ * @param graph Graph
+ * @param workspace Workspace for the ...Ws() variant (NULL = temporary)
+ * @param sources Source vertices
+ * @param count Number of sources
+ * @param dist Output: count × n distances, dist[i * n + v] from sources[i]
+ * @param parent Output: count × n parents in the same layout (may be NULL)
+ * @param status Output: GRAPH_OK or GRAPH_NEGATIVE_CYCLE for every source
+ * @return GRAPH_OK, GRAPH_NEGATIVE_CYCLE if any source reached a negative
+ *         cycle, GRAPH_INVALID_ARGUMENT, GRAPH_NEEDS_EDGE_LIST or
+ *         GRAPH_NO_MEMORY
+ */
+int graphBellmanFordBatch(const struct Graph *graph, const int sources[], int count, int dist[],
+                          int parent[], int status[]);
+int graphBellmanFordBatchWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                            const int sources[], int count, int dist[], int parent[],
+                            int status[]);
+
+/**
+ * @brief Hop distances with the direction-optimizing BFS engine (see bfs.h)
+ *
+ * Weights are ignored. Outputs are filled as for graphDijkstra(). A
+ * directed graph needs O(V + E) scratch memory for its in-arcs.
+ *
+ * @param graph Graph
+ * @param workspace Workspace for the ...Ws() variant (NULL = temporary)
+ * @param source Source vertex
+ * @param threads Tasks each level is split into (0 = threads of the pool, see
+ *                graphThreadPoolConfigure())
+ * @param dist Output: n hop distances
+ * @param parent Output: n BFS tree parents (may be NULL)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int graphBfs(const struct Graph *graph, int source, int threads, int dist[], int parent[]);
+int graphBfsWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source, int threads,
+               int dist[], int parent[]);
+
+/**
+ * @brief Minimum spanning forest with Kruskal's algorithm
+ *
+ * Tree edges are written in the order they were accepted (ascending
+ * weight). If the graph is not connected the minimum spanning forest is
+ * written and GRAPH_NOT_CONNECTED is returned.
+ *
+ * @param graph Undirected graph
+ * @param workspace Workspace for the ...Ws() variant (NULL = temporary)
+ * @param tree Output: up to n - 1 tree edges
+ * @param treeEdges Output: number of tree edges written
+ * @param totalWeight Output: sum of the tree edge weights (may be NULL)
+ * @return GRAPH_OK, GRAPH_NOT_CONNECTED, GRAPH_NEEDS_UNDIRECTED,
+ *         GRAPH_NEEDS_EDGE_LIST, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int graphKruskal(const struct Graph *graph, struct GraphEdge tree[], int *treeEdges,
+                 long long *totalWeight);
+int graphKruskalWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                   struct GraphEdge tree[], int *treeEdges, long long *totalWeight);
+
+/**
+ * @brief Minimum spanning tree with Prim's algorithm (binary heap)
+ *
+ * Vertices the tree cannot reach keep parent -1 and GRAPH_NOT_CONNECTED
+ * is returned; the tree of the root's component is still valid.
+ *
+ * @param graph Undirected graph
+ * @param workspace Workspace for the ...Ws() variant (NULL = temporary)
+ * @param root Vertex the tree grows from
+ * @param parent Output: n tree parents (-1 for the root)
+ * @param weight Output: n weights of the edge to the parent (may be NULL)
+ * @param totalWeight Output: sum of the tree edge weights (may be NULL)
+ * @return GRAPH_OK, GRAPH_NOT_CONNECTED, GRAPH_NEEDS_UNDIRECTED,
+ *         GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int graphPrim(const struct Graph *graph, int root, int parent[], int weight[],
+              long long *totalWeight);
+int graphPrimWs(const struct Graph *graph, struct GraphWorkspace *workspace, int root,
+                int parent[], int weight[], long long *totalWeight);
+
+/**
+ * @brief Connected components and a spanning forest with a concurrent union-find
+ *
+ * Joins run in parallel on the shared thread pool with Afforest neighbor
+ * sampling (see components.c). A directed graph gives its weakly
+ * connected components. Components are numbered 0 .. components - 1 in
+ * the order of their smallest vertex. The forest has one edge per vertex
+ * minus one per component; which edges it holds may differ between runs
+ * with more than one thread, and their weights are only carried along.
+ *
+ * @param graph Graph
+ * @param workspace Workspace for the ...Ws() variant (NULL = temporary)
+ * @param threads Chunking hint: the work is split into chunks for this many
+ *                threads (0 = threads of the pool, see graphThreadPoolConfigure())
+ *                that any pool thread may run; 1 runs them all on the calling thread
+ * @param label Output: n component numbers (may be NULL)
+ * @param size Output: vertices per component, up to n entries (may be NULL)
+ * @param components Output: number of components
+ * @param forest Output: up to n - 1 spanning forest edges (may be NULL)
+ * @param forestEdges Output: number of forest edges written (needed with forest)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int graphConnectedComponents(const struct Graph *graph, int threads, int label[], int size[],
+                             int *components, struct GraphEdge forest[], int *forestEdges);
+int graphConnectedComponentsWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                               int threads, int label[], int size[], int *components,
+                               struct GraphEdge forest[], int *forestEdges);
+
+/**
+ * @brief Maximum flow with Edmonds-Karp (shortest augmenting paths)
+ *
+ * Edge weights are capacities; an undirected edge carries flow in either
+ * direction. edgeFlow[i] is the flow on edges[i] of the input, negative
+ * if an undirected edge carries it from v to u. A flow value above
+ * GRAPH_INF is reported as GRAPH_INF with GRAPH_OVERFLOW. A directed
+ * unit-capacity bipartite network (source → left → right → sink, weights
+ * 0 or 1) is solved as a matching with Hopcroft-Karp in O(E√V).
+ *
+ * @param graph Graph with non-negative weights
+ * @param workspace Workspace for the ...Ws() variant (NULL = temporary)
+ * @param source Source vertex
+ * @param sink Sink vertex
+ * @param flow Output: maximum flow value
+ * @param edgeFlow Output: flow on every input edge (may be NULL)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NEGATIVE_WEIGHT,
+ *         GRAPH_NEEDS_EDGE_LIST, GRAPH_OVERFLOW or GRAPH_NO_MEMORY
+ */
+int graphMaxFlow(const struct Graph *graph, int source, int sink, int *flow, int edgeFlow[]);
+int graphMaxFlowWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                   int sink, int *flow, int edgeFlow[]);
+
+/**
+ * @brief Typed variants of the weighted queries for graphs from graphCreateTyped()
+ *
+ * They behave as their int counterparts, but distances, edge weights and
+ * edge flows have the graph's weight type (see graphWeightType()) and
+ * unreachable vertices get that type's infinity. Tree weights and flow
+ * values are long long for integer types and double for float and
+ * double. Sums saturate at infinity instead of overflowing. Kruskal
+ * writes the input indices of the tree edges. Graphs whose weights fit
+ * int run the int32 kernels and widen the results; the others run
+ * kernels generated for their type.
+ *
+ * @param graph Graph
+ * @param workspace Workspace for the ...Ws() variants (NULL = temporary)
+ * @return As the int counterpart
+ */
+int graphDijkstraTyped(const struct Graph *graph, int source, void *dist, int parent[]);
+int graphDijkstraTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                         void *dist, int parent[]);
+int graphBellmanFordTyped(const struct Graph *graph, int source, void *dist, int parent[]);
+int graphBellmanFordTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                            int source, void *dist, int parent[]);
+int graphKruskalTyped(const struct Graph *graph, int treeEdge[], int *treeEdges,
+                      void *totalWeight);
+int graphKruskalTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                        int treeEdge[], int *treeEdges, void *totalWeight);
+int graphPrimTyped(const struct Graph *graph, int root, int parent[], void *weight,
+                   void *totalWeight);
+int graphPrimTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace, int root,
+                     int parent[], void *weight, void *totalWeight);
+int graphMaxFlowTyped(const struct Graph *graph, int source, int sink, void *flow,
+                      void *edgeFlow);
+int graphMaxFlowTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                        int sink, void *flow, void *edgeFlow);
+
+/**
+ * @brief Describe a result code
+ * @param status Result code
+ * @return Human-readable description
+ */
+const char *graphStatusMessage(int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GRAPH_H
@@ -0,0 +1,179 @@
+/**
+ * @file graph_file.h
+ * @brief Versioned binary graph format loaded by memory mapping
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * A graph file holds a graph in CSR form: a 128-byte header followed by
+ * arrays of 32-bit integers, each starting on a 64-byte boundary. The
+ * arrays have exactly the layout the algorithms use, so a loaded file is
+ * used in place: the loader maps it read-only and hands out pointers
+ * into the mapping, without parsing or copying. Processes that open the
+ * same file share its pages in the page cache.
+ *
+ * Layout (all integers in the byte order of the writing machine):
+ *   magic "GRAPHCSR", version, byte-order tag, flags, vertex count,
+ *   arc count, then the file position of every section (0 = absent).
+ *   Sections: offsets (n + 1), targets (m), weights (m), capacities (m),
+ *   in-arc offsets (n + 1), in-arc sources (m), in-arc indices (m).
+ */
+
+#ifndef GRAPH_FILE_H
+#define GRAPH_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define GRAPH_FILE_MAGIC "GRAPHCSR"
+#define GRAPH_FILE_VERSION 1
+#define GRAPH_FILE_BYTE_ORDER 0x01020304u
+#define GRAPH_FILE_ALIGN 64
+
+// Header flags
+#define GRAPH_FILE_DIRECTED 0x1u   // Arcs are directed (otherwise both directions are stored)
+#define GRAPH_FILE_WEIGHTS 0x2u    // Weight section present
+#define GRAPH_FILE_CAPACITIES 0x4u // Capacity section present
+#define GRAPH_FILE_IN_ARCS 0x8u    // In-arc sections present
+
+/**
+ * @brief Sections of a graph file, in file order
+ */
+enum GraphFileSection
+{
+    SECTION_OFFSET,
+    SECTION_TARGET,
+    SECTION_WEIGHT,
+    SECTION_CAPACITY,
+    SECTION_IN_OFFSET,
+    SECTION_IN_SOURCE,
+    SECTION_IN_ARC,
+    SECTION_COUNT
+};
+
+/**
+ * @brief Structure of the 128-byte file header
+ */
+struct GraphFileHeader
+{
+    char magic[8];                     // GRAPH_FILE_MAGIC, not NUL-terminated
+    uint32_t version;                  // GRAPH_FILE_VERSION
+    uint32_t byteOrder;                // GRAPH_FILE_BYTE_ORDER as written
+    uint32_t flags;                    // GRAPH_FILE_* flags
+    uint32_t reserved;                 // Zero
+    uint64_t vertices;                 // Number of vertices
+    uint64_t arcs;                     // Number of arcs
+    uint64_t section[SECTION_COUNT];   // File position of every section, 0 if absent
+    uint64_t padding[4];               // Zero; pads the header to 128 bytes
+};
+
+/**
+ * @brief Result codes of the graph file functions
+ */
+enum GraphFileStatus
+{
+    GRAPH_FILE_OK,
+    GRAPH_FILE_IO_ERROR,     // The file could not be opened, read, mapped or written
+    GRAPH_FILE_BAD_MAGIC,    // Not a graph file
+    GRAPH_FILE_BAD_VERSION,  // Unsupported version or foreign byte order
+    GRAPH_FILE_BAD_LAYOUT,   // Sections overlap, are misaligned or exceed the file
+    GRAPH_FILE_TOO_LARGE,    // More vertices or arcs than 32-bit indices can address
+    GRAPH_FILE_PARSE_ERROR,  // Malformed line in a text edge list
+    GRAPH_FILE_BAD_CONTENTS  // Offsets decrease or an index is out of range
+};
+
+/**
+ * @brief Structure to represent a graph file mapped into memory
+ *
+ * All array pointers point into the read-only mapping; absent sections
+ * are NULL.
+ */
+struct GraphFile
+{
+    int n;               // Number of vertices
+    int arcs;            // Number of arcs
+    uint32_t flags;      // GRAPH_FILE_* flags
+    const int *offset;   // Out-arc offsets (n + 1 entries)
+    const int *target;   // Head of every arc
+    const int *weight;   // Weight of every arc
+    const int *capacity; // Capacity of every arc
+    const int *inOffset; // In-arc offsets (n + 1 entries)
+    const int *inSource; // Tail of every in-arc
+    const int *inArc;    // Out-arc index of every in-arc
+    void *map;           // Start of the mapping
+    size_t mapSize;      // Length of the mapping in bytes
+};
+
+/**
+ * @brief Structure to describe a CSR graph to be written to a file
+ *
+ * Optional arrays may be NULL; in-arcs need all three in-arc arrays.
+ */
+struct GraphFileData
+{
+    int n;
+    int arcs;
+    bool directed;
+    const int *offset;
+    const int *target;
+    const int *weight;
+    const int *capacity;
+    const int *inOffset;
+    const int *inSource;
+    const int *inArc;
+};
+
+/**
+ * @brief Write a CSR graph in the binary graph format
+ * @param path Output file path
+ * @param data Graph arrays to write
+ * @return GRAPH_FILE_OK or GRAPH_FILE_IO_ERROR
+ */
+int writeGraphFile(const char *path, const struct GraphFileData *data);
+
+/**
+ * @brief Map a graph file and point the arrays into the mapping
+ *
+ * The header and section layout are always checked. With validate set,
+ * the offsets and in-arc offsets must also be monotonic, every target
+ * and in-arc source in [0, n) and every in-arc index in [0, arcs); this
+ * reads the whole index part of the file once, O(V + E). Without it the
+ * arrays are trusted, so only open files written by writeGraphFile().
+ *
+ * @param path File path
+ * @param file Output: mapped graph
+ * @param validate Check the array contents as well as the layout
+ * @return GRAPH_FILE_OK or the reason the file was rejected
+ */
+int openGraphFile(const char *path, struct GraphFile *file, bool validate);
+
+/**
+ * @brief Unmap a graph file opened with openGraphFile()
+ * @param file Mapped graph
+ */
+void closeGraphFile(struct GraphFile *file);
+
+/**
+ * @brief Convert a text edge list to the binary graph format
+ *
+ * Every non-empty line that does not start with '#' holds "u v" or
+ * "u v weight" or "u v weight capacity". The vertex count is the largest
+ * vertex id plus one. Undirected lists store both arcs of every edge;
+ * directed lists also get the in-arc sections.
+ *
+ * @param textPath Input edge list path
+ * @param binaryPath Output graph file path
+ * @param directed true if the edges are directed
+ * @param line Output: line number of a parse error (may be NULL)
+ * @return GRAPH_FILE_OK or the reason the conversion failed
+ */
+int convertEdgeList(const char *textPath, const char *binaryPath, bool directed, long *line);
+
+/**
+ * @brief Describe a result code
+ * @param status Result code
+ * @return Human-readable description
+ */
+const char *graphFileStatusMessage(int status);
+
+#endif // GRAPH_FILE_H
@@ -0,0 +1,106 @@
+/**
+ * @file graph_gen.h
+ * @brief Synthetic graph generators for benchmarks and tests
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Every generator is deterministic for a given seed on every platform,
+ * so a benchmark run can be repeated exactly. The result is an edge list
+ * for graphCreate(); the caller frees it with free(). Weights are drawn
+ * uniformly from 1 .. maxWeight.
+ */
+
+#ifndef GRAPH_GEN_H
+#define GRAPH_GEN_H
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Generate an R-MAT (Kronecker) graph with a power-law degree
+ *        distribution
+ *
+ * Uses the Graph500 quadrant probabilities a = 0.57, b = c = 0.19,
+ * d = 0.05 and randomly permutes the vertex IDs afterwards, so the hubs
+ * are not clustered at low IDs.
+ *
+ * @param scale log2 of the number of vertices (1 .. 30)
+ * @param edgeFactor Edges per vertex
+ * @param maxWeight Largest edge weight (>= 1)
+ * @param seed Random seed
+ * @param edgeCount Output: number of edges (edgeFactor << scale)
+ * @return Edge list, or NULL if an argument is out of range or memory ran out
+ */
+struct GraphEdge *generateRmat(int scale, int edgeFactor, int maxWeight, unsigned long long seed,
+                               int *edgeCount);
+
+/**
+ * @brief Generate an Erdős-Rényi G(n, m) graph: m edges between uniformly
+ *        random endpoints
+ * @param n Number of vertices (>= 1)
+ * @param m Number of edges
+ * @param maxWeight Largest edge weight (>= 1)
+ * @param seed Random seed
+ * @return Edge list, or NULL if an argument is out of range or memory ran out
+ */
+struct GraphEdge *generateErdosRenyi(int n, int m, int maxWeight, unsigned long long seed);
+
+/**
+ * @brief Generate a road-like 2D grid
+ *
+ * Vertex r * cols + c is joined to its right and lower neighbours, so the
+ * graph is planar with a large diameter, like a road network.
+ *
+ * @param rows Number of rows (>= 1)
+ * @param cols Number of columns (>= 1)
+ * @param maxWeight Largest edge weight (>= 1)
+ * @param seed Random seed
+ * @param edgeCount Output: number of edges
+ * @return Edge list, or NULL if an argument is out of range or memory ran out
+ */
+struct GraphEdge *generateGrid(int rows, int cols, int maxWeight, unsigned long long seed,
+                               int *edgeCount);
+
+/**
+ * @brief Generate a directed bipartite flow network
+ *
+ * Vertex 0 is the source, 1 .. left the left side, left + 1 .. left +
+ * right the right side and left + right + 1 the sink. The source feeds
+ * every left vertex, every right vertex drains into the sink, and every
+ * left vertex has degree edges to random right vertices. With
+ * maxCapacity 1 the network has the unit bipartite matching shape.
+ *
+ * @param left Number of left vertices (>= 1)
+ * @param right Number of right vertices (>= 1)
+ * @param degree Edges from every left vertex to the right side
+ * @param maxCapacity Largest capacity (>= 1)
+ * @param seed Random seed
+ * @param edgeCount Output: number of edges
+ * @return Edge list, or NULL if an argument is out of range or memory ran out
+ */
+struct GraphEdge *generateBipartiteFlow(int left, int right, int degree, int maxCapacity,
+                                        unsigned long long seed, int *edgeCount);
+
+/**
+ * @brief Randomly relabel the vertices of an edge list in place
+ *
+ * Destroys the locality of generated IDs (grid rows, for example), which
+ * is what real inputs usually look like.
+ *
+ * @param n Number of vertices
+ * @param edges Edge list
+ * @param edgeCount Number of edges
+ * @param seed Random seed
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+int shuffleVertexIds(int n, struct GraphEdge edges[], int edgeCount, unsigned long long seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GRAPH_GEN_H
@@ -0,0 +1,111 @@
+/**
+ * @file graph_output.h
+ * @brief Bulk output of shortest-path results and on-demand paths
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Large results are written in one pass over dist[] and parent[] instead
+ * of one formatted call per value: text is formatted by hand into a 1 MB
+ * buffer that is written with a few write() calls, and the binary format
+ * writes the arrays as they are. Full paths are only rebuilt for the
+ * targets the caller asks for.
+ *
+ * Text format, one vertex per line: "vertex dist parent", with "inf" for
+ * unreachable vertices and -1 for no parent.
+ *
+ * Binary format (integers in the byte order of the writing machine):
+ *   32-byte struct GraphResultHeader, dist (n × int32), then parent
+ *   (n × int32) if GRAPH_RESULT_PARENTS is set. Unreachable vertices
+ *   have dist GRAPH_INF.
+ */
+
+#ifndef GRAPH_OUTPUT_H
+#define GRAPH_OUTPUT_H
+
+#include <stdint.h>
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define GRAPH_RESULT_MAGIC "GRAPHSSP"
+#define GRAPH_RESULT_VERSION 1
+#define GRAPH_RESULT_BYTE_ORDER 0x01020304u
+#define GRAPH_RESULT_PARENTS 0x1u // Parent array follows the distances
+
+/**
+ * @brief Output formats of graphWriteResult()
+ */
+enum GraphOutputFormat
+{
+    GRAPH_OUTPUT_TEXT,  // "vertex dist parent" lines
+    GRAPH_OUTPUT_BINARY // Header plus raw arrays
+};
+
+/**
+ * @brief Structure of the 32-byte header of a binary result
+ */
+struct GraphResultHeader
+{
+    char magic[8];      // GRAPH_RESULT_MAGIC, not NUL-terminated
+    uint32_t version;   // GRAPH_RESULT_VERSION
+    uint32_t byteOrder; // GRAPH_RESULT_BYTE_ORDER as written
+    uint32_t flags;     // GRAPH_RESULT_* flags
+    int32_t source;     // Source vertex of the search
+    uint64_t vertices;  // Number of vertices
+};
+
+/**
+ * @brief Write a single-source result to a file descriptor
+ * @param fd Open file descriptor (e.g. 1 for stdout)
+ * @param format enum GraphOutputFormat
+ * @param n Number of vertices
+ * @param source Source vertex (recorded in the binary header)
+ * @param dist Distances (GRAPH_INF = unreachable)
+ * @param parent Parents (-1 = none; may be NULL)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NO_MEMORY or GRAPH_IO_ERROR
+ */
+int graphWriteResult(int fd, int format, int n, int source, const int dist[], const int parent[]);
+
+/**
+ * @brief Rebuild the path to one vertex from a parent array
+ *
+ * Walks parent[] from target to the root of its tree and reverses the
+ * walk, so the cost is the length of this path only.
+ *
+ * @param n Number of vertices
+ * @param parent Parents (-1 = root)
+ * @param target Vertex to reach
+ * @param path Output: root, ..., target (room for n vertices)
+ * @param length Output: number of vertices on the path
+ * @return GRAPH_OK, or GRAPH_INVALID_ARGUMENT if target is out of range
+ *         or parent[] loops
+ */
+int graphPathTo(int n, const int parent[], int target, int path[], int *length);
+
+/**
+ * @brief Write the paths to selected targets as text
+ *
+ * One line per target: "target dist v0 v1 ... target", or "target inf"
+ * if the target is unreachable. Writing stops at the first target whose
+ * parent chain is broken; the lines of the targets before it are kept.
+ *
+ * @param fd Open file descriptor
+ * @param n Number of vertices
+ * @param dist Distances (GRAPH_INF = unreachable)
+ * @param parent Parents (-1 = none)
+ * @param targets Vertices whose paths are wanted
+ * @param count Number of targets
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NO_MEMORY or GRAPH_IO_ERROR
+ */
+int graphWritePaths(int fd, int n, const int dist[], const int parent[], const int targets[],
+                    int count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GRAPH_OUTPUT_H
@@ -0,0 +1,129 @@
+/**
+ * @file partition.h
+ * @brief Partitioned shortest paths and BFS across worker processes
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * A graph that is too large for one address space is split into P
+ * contiguous vertex ranges with about the same number of arcs. Each
+ * range is owned by a worker process that maps the graph file, copies
+ * the out-arcs of its own vertices and unmaps the rest, so no process
+ * ever holds the whole graph.
+ *
+ * Workers run bulk-synchronous supersteps: relax the active vertices
+ * they own, send the distance updates for vertices owned elsewhere in
+ * one batch per peer, apply the batches they receive, and agree on the
+ * next bucket and on termination. Delta-stepping only relaxes vertices
+ * in the lowest non-empty bucket of width delta; delta 0 is plain
+ * frontier Bellman-Ford and BFS is delta-stepping with unit weights.
+ *
+ * Messages travel over a struct GraphTransport. The built-in transport
+ * connects every pair of processes with a Unix socket pair, standing in
+ * for the network of a cluster; other transports (shared memory, MPI,
+ * TCP) only have to implement the five callbacks.
+ */
+
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <stddef.h>
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Structure of a message transport between the processes of a run
+ *
+ * Endpoints 0 .. P - 1 are the workers and endpoint P is the calling
+ * process, which collects the results. create() runs once before the
+ * workers are forked; every process then calls attach() with its own
+ * endpoint and destroy() when it is done. send() and receive() may
+ * block and return 0 on success or -1 once the peer is gone; the workers
+ * pair up so that every send has a matching receive on the other side.
+ * create() returns NULL if the channels cannot be set up.
+ */
+struct GraphTransport
+{
+    const char *name;
+    void *(*create)(int endpoints);
+    void (*attach)(void *state, int self);
+    int (*send)(void *state, int self, int to, const void *data, size_t bytes);
+    int (*receive)(void *state, int self, int from, void *data, size_t bytes);
+    void (*destroy)(void *state, int self);
+};
+
+/**
+ * @brief Transport over one Unix stream socket pair per pair of processes
+ */
+extern const struct GraphTransport graphSocketTransport;
+
+/**
+ * @brief Structure to configure a partitioned run
+ */
+struct GraphPartitionConfig
+{
+    int parts;                              // Worker processes (clamped to the vertex count)
+    int delta;                              // Bucket width (0 = Bellman-Ford)
+    const struct GraphTransport *transport; // NULL = graphSocketTransport
+};
+
+/**
+ * @brief Structure to report the communication of a partitioned run
+ */
+struct GraphPartitionReport
+{
+    int parts;          // Worker processes used
+    int supersteps;     // Bulk-synchronous rounds
+    long long updates;  // Distance updates sent to other workers
+    long long messages; // Update batches and status records sent between workers
+    long long bytes;    // Bytes sent between workers
+};
+
+/**
+ * @brief Single-source shortest paths on a graph file, split across processes
+ *
+ * With delta 0 negative weights are allowed and a negative cycle is
+ * reported after V supersteps; delta-stepping needs non-negative weights.
+ * Outputs are filled as for graphBellmanFord(); parents may differ
+ * between runs when several shortest paths exist.
+ *
+ * @param path Graph file (see graph_file.h)
+ * @param source Source vertex
+ * @param config Partitioning (NULL = one worker, Bellman-Ford, sockets)
+ * @param dist Output: n shortest distances
+ * @param parent Output: n shortest-path tree parents (may be NULL)
+ * @param report Output: communication counters (may be NULL)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT (also if the file cannot be used),
+ *         GRAPH_NEGATIVE_WEIGHT, GRAPH_NEGATIVE_CYCLE, GRAPH_NO_MEMORY or
+ *         GRAPH_IO_ERROR if a worker or the transport failed
+ */
+int graphPartitionedShortestPaths(const char *path, int source,
+                                  const struct GraphPartitionConfig *config, int dist[],
+                                  int parent[], struct GraphPartitionReport *report);
+
+/**
+ * @brief Hop distances on a graph file, split across processes
+ *
+ * Weights are ignored and config->delta is not used; every superstep
+ * expands one BFS level.
+ *
+ * @param path Graph file (see graph_file.h)
+ * @param source Source vertex
+ * @param config Partitioning (NULL = one worker over sockets)
+ * @param dist Output: n hop distances
+ * @param parent Output: n BFS tree parents (may be NULL)
+ * @param report Output: communication counters (may be NULL)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NO_MEMORY or GRAPH_IO_ERROR
+ */
+int graphPartitionedBfs(const char *path, int source, const struct GraphPartitionConfig *config,
+                        int dist[], int parent[], struct GraphPartitionReport *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARTITION_H
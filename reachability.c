@@ -0,0 +1,199 @@
+/**
+ * @file reachability.c
+ * @brief Reachability and hop-count queries with the direction-optimizing BFS engine
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Breadth-first search visits vertices in order of their hop distance
+ * from a source. The engine in src/bfs.c switches every level between
+ * top-down and bottom-up expansion and splits each level into tasks for
+ * the shared thread pool, which pays off on large low-diameter graphs.
+ *
+ * Time Complexity: O(V + E)
+ * Space Complexity: O(V + E)
+ */
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bfs.h"
+
+/**
+ * @brief Allocate memory or terminate the program
+ * @param size Number of bytes to allocate
+ * @return Pointer to the allocated memory
+ */
+static void *allocOrExit(size_t size)
+{
+    void *ptr = malloc(size > 0 ? size : 1);
+    if (!ptr)
+    {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+/**
+ * @brief Read a monotonic clock
+ * @return Current time in milliseconds
+ */
+static double nowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * @brief Build an undirected CSR graph from an edge list
+ * @param n Number of vertices
+ * @param m Number of undirected edges
+ * @param edges Edge endpoints, edges[2i] - edges[2i + 1]
+ * @param offset Output: arc offsets (n + 1 entries)
+ * @param target Output: arc heads (2m entries)
+ */
+static void buildUndirected(int n, int m, const int edges[], int offset[], int target[])
+{
+    for (int v = 0; v <= n; v++)
+    {
+        offset[v] = 0;
+    }
+    for (int i = 0; i < m; i++)
+    {
+        offset[edges[2 * i] + 1]++;
+        offset[edges[2 * i + 1] + 1]++;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        offset[v + 1] += offset[v];
+    }
+
+    int *cursor = allocOrExit(n * sizeof(int));
+    for (int v = 0; v < n; v++)
+    {
+        cursor[v] = offset[v];
+    }
+    for (int i = 0; i < m; i++)
+    {
+        int u = edges[2 * i], v = edges[2 * i + 1];
+        target[cursor[u]++] = v;
+        target[cursor[v]++] = u;
+    }
+    free(cursor);
+}
+
+/**
+ * @brief Print the hop distance and BFS tree path of every vertex
+ * @param n Number of vertices
+ * @param dist Hop distances
+ * @param parent BFS tree parents
+ */
+void printHops(int n, const int dist[], const int parent[])
+{
+    printf("╔═══════════════════════════════════════════════════════════════╗\n");
+    printf("║                    BFS REACHABILITY RESULT                    ║\n");
+    printf("╠═══════════════════════════════════════════════════════════════╣\n");
+    printf("║ Vertex │   Hops   │ Path                                      ║\n");
+    printf("╠════════╪══════════╪═══════════════════════════════════════════╣\n");
+
+    for (int i = 0; i < n; i++)
+    {
+        printf("║   %d    │", i);
+        if (dist[i] == -1)
+        {
+            printf("    ∞     │ %-42s║\n", "Unreachable");
+            continue;
+        }
+        printf("    %2d    │ ", dist[i]);
+
+        // Walk the tree back to the source
+        int path[64], pathLength = 0;
+        for (int v = i; v != -1; v = parent[v])
+        {
+            path[pathLength++] = v;
+        }
+        for (int j = pathLength - 1; j >= 0; j--)
+        {
+            printf("%d%s", path[j], j > 0 ? " → " : "");
+        }
+        printf("%*s║\n", 42 - (pathLength * 4 - 3), "");
+    }
+    printf("╚═══════════════════════════════════════════════════════════════╝\n");
+}
+
+/**
+ * @brief Main function demonstrating the BFS engine
+ * @return 0 on successful execution
+ */
+int main()
+{
+    printf("🔗 Graph Theory Algorithms - Direction-Optimizing BFS\n");
+    printf("=====================================================\n\n");
+
+    // Small undirected example; vertex 7 is isolated
+    int n = 8;
+    int edges[] = {0, 1, 0, 2, 1, 3, 2, 3, 3, 4, 4, 5, 5, 6, 2, 6};
+    int m = sizeof(edges) / sizeof(edges[0]) / 2;
+    int offset[9], target[16];
+    buildUndirected(n, m, edges, offset, target);
+
+    printf("Input Graph (Edge List):\n");
+    for (int i = 0; i < m; i++)
+    {
+        printf("  %d - %d\n", edges[2 * i], edges[2 * i + 1]);
+    }
+    printf("\nSource vertex: 0\n\n");
+
+    struct BfsGraph graph = {n, offset, target, offset, target, NULL, NULL, NULL};
+    struct BfsEngine *engine = createBfsEngine(n, 1);
+    int dist[8], parent[8];
+    int reached = bfsSearch(engine, &graph, 0, -1, dist, parent, NULL);
+    printHops(n, dist, parent);
+    printf("Reachable vertices: %d of %d\n", reached, n);
+    freeBfsEngine(engine);
+
+    // Large random graph: compare one thread with all threads
+    int bigN = 1 << 20;
+    int bigM = 8 * bigN;
+    printf("\n🔄 Random graph with %d vertices and %d edges:\n", bigN, bigM);
+
+    int *bigEdges = allocOrExit(2 * (size_t)bigM * sizeof(int));
+    unsigned int seed = 12345;
+    for (int i = 0; i < 2 * bigM; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        bigEdges[i] = (int)((seed >> 8) % (unsigned int)bigN);
+    }
+    int *bigOffset = allocOrExit((bigN + 1) * sizeof(int));
+    int *bigTarget = allocOrExit(2 * (size_t)bigM * sizeof(int));
+    buildUndirected(bigN, bigM, bigEdges, bigOffset, bigTarget);
+    free(bigEdges);
+
+    struct BfsGraph big = {bigN, bigOffset, bigTarget, bigOffset, bigTarget, NULL, NULL,
+                          NULL};
+    int *bigDist = allocOrExit(bigN * sizeof(int));
+    int threadCounts[] = {1, 0};
+    for (int i = 0; i < 2; i++)
+    {
+        engine = createBfsEngine(bigN, threadCounts[i]);
+        double start = nowMs();
+        reached = bfsSearch(engine, &big, 0, -1, bigDist, NULL, NULL);
+        double elapsed = nowMs() - start;
+
+        printf("  %2d thread(s): reached %d vertices in %d levels (%d bottom-up), %.1f ms\n",
+               engine->threads, reached, engine->levels, engine->bottomUpLevels, elapsed);
+        freeBfsEngine(engine);
+    }
+
+    free(bigOffset);
+    free(bigTarget);
+    free(bigDist);
+
+    printf("\n💡 Note: Bottom-up levels stop scanning a vertex's arcs at the first\n");
+    printf("   parent found, which skips most arcs once the frontier is large.\n");
+    return 0;
+}
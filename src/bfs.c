@@ -0,0 +1,446 @@
+/**
+ * @file bfs.c
+ * @brief Implementation of the direction-optimizing parallel BFS engine
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Top-down levels scan the arcs of every frontier vertex and claim
+ * unvisited heads with an atomic OR on the visited bitmap. Bottom-up
+ * levels let every unvisited vertex scan its in-arcs for a frontier
+ * vertex and stop at the first one; each part owns a range of bitmap
+ * words, so no atomics are needed. Every level is split into parts by
+ * bitmap words and the parts run as tasks of the shared thread pool
+ * (see pool.c). Following Beamer et al., a search
+ * switches to bottom-up when the arcs leaving the frontier exceed 1/α of
+ * the arcs of unvisited vertices, and back to top-down when the frontier
+ * drops below n/β vertices.
+ *
+ * Time Complexity: O(V + E)
+ * Space Complexity: O(V) (three bitmaps)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bfs.h"
+#include "graph_internal.h"
+
+#define ALPHA 14 // Top-down → bottom-up when frontier arcs > unexplored arcs / ALPHA
+#define BETA 24  // Bottom-up → top-down when frontier vertices < n / BETA
+
+/**
+ * @brief Structure to hold the per-part counters of one level
+ */
+struct BfsCounters
+{
+    long long vertices; // Vertices added to the next frontier
+    long long arcs;     // Out-arcs of those vertices
+    long long scanned;  // Arcs examined (GRAPH_STATS builds only)
+    char padding[40];   // Keep counters of different parts on separate cache lines
+};
+
+/**
+ * @brief Structure to share one search between the parts of its levels
+ */
+struct BfsShared
+{
+    struct BfsEngine *engine;
+    const struct BfsGraph *graph;
+    int target;
+    int *dist;
+    int *parent;
+    int *parentArc;
+    int level;                    // Level being expanded (frontier hop distance)
+    bool bottomUp;                // Direction of the level being expanded
+    bool done;                    // Set when the search is finished
+    long long frontierVertices;   // Vertices in the current frontier
+    long long frontierArcs;       // Out-arcs of the current frontier
+    long long unexploredArcs;     // Out-arcs of vertices not yet visited
+    long long reached;            // Vertices visited so far
+    struct BfsCounters *counters; // One entry per part
+    int parts;                    // Parts every level is split into
+};
+
+struct BfsEngine *createBfsEngine(int n, int threads)
+{
+    struct BfsEngine *engine = calloc(1, sizeof(struct BfsEngine));
+    if (!engine)
+    {
+        return NULL;
+    }
+
+    if (threads <= 0)
+    {
+        threads = poolThreads();
+    }
+
+    engine->n = n;
+    engine->words = (n + 63) / 64;
+    engine->threads = threads;
+    engine->visited = malloc(engine->words * sizeof(unsigned long long) + 1);
+    engine->current = malloc(engine->words * sizeof(unsigned long long) + 1);
+    engine->next = malloc(engine->words * sizeof(unsigned long long) + 1);
+    engine->counters = malloc(threads * sizeof(struct BfsCounters));
+    engine->levels = 0;
+    engine->bottomUpLevels = 0;
+
+    if (!engine->visited || !engine->current || !engine->next || !engine->counters)
+    {
+        freeBfsEngine(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+void freeBfsEngine(struct BfsEngine *engine)
+{
+    if (!engine)
+    {
+        return;
+    }
+    free(engine->visited);
+    free(engine->current);
+    free(engine->next);
+    free(engine->counters);
+    free(engine);
+}
+
+void buildInArcs(int n, const int offset[], const int target[],
+                 int inOffset[], int inSource[], int inArc[])
+{
+    // Count in-arcs of every vertex
+    for (int v = 0; v <= n; v++)
+    {
+        inOffset[v] = 0;
+    }
+    for (int a = 0; a < offset[n]; a++)
+    {
+        inOffset[target[a] + 1]++;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        inOffset[v + 1] += inOffset[v];
+    }
+
+    // Place every arc at its head, using inOffset[v] as the cursor of v;
+    // visiting tails in order keeps sources sorted
+    for (int u = 0; u < n; u++)
+    {
+        for (int a = offset[u]; a < offset[u + 1]; a++)
+        {
+            int k = inOffset[target[a]]++;
+            inSource[k] = u;
+            inArc[k] = a;
+        }
+    }
+
+    // Every cursor now points at the start of the next vertex: shift back
+    for (int v = n; v > 0; v--)
+    {
+        inOffset[v] = inOffset[v - 1];
+    }
+    inOffset[0] = 0;
+}
+
+/**
+ * @brief Record that v was reached from u through an arc
+ * @param s Shared search state
+ * @param v Reached vertex
+ * @param u Parent vertex
+ * @param arc Out-arc u → v, or -1 if unknown
+ */
+static void reach(struct BfsShared *s, int v, int u, int arc)
+{
+    if (s->dist)
+    {
+        s->dist[v] = s->level + 1;
+    }
+    if (s->parent)
+    {
+        s->parent[v] = u;
+    }
+    if (s->parentArc)
+    {
+        s->parentArc[v] = arc;
+    }
+}
+
+/**
+ * @brief Claim v for the next frontier if no part has visited it yet
+ * @param s Shared search state
+ * @param v Head of the arc
+ * @param u Frontier vertex
+ * @param arc Out-arc u → v, or -1 if unknown
+ * @param counters Counters of the calling part
+ */
+static inline void claim(struct BfsShared *s, int v, int u, int arc, struct BfsCounters *counters)
+{
+    unsigned long long *visited = s->engine->visited;
+    unsigned long long mask = 1ULL << (v & 63);
+    if (__atomic_load_n(&visited[v >> 6], __ATOMIC_RELAXED) & mask)
+    {
+        return;
+    }
+    if (__atomic_fetch_or(&visited[v >> 6], mask, __ATOMIC_RELAXED) & mask)
+    {
+        return; // Another part claimed v first
+    }
+
+    reach(s, v, u, arc);
+    __atomic_fetch_or(&s->engine->next[v >> 6], mask, __ATOMIC_RELAXED);
+    counters->vertices++;
+    counters->arcs += s->graph->offset[v + 1] - s->graph->offset[v];
+}
+
+/**
+ * @brief Expand one part of the frontier top-down
+ * @param s Shared search state
+ * @param lo First bitmap word of the part
+ * @param hi One past the last bitmap word of the part
+ * @param counters Counters of the part
+ */
+static void topDownStep(struct BfsShared *s, int lo, int hi, struct BfsCounters *counters)
+{
+    const struct BfsGraph *g = s->graph;
+
+    for (int w = lo; w < hi; w++)
+    {
+        unsigned long long bits = s->engine->current[w];
+        while (bits)
+        {
+            int u = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            STAT_ADD(counters, scanned, g->offset[u + 1] - g->offset[u]);
+            if (g->compressed)
+            {
+                struct ArcCursor arcs;
+                for (arcsBegin(g->compressed, u, &arcs); arcsNext(g->compressed, &arcs, false);)
+                {
+                    claim(s, arcs.target, u, -1, counters);
+                }
+                continue;
+            }
+            for (int a = g->offset[u]; a < g->offset[u + 1]; a++)
+            {
+                if (!g->alive || g->alive[a] > 0)
+                {
+                    claim(s, g->target[a], u, a, counters);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Expand one part of the unvisited vertices bottom-up
+ * @param s Shared search state
+ * @param lo First bitmap word of the part
+ * @param hi One past the last bitmap word of the part
+ * @param counters Counters of the part
+ */
+static void bottomUpStep(struct BfsShared *s, int lo, int hi, struct BfsCounters *counters)
+{
+    const struct BfsGraph *g = s->graph;
+    const unsigned long long *current = s->engine->current;
+    int n = g->n;
+
+    for (int w = lo; w < hi; w++)
+    {
+        unsigned long long unvisited = ~s->engine->visited[w];
+        if (w == s->engine->words - 1 && n % 64 != 0)
+        {
+            unvisited &= (1ULL << (n % 64)) - 1; // Ignore bits past the last vertex
+        }
+
+        unsigned long long found = 0;
+        while (unvisited)
+        {
+            int bit = __builtin_ctzll(unvisited);
+            int v = w * 64 + bit;
+            unvisited &= unvisited - 1;
+
+            // Look for any frontier vertex among the in-neighbours
+            int u = -1, arc = -1;
+            if (g->compressed)
+            {
+                struct ArcCursor arcs;
+                for (arcsBegin(g->compressed, v, &arcs); arcsNext(g->compressed, &arcs, false);)
+                {
+                    STAT_ADD(counters, scanned, 1);
+                    if (current[arcs.target >> 6] >> (arcs.target & 63) & 1)
+                    {
+                        u = arcs.target;
+                        break;
+                    }
+                }
+            }
+            for (int k = g->inOffset[v]; !g->compressed && k < g->inOffset[v + 1]; k++)
+            {
+                STAT_ADD(counters, scanned, 1);
+                int tail = g->inSource[k];
+                if (!(current[tail >> 6] >> (tail & 63) & 1))
+                {
+                    continue;
+                }
+                if (g->alive && g->alive[g->inArc[k]] <= 0)
+                {
+                    continue;
+                }
+                u = tail;
+                arc = g->inArc ? g->inArc[k] : -1;
+                break;
+            }
+            if (u == -1)
+            {
+                continue;
+            }
+
+            reach(s, v, u, arc);
+            found |= 1ULL << bit;
+            counters->vertices++;
+            counters->arcs += g->offset[v + 1] - g->offset[v];
+        }
+
+        // This part owns word w, so plain stores are safe
+        s->engine->visited[w] |= found;
+        s->engine->next[w] = found;
+    }
+}
+
+/**
+ * @brief Finish a level: swap frontiers and choose the next direction
+ *
+ * Runs on the searching thread once every part of the level is done.
+ *
+ * @param s Shared search state
+ */
+static void finishLevel(struct BfsShared *s)
+{
+    struct BfsEngine *engine = s->engine;
+    long long vertices = 0, arcs = 0;
+
+    for (int i = 0; i < s->parts; i++)
+    {
+        vertices += s->counters[i].vertices;
+        arcs += s->counters[i].arcs;
+        engine->arcsScanned += s->counters[i].scanned;
+        s->counters[i].vertices = 0;
+        s->counters[i].arcs = 0;
+        s->counters[i].scanned = 0;
+    }
+
+    TRACE_DEBUG("bfs", "level", "\"level\": %d, \"direction\": \"%s\", \"frontier\": %lld",
+                s->level + 1, s->bottomUp ? "bottom-up" : "top-down", vertices);
+    engine->levels++;
+    if (s->bottomUp)
+    {
+        engine->bottomUpLevels++;
+    }
+
+    unsigned long long *tmp = engine->current;
+    engine->current = engine->next;
+    engine->next = tmp;
+    memset(engine->next, 0, engine->words * sizeof(unsigned long long));
+
+    long long previous = s->frontierVertices;
+    s->frontierVertices = vertices;
+    s->frontierArcs = arcs;
+    s->unexploredArcs -= arcs;
+    s->reached += vertices;
+    s->level++;
+
+    if (vertices == 0 ||
+        (s->target >= 0 && engine->visited[s->target >> 6] >> (s->target & 63) & 1))
+    {
+        s->done = true;
+    }
+    else if (!s->bottomUp && s->graph->inOffset && arcs > s->unexploredArcs / ALPHA)
+    {
+        s->bottomUp = true;
+    }
+    else if (s->bottomUp && vertices < previous && vertices < s->graph->n / BETA)
+    {
+        s->bottomUp = false;
+    }
+}
+
+/**
+ * @brief Expand one part of the current level (pool task)
+ * @param context Pointer to the struct BfsShared of the search
+ * @param part Index of the part
+ */
+static void expandPart(void *context, int part)
+{
+    struct BfsShared *s = context;
+    int lo = chunkStart(s->engine->words, s->parts, part);
+    int hi = chunkStart(s->engine->words, s->parts, part + 1);
+
+    if (s->bottomUp)
+    {
+        bottomUpStep(s, lo, hi, &s->counters[part]);
+    }
+    else
+    {
+        topDownStep(s, lo, hi, &s->counters[part]);
+    }
+}
+
+int bfsSearch(struct BfsEngine *engine, const struct BfsGraph *graph, int source, int target,
+              int dist[], int parent[], int parentArc[])
+{
+    int n = graph->n;
+
+    for (int v = 0; v < n; v++)
+    {
+        if (dist)
+        {
+            dist[v] = -1;
+        }
+        if (parent)
+        {
+            parent[v] = -1;
+        }
+        if (parentArc)
+        {
+            parentArc[v] = -1;
+        }
+    }
+    if (dist)
+    {
+        dist[source] = 0;
+    }
+
+    memset(engine->visited, 0, engine->words * sizeof(unsigned long long));
+    memset(engine->current, 0, engine->words * sizeof(unsigned long long));
+    memset(engine->next, 0, engine->words * sizeof(unsigned long long));
+    engine->visited[source >> 6] |= 1ULL << (source & 63);
+    engine->current[source >> 6] |= 1ULL << (source & 63);
+    engine->levels = 0;
+    engine->bottomUpLevels = 0;
+
+    struct BfsShared shared;
+    shared.engine = engine;
+    shared.graph = graph;
+    shared.target = target;
+    shared.dist = dist;
+    shared.parent = parent;
+    shared.parentArc = parentArc;
+    shared.level = 0;
+    shared.bottomUp = false;
+    shared.done = source == target;
+    shared.frontierVertices = 1;
+    shared.frontierArcs = graph->offset[source + 1] - graph->offset[source];
+    shared.unexploredArcs = graph->offset[n] - shared.frontierArcs;
+    shared.reached = 1;
+    shared.counters = engine->counters;
+    shared.parts = engine->threads;
+    memset(shared.counters, 0, engine->threads * sizeof(struct BfsCounters));
+
+    while (!shared.done)
+    {
+        poolFor(shared.parts, expandPart, &shared);
+        finishLevel(&shared);
+    }
+    return (int)shared.reached;
+}
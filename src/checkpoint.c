@@ -0,0 +1,451 @@
+/**
+ * @file checkpoint.c
+ * @brief Checkpoint and resume for long Bellman-Ford and max-flow runs
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * The solver and one writer thread share a single snapshot buffer. The
+ * solver fills it only while the writer is idle, so a snapshot costs the
+ * solver one copy of its arrays and never a wait on the disk; the writer
+ * checksums the copy, writes it to a temporary file, flushes it and
+ * renames it over the previous snapshot.
+ *
+ * Time Complexity: O(V) (Bellman-Ford) or O(E) (max flow) per snapshot
+ * Space Complexity: one copy of the checkpointed arrays
+ */
+
+#define _POSIX_C_SOURCE 200809L // For fsync() and open()
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "checkpoint.h"
+#include "graph_internal.h"
+
+#define FNV_OFFSET 14695981039346656037ULL // FNV-1a start value
+#define FNV_PRIME 1099511628211ULL         // FNV-1a multiplier
+
+/**
+ * @brief Structure holding the checkpoint state of one run
+ */
+struct Checkpointer
+{
+    char *path;                          // Snapshot file
+    char *temp;                          // path + ".tmp", renamed over path when complete
+    double interval;                     // Minimum seconds between snapshots
+    double last;                         // Time the last snapshot was offered
+    int *resume;                         // Arrays of the snapshot to resume from (NULL = none)
+    struct GraphSnapshotHeader saved;    // Header of the snapshot to resume from
+    struct GraphSnapshotHeader header;   // Header of the snapshot in buffer
+    int *buffer;                         // Arrays handed to the writer
+    size_t capacity;                     // Values buffer can hold
+    pthread_t thread;                    // Writer thread
+    pthread_mutex_t lock;                // Guards busy, stop and report
+    pthread_cond_t wake;                 // Signals a new snapshot or the end of the run
+    bool busy;                           // The writer owns header and buffer
+    bool stop;                           // The run is over
+    struct GraphCheckpointReport report; // Counters of the run
+};
+
+/**
+ * @brief Extend an FNV-1a hash over a byte range
+ * @param hash Hash so far (FNV_OFFSET to start)
+ * @param data Bytes to hash
+ * @param length Number of bytes
+ * @return Extended hash
+ */
+static uint64_t hashBytes(uint64_t hash, const void *data, size_t length)
+{
+    const unsigned char *p = data;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ p[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Fingerprint a graph by its shape and stored edges
+ *
+ * Reordering is deterministic, so the same input always gives the same
+ * stored edges and slots, and a snapshot fits exactly the graphs with
+ * this fingerprint.
+ *
+ * @param graph Graph with an edge list
+ * @return Fingerprint
+ */
+static uint64_t graphFingerprint(const struct Graph *graph)
+{
+    int shape[3] = {graph->n, graph->edgeCount, graph->directed};
+    uint64_t hash = hashBytes(FNV_OFFSET, shape, sizeof(shape));
+    return hashBytes(hash, graph->edges, graph->edgeCount * sizeof(struct GraphEdge));
+}
+
+/**
+ * @brief Load the snapshot to resume from, if path holds one
+ * @param cp Checkpointer with path and header (kind, terminals, fingerprint) set
+ * @return GRAPH_OK (also if there is no file), GRAPH_INVALID_ARGUMENT if the
+ *         file is not a snapshot of this query, or GRAPH_NO_MEMORY
+ */
+static int loadSnapshot(struct Checkpointer *cp)
+{
+    int fd = open(cp->path, O_RDONLY);
+    if (fd < 0)
+    {
+        return errno == ENOENT ? GRAPH_OK : GRAPH_INVALID_ARGUMENT;
+    }
+
+    struct GraphSnapshotHeader *h = &cp->saved;
+    bool ok = readAll(fd, h, sizeof(*h)) &&
+              memcmp(h->magic, GRAPH_SNAPSHOT_MAGIC, sizeof(h->magic)) == 0 &&
+              h->version == GRAPH_SNAPSHOT_VERSION && h->byteOrder == GRAPH_SNAPSHOT_BYTE_ORDER &&
+              h->kind == cp->header.kind && h->source == cp->header.source &&
+              h->sink == cp->header.sink && h->arrays == cp->header.arrays &&
+              h->fingerprint == cp->header.fingerprint && h->count >= 0 && h->progress >= 0;
+    size_t bytes = ok ? (size_t)h->count * h->arrays * sizeof(int) : 0;
+    cp->resume = ok ? malloc(bytes + 1) : NULL;
+    int status = !ok ? GRAPH_INVALID_ARGUMENT : cp->resume ? GRAPH_OK : GRAPH_NO_MEMORY;
+    if (status == GRAPH_OK && (!readAll(fd, cp->resume, bytes) ||
+                               hashBytes(FNV_OFFSET, cp->resume, bytes) != h->checksum))
+    {
+        status = GRAPH_INVALID_ARGUMENT;
+    }
+    close(fd);
+    if (status != GRAPH_OK)
+    {
+        free(cp->resume);
+        cp->resume = NULL;
+    }
+    return status;
+}
+
+/**
+ * @brief Write the snapshot in the buffer and rename it over the previous one
+ * @param cp Checkpointer whose buffer the writer owns
+ * @return true if the snapshot reached the disk
+ */
+static bool writeSnapshot(struct Checkpointer *cp)
+{
+    size_t bytes = (size_t)cp->header.count * cp->header.arrays * sizeof(int);
+    cp->header.checksum = hashBytes(FNV_OFFSET, cp->buffer, bytes);
+
+    int fd = open(cp->temp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    bool ok = writeAll(fd, &cp->header, sizeof(cp->header)) && writeAll(fd, cp->buffer, bytes) &&
+              fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+    return ok && rename(cp->temp, cp->path) == 0;
+}
+
+/**
+ * @brief Writer thread: write every snapshot handed over until the run ends
+ * @param context struct Checkpointer of the run
+ * @return NULL
+ */
+static void *writerMain(void *context)
+{
+    struct Checkpointer *cp = context;
+    pthread_mutex_lock(&cp->lock);
+    while (true)
+    {
+        while (!cp->busy && !cp->stop)
+        {
+            pthread_cond_wait(&cp->wake, &cp->lock);
+        }
+        if (!cp->busy)
+        {
+            break; // Stopped with nothing left to write
+        }
+        pthread_mutex_unlock(&cp->lock);
+        bool ok = writeSnapshot(cp);
+        pthread_mutex_lock(&cp->lock);
+        if (ok)
+        {
+            cp->report.written++;
+        }
+        else
+        {
+            cp->report.failed++;
+        }
+        cp->busy = false;
+    }
+    pthread_mutex_unlock(&cp->lock);
+    return NULL;
+}
+
+int checkpointRestore(struct Checkpointer *checkpoint, int count, int first[], int second[],
+                      long long *progress)
+{
+    *progress = -1;
+    if (!checkpoint->resume)
+    {
+        return GRAPH_OK;
+    }
+    if (checkpoint->saved.count != count)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    memcpy(first, checkpoint->resume, count * sizeof(int));
+    if (second)
+    {
+        memcpy(second, checkpoint->resume + count, count * sizeof(int));
+    }
+    *progress = checkpoint->saved.progress;
+    return GRAPH_OK;
+}
+
+bool checkpointDue(struct Checkpointer *checkpoint)
+{
+    return nowMs() / 1000 - checkpoint->last >= checkpoint->interval;
+}
+
+void checkpointSave(struct Checkpointer *checkpoint, long long progress, int count,
+                    const int first[], const int second[])
+{
+    struct Checkpointer *cp = checkpoint;
+    cp->last = nowMs() / 1000;
+    pthread_mutex_lock(&cp->lock);
+    if (cp->busy)
+    {
+        cp->report.skipped++;
+        pthread_mutex_unlock(&cp->lock);
+        return;
+    }
+
+    size_t values = (size_t)count * cp->header.arrays;
+    if (values > cp->capacity)
+    {
+        int *buffer = realloc(cp->buffer, values * sizeof(int) + 1);
+        if (!buffer)
+        {
+            cp->report.failed++;
+            pthread_mutex_unlock(&cp->lock);
+            return;
+        }
+        cp->buffer = buffer;
+        cp->capacity = values;
+    }
+    memcpy(cp->buffer, first, count * sizeof(int));
+    if (second)
+    {
+        memcpy(cp->buffer + count, second, count * sizeof(int));
+    }
+    cp->header.count = count;
+    cp->header.progress = progress;
+    cp->busy = true;
+    pthread_cond_signal(&cp->wake);
+    pthread_mutex_unlock(&cp->lock);
+    TRACE_DEBUG("checkpoint", "save", "\"progress\": %lld", progress);
+}
+
+/**
+ * @brief Free a checkpointer that has no writer thread running
+ * @param cp Checkpointer (may be NULL)
+ */
+static void freeCheckpointer(struct Checkpointer *cp)
+{
+    if (!cp)
+    {
+        return;
+    }
+    free(cp->path);
+    free(cp->temp);
+    free(cp->resume);
+    free(cp->buffer);
+    free(cp);
+}
+
+/**
+ * @brief Load the snapshot to resume from and start the writer thread
+ * @param graph Graph of the run
+ * @param config Checkpoint configuration
+ * @param kind enum GraphSnapshotKind
+ * @param source Source vertex
+ * @param sink Sink vertex (-1 for Bellman-Ford)
+ * @param arrays Arrays per snapshot
+ * @param checkpoint Output: checkpointer of the run
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT or GRAPH_NO_MEMORY
+ */
+static int beginCheckpoints(const struct Graph *graph, const struct GraphCheckpointConfig *config,
+                            int kind, int source, int sink, int arrays,
+                            struct Checkpointer **checkpoint)
+{
+    struct Checkpointer *cp = calloc(1, sizeof(struct Checkpointer));
+    size_t length = strlen(config->path);
+    if (cp)
+    {
+        cp->path = malloc(length + 1);
+        cp->temp = malloc(length + sizeof(".tmp"));
+    }
+    if (!cp || !cp->path || !cp->temp)
+    {
+        freeCheckpointer(cp);
+        return GRAPH_NO_MEMORY;
+    }
+    memcpy(cp->path, config->path, length + 1);
+    memcpy(cp->temp, config->path, length);
+    memcpy(cp->temp + length, ".tmp", sizeof(".tmp"));
+    cp->interval = config->interval;
+    cp->last = nowMs() / 1000;
+    cp->report.resumedFrom = -1;
+
+    memcpy(cp->header.magic, GRAPH_SNAPSHOT_MAGIC, sizeof(cp->header.magic));
+    cp->header.version = GRAPH_SNAPSHOT_VERSION;
+    cp->header.byteOrder = GRAPH_SNAPSHOT_BYTE_ORDER;
+    cp->header.kind = kind;
+    cp->header.source = source;
+    cp->header.sink = sink;
+    cp->header.arrays = arrays;
+    cp->header.fingerprint = graphFingerprint(graph);
+
+    int status = config->resume ? loadSnapshot(cp) : GRAPH_OK;
+    if (status != GRAPH_OK)
+    {
+        freeCheckpointer(cp);
+        return status;
+    }
+    if (cp->resume)
+    {
+        cp->report.resumedFrom = cp->saved.progress;
+    }
+
+    pthread_mutex_init(&cp->lock, NULL);
+    pthread_cond_init(&cp->wake, NULL);
+    if (pthread_create(&cp->thread, NULL, writerMain, cp) != 0)
+    {
+        pthread_cond_destroy(&cp->wake);
+        pthread_mutex_destroy(&cp->lock);
+        freeCheckpointer(cp);
+        return GRAPH_NO_MEMORY;
+    }
+    *checkpoint = cp;
+    return GRAPH_OK;
+}
+
+/**
+ * @brief Let the writer finish the pending snapshot, then free the checkpointer
+ * @param cp Checkpointer of the run
+ * @param report Output: counters (may be NULL)
+ */
+static void endCheckpoints(struct Checkpointer *cp, struct GraphCheckpointReport *report)
+{
+    pthread_mutex_lock(&cp->lock);
+    cp->stop = true;
+    pthread_cond_signal(&cp->wake);
+    pthread_mutex_unlock(&cp->lock);
+    pthread_join(cp->thread, NULL);
+
+    TRACE_INFO("checkpoint", "done", "\"resumed\": %lld, \"written\": %d, \"skipped\": %d, "
+               "\"failed\": %d", cp->report.resumedFrom, cp->report.written, cp->report.skipped,
+               cp->report.failed);
+    if (report)
+    {
+        *report = cp->report;
+    }
+    pthread_cond_destroy(&cp->wake);
+    pthread_mutex_destroy(&cp->lock);
+    freeCheckpointer(cp);
+}
+
+/**
+ * @brief Check what both checkpointed solvers need of a graph and a config
+ * @param graph Graph
+ * @param config Checkpoint configuration
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NEEDS_EDGE_LIST or GRAPH_WEIGHT_TYPE
+ */
+static int checkRun(const struct Graph *graph, const struct GraphCheckpointConfig *config)
+{
+    if (!graph || !config || !config->path || !(config->interval >= 0))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (isCompressed(graph))
+    {
+        return GRAPH_NEEDS_EDGE_LIST;
+    }
+    // Snapshots hold int values
+    return graph->wideArc ? GRAPH_WEIGHT_TYPE : GRAPH_OK;
+}
+
+int graphBellmanFordCheckpointed(const struct Graph *graph, struct GraphWorkspace *workspace,
+                                 int source, const struct GraphCheckpointConfig *config,
+                                 int dist[], int parent[], struct GraphCheckpointReport *report)
+{
+    int status = checkRun(graph, config);
+    if (status != GRAPH_OK)
+    {
+        return status;
+    }
+    if (!dist || source < 0 || source >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    struct Checkpointer *cp;
+    status = beginCheckpoints(graph, config, GRAPH_SNAPSHOT_BELLMAN_FORD, source, -1, 2, &cp);
+    if (status != GRAPH_OK)
+    {
+        return status;
+    }
+
+    // Snapshots always hold parents, so a resumed run can report them
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int *slotDist = ws ? slotArray(graph, ws, dist) : NULL;
+    int *slotParent = NULL;
+    if (ws)
+    {
+        slotParent = parent ? slotArray(graph, ws, parent) : wsAlloc(ws, graph->n * sizeof(int));
+    }
+    status = GRAPH_NO_MEMORY;
+    if (slotDist && slotParent)
+    {
+        status = bellmanFordCheckpointed(graph, ws, vertexSlot(graph, source), slotDist,
+                                         slotParent, cp);
+        TRACE_INFO("bellman-ford", "done", "\"source\": %d, \"status\": \"%s\"", source,
+                   graphStatusMessage(status));
+        STAT_PHASE(ws, GRAPH_PHASE_EXPORT);
+        exportSlots(graph, slotDist, dist, false);
+        if (parent)
+        {
+            exportSlots(graph, slotParent, parent, true);
+        }
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    }
+    wsEnd(owned);
+    endCheckpoints(cp, report);
+    return status;
+}
+
+int graphMaxFlowCheckpointed(const struct Graph *graph, struct GraphWorkspace *workspace,
+                             int source, int sink, const struct GraphCheckpointConfig *config,
+                             int *flow, int edgeFlow[], struct GraphCheckpointReport *report)
+{
+    int status = checkRun(graph, config);
+    if (status != GRAPH_OK)
+    {
+        return status;
+    }
+    if (!flow || source < 0 || source >= graph->n || sink < 0 || sink >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    struct Checkpointer *cp;
+    status = beginCheckpoints(graph, config, GRAPH_SNAPSHOT_MAX_FLOW, source, sink, 1, &cp);
+    if (status != GRAPH_OK)
+    {
+        return status;
+    }
+    status = maxFlowCheckpointed(graph, workspace, source, sink, flow, edgeFlow, cp);
+    endCheckpoints(cp, report);
+    return status;
+}
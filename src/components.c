@@ -0,0 +1,515 @@
+/**
+ * @file components.c
+ * @brief Parallel connected components and spanning forest of libgraph
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * A lock-free union-find: comp[v] links every slot to a smaller slot of
+ * its set, and a set's root is its smallest slot. Two roots are joined
+ * with a compare-and-swap that hangs the larger root below the smaller
+ * one, so links only ever point downwards and no cycle can form whatever
+ * the interleaving. Finds split the path (every visited slot is linked
+ * to its grandparent), which needs no compare-and-swap either: the new
+ * link still points to an ancestor.
+ *
+ * Afforest neighbor sampling: first every vertex is joined with its
+ * first COMPONENT_SAMPLE_ROUNDS neighbors, which already puts most of a
+ * giant component into one set. The root most of COMPONENT_SAMPLES
+ * random vertices belong to is taken to be that component, and the last
+ * phase only scans the remaining arcs of vertices outside it. On an
+ * undirected graph every arc is stored at both endpoints, so an arc
+ * between the giant component and another set is still seen from the
+ * other side. A directed graph (weakly connected components) only stores
+ * arcs at their tail, so there every vertex scans its remaining arcs.
+ *
+ * Every join that succeeds hooks one root; the arc that did it is kept
+ * at that root and becomes an edge of the spanning forest.
+ *
+ * Vertex ranges are split into chunks of about the same number of
+ * vertices plus arcs and run on the shared work-stealing pool, or one
+ * after another on the calling thread when the caller asks for one.
+ *
+ * Time Complexity: O((V + E) α(V)) work, O(E / P) per thread on balanced graphs
+ * Space Complexity: O(V), plus O(V) for the forest
+ */
+
+#include <stdlib.h>
+
+#include "graph_internal.h"
+
+#define COMPONENT_SAMPLE_ROUNDS 2 // Neighbors per vertex joined before sampling
+#define COMPONENT_SAMPLES 1024    // Vertices sampled to find the giant component
+#define COMPONENT_CHUNKS 8        // Chunks per thread, so idle workers can steal
+
+/**
+ * @brief Structure to share one components run between the pool's tasks
+ */
+struct ComponentsRun
+{
+    const struct Graph *graph;
+    int *comp;       // Union-find links by slot (a root links to itself)
+    int *hookTail;   // Tail of the arc that hooked each former root (NULL = no forest)
+    int *hookHead;   // Head of that arc
+    int *hookWeight; // Weight of that arc
+    int *first;      // First slot of every chunk (chunks + 1 entries)
+    int *roots;      // Roots per chunk, then the roots before every chunk
+    int *number;     // Component of every slot (only roots are set before labeling)
+    int chunks;      // Number of chunks
+    bool serial;     // Run the chunks on the calling thread instead of the pool
+    int round;       // Neighbor joined in a sampling round
+    int largest;     // Root of the sampled giant component (-1 = scan every vertex)
+};
+
+/**
+ * @brief Find the root of a slot's set, splitting the path
+ * @param comp Union-find links
+ * @param v Slot
+ * @return Root of the set containing v
+ */
+static int findRoot(int comp[], int v)
+{
+    int parent = __atomic_load_n(&comp[v], __ATOMIC_RELAXED);
+    while (parent != v)
+    {
+        int grand = __atomic_load_n(&comp[parent], __ATOMIC_RELAXED);
+        if (grand != parent)
+        {
+            __atomic_store_n(&comp[v], grand, __ATOMIC_RELAXED);
+        }
+        v = parent;
+        parent = grand;
+    }
+    return v;
+}
+
+/**
+ * @brief Join the sets of two slots
+ * @param run Components run
+ * @param u Tail slot of the arc
+ * @param v Head slot of the arc
+ * @param weight Weight of the arc (kept for the forest)
+ */
+static void joinSets(struct ComponentsRun *run, int u, int v, int weight)
+{
+    int a = u, b = v;
+    for (;;)
+    {
+        a = findRoot(run->comp, a);
+        b = findRoot(run->comp, b);
+        if (a == b)
+        {
+            return;
+        }
+        int high = a > b ? a : b;
+        int low = a > b ? b : a;
+        int expected = high;
+        if (__atomic_compare_exchange_n(&run->comp[high], &expected, low, false, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED))
+        {
+            // high is hooked exactly once, so its arc needs no synchronization
+            if (run->hookTail)
+            {
+                run->hookTail[high] = u;
+                run->hookHead[high] = v;
+                run->hookWeight[high] = weight;
+            }
+            return;
+        }
+        // Another thread hooked high first: retry from the roots found so far
+    }
+}
+
+/**
+ * @brief Join every vertex of a chunk with its neighbor number run->round
+ * @param context struct ComponentsRun
+ * @param chunk Chunk index
+ * @return Arcs scanned
+ */
+static long long sampleChunk(void *context, int chunk)
+{
+    struct ComponentsRun *run = context;
+    const struct Graph *graph = run->graph;
+    long long scanned = 0;
+    for (int u = run->first[chunk]; u < run->first[chunk + 1]; u++)
+    {
+        if (graph->offset[u + 1] - graph->offset[u] <= run->round)
+        {
+            continue;
+        }
+        if (isCompressed(graph))
+        {
+            struct ArcCursor cursor;
+            arcsBegin(graph, u, &cursor);
+            for (int k = 0; k <= run->round; k++)
+            {
+                arcsNext(graph, &cursor, run->hookTail != NULL);
+            }
+            joinSets(run, u, cursor.target, cursor.weight);
+        }
+        else
+        {
+            int a = graph->offset[u] + run->round;
+            joinSets(run, u, graph->target[a], graph->weight[a]);
+        }
+        scanned++;
+    }
+    return scanned;
+}
+
+/**
+ * @brief Join every vertex of a chunk outside the giant component with
+ *        the neighbors sampling did not reach
+ * @param context struct ComponentsRun
+ * @param chunk Chunk index
+ * @return Arcs scanned
+ */
+static long long finishChunk(void *context, int chunk)
+{
+    struct ComponentsRun *run = context;
+    const struct Graph *graph = run->graph;
+    long long scanned = 0;
+    for (int u = run->first[chunk]; u < run->first[chunk + 1]; u++)
+    {
+        if (graph->offset[u + 1] - graph->offset[u] <= COMPONENT_SAMPLE_ROUNDS ||
+            (run->largest >= 0 && findRoot(run->comp, u) == run->largest))
+        {
+            continue;
+        }
+        if (isCompressed(graph))
+        {
+            struct ArcCursor cursor;
+            arcsBegin(graph, u, &cursor);
+            for (int k = 0; arcsNext(graph, &cursor, run->hookTail != NULL); k++)
+            {
+                if (k >= COMPONENT_SAMPLE_ROUNDS)
+                {
+                    joinSets(run, u, cursor.target, cursor.weight);
+                }
+            }
+        }
+        else
+        {
+            for (int a = graph->offset[u] + COMPONENT_SAMPLE_ROUNDS; a < graph->offset[u + 1]; a++)
+            {
+                joinSets(run, u, graph->target[a], graph->weight[a]);
+            }
+        }
+        scanned += graph->offset[u + 1] - graph->offset[u] - COMPONENT_SAMPLE_ROUNDS;
+    }
+    return scanned;
+}
+
+/**
+ * @brief Link every slot of a chunk straight to its root
+ * @param context struct ComponentsRun
+ * @param chunk Chunk index
+ * @return Roots in the chunk
+ */
+static long long compressChunk(void *context, int chunk)
+{
+    struct ComponentsRun *run = context;
+    int roots = 0;
+    for (int v = run->first[chunk]; v < run->first[chunk + 1]; v++)
+    {
+        int root = findRoot(run->comp, v);
+        __atomic_store_n(&run->comp[v], root, __ATOMIC_RELAXED);
+        roots += root == v;
+    }
+    run->roots[chunk] = roots;
+    return roots;
+}
+
+/**
+ * @brief Number the roots of a chunk in slot order
+ * @param context struct ComponentsRun (roots[] holds the roots before every chunk)
+ * @param chunk Chunk index
+ */
+static void numberRoots(void *context, int chunk)
+{
+    struct ComponentsRun *run = context;
+    int next = run->roots[chunk];
+    for (int v = run->first[chunk]; v < run->first[chunk + 1]; v++)
+    {
+        if (run->comp[v] == v)
+        {
+            run->number[v] = next++;
+        }
+    }
+}
+
+/**
+ * @brief Give every non-root slot of a chunk the number of its root
+ * @param context struct ComponentsRun
+ * @param chunk Chunk index
+ */
+static void numberMembers(void *context, int chunk)
+{
+    struct ComponentsRun *run = context;
+    for (int v = run->first[chunk]; v < run->first[chunk + 1]; v++)
+    {
+        if (run->comp[v] != v)
+        {
+            run->number[v] = run->number[run->comp[v]];
+        }
+    }
+}
+
+/**
+ * @brief Order ints ascending
+ * @param a Pointer to the first int
+ * @param b Pointer to the second int
+ * @return Negative, zero or positive as for qsort()
+ */
+static int compareInts(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Pick the root most sampled vertices belong to
+ * @param run Components run after the sampling rounds
+ * @param n Number of vertices
+ * @param sample Scratch array of COMPONENT_SAMPLES entries
+ * @return Most frequent root
+ */
+static int sampleLargest(const struct ComponentsRun *run, int n, int sample[])
+{
+    unsigned long long state = 0x9e3779b97f4a7c15ULL; // Fixed seed: runs are repeatable
+    for (int i = 0; i < COMPONENT_SAMPLES; i++)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        sample[i] = run->comp[(state >> 33) % (unsigned long long)n];
+    }
+
+    // The most frequent root is the longest run of equal sorted samples
+    qsort(sample, COMPONENT_SAMPLES, sizeof(int), compareInts);
+    int best = sample[0], bestCount = 0;
+    for (int i = 0, length = 1; i < COMPONENT_SAMPLES; i++, length++)
+    {
+        if (i + 1 == COMPONENT_SAMPLES || sample[i + 1] != sample[i])
+        {
+            if (length > bestCount)
+            {
+                best = sample[i];
+                bestCount = length;
+            }
+            length = 0;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Split the slots into chunks of about equal vertices plus arcs
+ * @param graph Graph
+ * @param chunks Number of chunks
+ * @param first Output: first slot of every chunk (chunks + 1 entries)
+ */
+static void splitChunks(const struct Graph *graph, int chunks, int first[])
+{
+    int n = graph->n;
+    long long total = (long long)n + graph->arcCount;
+    first[0] = 0;
+    for (int k = 1; k < chunks; k++)
+    {
+        // Smallest slot u with u + offset[u] >= the chunk's share (increasing in u)
+        long long want = total * k / chunks;
+        int low = first[k - 1], high = n;
+        while (low < high)
+        {
+            int mid = low + (high - low) / 2;
+            if (mid + (long long)graph->offset[mid] < want)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        first[k] = low;
+    }
+    first[chunks] = n;
+}
+
+/**
+ * @brief Run a loop body for every chunk of a run
+ * @param run Components run
+ * @param body Loop body
+ */
+static void forChunks(struct ComponentsRun *run, PoolChunkFn body)
+{
+    if (!run->serial)
+    {
+        poolFor(run->chunks, body, run);
+        return;
+    }
+    for (int k = 0; k < run->chunks; k++)
+    {
+        body(run, k);
+    }
+}
+
+/**
+ * @brief Sum a loop body over every chunk of a run
+ * @param run Components run
+ * @param body Loop body
+ * @return Sum of the values of all chunks
+ */
+static long long sumChunks(struct ComponentsRun *run, PoolSumFn body)
+{
+    if (!run->serial)
+    {
+        return poolSum(run->chunks, body, run);
+    }
+    long long total = 0;
+    for (int k = 0; k < run->chunks; k++)
+    {
+        total += body(run, k);
+    }
+    return total;
+}
+
+int graphConnectedComponentsWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                               int threads, int label[], int size[], int *components,
+                               struct GraphEdge forest[], int *forestEdges)
+{
+    if (!graph || !components || threads < 0 || (forest && !forestEdges))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    int n = graph->n;
+    int chunks = (threads > 0 ? threads : poolThreads()) * COMPONENT_CHUNKS;
+    chunks = chunks < n ? chunks : n > 0 ? n : 1;
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    struct ComponentsRun run = {graph, NULL, NULL, NULL, NULL, NULL, NULL, NULL, chunks,
+                                threads == 1, 0, -1};
+    if (ws)
+    {
+        run.comp = wsAlloc(ws, n * sizeof(int));
+        run.number = wsAlloc(ws, n * sizeof(int));
+        run.first = wsAlloc(ws, (chunks + 1) * sizeof(int));
+        run.roots = wsAlloc(ws, (chunks + 1) * sizeof(int));
+    }
+    if (ws && forest)
+    {
+        run.hookTail = wsAlloc(ws, n * sizeof(int));
+        run.hookHead = wsAlloc(ws, n * sizeof(int));
+        run.hookWeight = wsAlloc(ws, n * sizeof(int));
+    }
+    int *sample = ws ? wsAlloc(ws, COMPONENT_SAMPLES * sizeof(int)) : NULL;
+    if (!run.comp || !run.number || !run.first || !run.roots || !sample ||
+        (forest && (!run.hookTail || !run.hookHead || !run.hookWeight)))
+    {
+        wsEnd(owned);
+        return GRAPH_NO_MEMORY;
+    }
+
+    STAT_PHASE(ws, GRAPH_PHASE_SEARCH);
+    splitChunks(graph, chunks, run.first);
+    for (int v = 0; v < n; v++)
+    {
+        run.comp[v] = v;
+    }
+
+    // Afforest: join a few neighbors per vertex, then find the giant component
+    long long scanned = 0;
+    for (run.round = 0; run.round < COMPONENT_SAMPLE_ROUNDS; run.round++)
+    {
+        scanned += sumChunks(&run, sampleChunk);
+        sumChunks(&run, compressChunk);
+    }
+    if (!graph->directed && n > 0)
+    {
+        run.largest = sampleLargest(&run, n, sample);
+    }
+    scanned += sumChunks(&run, finishChunk);
+    int count = (int)sumChunks(&run, compressChunk);
+    STAT_ADD(&ws->stats, edgesScanned, scanned);
+    STAT_ADD(&ws->stats, unionCalls, n - count);
+    STAT_ADD(&ws->stats, passes, COMPONENT_SAMPLE_ROUNDS + 1);
+    TRACE_INFO("components", "done", "\"components\": %d, \"arcs_scanned\": %lld", count,
+               scanned);
+
+    // Roots are numbered in slot order: turn per-chunk counts into offsets
+    STAT_PHASE(ws, GRAPH_PHASE_EXPORT);
+    for (int k = 0, before = 0; k <= chunks; k++)
+    {
+        int roots = k < chunks ? run.roots[k] : 0;
+        run.roots[k] = before;
+        before += roots;
+    }
+    forChunks(&run, numberRoots);
+    forChunks(&run, numberMembers);
+
+    // A reordered graph's smallest slot is not its smallest vertex: renumber
+    int *renumber = NULL;
+    if (graph->vertexAt)
+    {
+        renumber = wsAlloc(ws, count * sizeof(int) + 1);
+        if (!renumber)
+        {
+            wsEnd(owned);
+            return GRAPH_NO_MEMORY;
+        }
+        for (int c = 0; c < count; c++)
+        {
+            renumber[c] = -1;
+        }
+        for (int v = 0, next = 0; v < n; v++)
+        {
+            int c = run.number[graph->position[v]];
+            if (renumber[c] < 0)
+            {
+                renumber[c] = next++;
+            }
+        }
+    }
+
+    for (int v = 0; label && v < n; v++)
+    {
+        int c = run.number[vertexSlot(graph, v)];
+        label[v] = renumber ? renumber[c] : c;
+    }
+    for (int c = 0; size && c < count; c++)
+    {
+        size[c] = 0;
+    }
+    for (int p = 0; size && p < n; p++)
+    {
+        int c = run.number[p];
+        size[renumber ? renumber[c] : c]++;
+    }
+
+    // Every slot but the roots was hooked once: its arc is a forest edge
+    if (forest)
+    {
+        int edges = 0;
+        for (int p = 0; p < n; p++)
+        {
+            if (run.comp[p] != p)
+            {
+                forest[edges].u = slotVertex(graph, run.hookTail[p]);
+                forest[edges].v = slotVertex(graph, run.hookHead[p]);
+                forest[edges].weight = run.hookWeight[p];
+                edges++;
+            }
+        }
+        *forestEdges = edges;
+    }
+    STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+
+    *components = count;
+    wsEnd(owned);
+    return GRAPH_OK;
+}
+
+int graphConnectedComponents(const struct Graph *graph, int threads, int label[], int size[],
+                             int *components, struct GraphEdge forest[], int *forestEdges)
+{
+    return graphConnectedComponentsWs(graph, NULL, threads, label, size, components, forest,
+                                      forestEdges);
+}
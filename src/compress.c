@@ -0,0 +1,327 @@
+/**
+ * @file compress.c
+ * @brief Compressed copies of graphs: varint adjacency lists and bit matrices
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Sorting the heads of every vertex turns them into small gaps, and a
+ * gap below 128 costs one byte instead of four. Weights are stored in
+ * the narrowest width that holds their range, after subtracting the
+ * smallest weight; narrow widths that cannot hold the range divide it by
+ * a step and round (down where rounding up would pass INT_MAX).
+ * Unweighted graphs dense enough that n² bits beat the lists are stored
+ * as a bit matrix. The edge list, edgeOf[] and the CSR target and weight
+ * arrays are not kept, which is where most of the memory of a struct
+ * Graph goes.
+ *
+ * Time Complexity: O(V + E log Δ) to compress lists, O(V² / 64 + E) for
+ *                  a matrix (Δ = largest degree)
+ * Space Complexity: O(V + packed bytes), or O(V² / 64) for a matrix
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "graph_internal.h"
+
+#define MAX_VARINT_BYTES 5 // Longest LEB128 encoding of a 32-bit value
+
+/**
+ * @brief Structure to sort the arcs of one vertex
+ */
+struct PackedArc
+{
+    int target; // Head slot
+    int weight; // Weight
+};
+
+/**
+ * @brief Compare two arcs by head, then weight, for qsort()
+ * @param a First arc
+ * @param b Second arc
+ * @return Negative, zero or positive
+ */
+static int compareArcs(const void *a, const void *b)
+{
+    const struct PackedArc *x = a;
+    const struct PackedArc *y = b;
+    if (x->target != y->target)
+    {
+        return x->target < y->target ? -1 : 1;
+    }
+    return (x->weight > y->weight) - (x->weight < y->weight);
+}
+
+/**
+ * @brief Append one LEB128 varint
+ * @param out Write position
+ * @param value Value to encode
+ * @return Write position after the varint
+ */
+static unsigned char *writeVarint(unsigned char *out, unsigned value)
+{
+    while (value >= 0x80)
+    {
+        *out++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (unsigned char)value;
+    return out;
+}
+
+/**
+ * @brief Choose the weight code width and step of a compressed graph
+ * @param range Largest weight minus smallest weight
+ * @param maxBytes Widest code allowed (1, 2 or 4)
+ * @param step Output: weight of one code unit
+ * @return Bytes per weight code (0 if all weights are equal)
+ */
+static int weightWidth(long long range, int maxBytes, int *step)
+{
+    int bytes = range == 0 ? 0 : range <= 0xff ? 1 : range <= 0xffff ? 2 : 4;
+    if (bytes > maxBytes)
+    {
+        bytes = maxBytes;
+    }
+
+    long long maxCode = bytes == 4 ? 0xffffffffLL : (1LL << (8 * bytes)) - 1;
+    *step = bytes == 0 || range <= maxCode ? 1 : (int)((range + maxCode - 1) / maxCode);
+    return bytes;
+}
+
+/**
+ * @brief Encode the arcs of a graph as sorted varint gap lists
+ * @param graph Uncompressed graph
+ * @param out Compressed graph with offset[] and the weight fields set;
+ *            packed, packedBytes and packedOffset are filled in
+ * @return false if memory ran out
+ */
+static bool packLists(const struct Graph *graph, struct Graph *out)
+{
+    int n = graph->n;
+    int maxDegree = 0;
+    for (int u = 0; u < n; u++)
+    {
+        int degree = graph->offset[u + 1] - graph->offset[u];
+        maxDegree = degree > maxDegree ? degree : maxDegree;
+    }
+
+    // Start with room for one-byte gaps and grow while encoding
+    size_t capacity = (size_t)graph->arcCount * (1 + out->weightBytes) + 64;
+    struct PackedArc *arcs = malloc(maxDegree * sizeof(struct PackedArc) + 1);
+    out->packedOffset = malloc((n + 1) * sizeof(size_t));
+    out->packed = malloc(capacity);
+    if (!arcs || !out->packedOffset || !out->packed)
+    {
+        free(arcs);
+        return false;
+    }
+
+    // Codes round to the nearest step, but never past INT_MAX once decoded
+    long long topCode = ((long long)INT_MAX - out->weightBase) / out->weightStep;
+
+    size_t used = 0;
+    for (int u = 0; u < n; u++)
+    {
+        int degree = 0;
+        for (int a = graph->offset[u]; a < graph->offset[u + 1]; a++)
+        {
+            arcs[degree].target = graph->target[a];
+            arcs[degree].weight = graph->weight[a];
+            degree++;
+        }
+        qsort(arcs, degree, sizeof(struct PackedArc), compareArcs);
+
+        size_t worst = (size_t)degree * (MAX_VARINT_BYTES + out->weightBytes);
+        if (used + worst > capacity)
+        {
+            size_t grown = capacity * 2 > used + worst ? capacity * 2 : used + worst;
+            unsigned char *bigger = realloc(out->packed, grown);
+            if (!bigger)
+            {
+                free(arcs);
+                return false;
+            }
+            out->packed = bigger;
+            capacity = grown;
+        }
+
+        out->packedOffset[u] = used;
+        unsigned char *p = out->packed + used;
+        int previous = u;
+        for (int k = 0; k < degree; k++)
+        {
+            int delta = arcs[k].target - previous;
+            p = writeVarint(p, k == 0 ? ((unsigned)delta << 1) ^ (unsigned)(delta >> 31)
+                                      : (unsigned)delta);
+            previous = arcs[k].target;
+
+            long long offset = (long long)arcs[k].weight - out->weightBase;
+            long long rounded = (offset + out->weightStep / 2) / out->weightStep;
+            unsigned code = (unsigned)(rounded < topCode ? rounded : topCode);
+            for (int b = 0; b < out->weightBytes; b++)
+            {
+                *p++ = (unsigned char)(code >> (8 * b));
+            }
+        }
+        used = p - out->packed;
+    }
+    out->packedOffset[n] = used;
+    free(arcs);
+
+    // Give back the slack of the last growth
+    unsigned char *fitted = realloc(out->packed, used + 1);
+    if (fitted)
+    {
+        out->packed = fitted;
+    }
+    out->packedBytes = used + 1;
+    return true;
+}
+
+/**
+ * @brief Store the arcs of an unweighted graph as a bit matrix
+ *
+ * Parallel arcs share one bit, so offset[] is recounted.
+ *
+ * @param graph Uncompressed graph
+ * @param out Compressed graph with offset[] allocated; matrix and
+ *            rowWords are filled in
+ * @return false if memory ran out
+ */
+static bool packMatrix(const struct Graph *graph, struct Graph *out)
+{
+    int n = graph->n;
+    out->rowWords = (n + 63) / 64;
+    out->matrix = calloc((size_t)n * out->rowWords + 1, sizeof(unsigned long long));
+    if (!out->matrix)
+    {
+        return false;
+    }
+
+    out->offset[0] = 0;
+    for (int u = 0; u < n; u++)
+    {
+        unsigned long long *row = out->matrix + (size_t)u * out->rowWords;
+        for (int a = graph->offset[u]; a < graph->offset[u + 1]; a++)
+        {
+            row[graph->target[a] >> 6] |= 1ULL << (graph->target[a] & 63);
+        }
+        int degree = 0;
+        for (int w = 0; w < out->rowWords; w++)
+        {
+            degree += __builtin_popcountll(row[w]);
+        }
+        out->offset[u + 1] = out->offset[u] + degree;
+    }
+    out->arcCount = out->offset[n];
+    return true;
+}
+
+/**
+ * @brief Compute the size of a graph's arcs as packed lists
+ * @param graph Compressed graph with packedBytes set
+ * @return Bytes of the lists and their offsets
+ */
+static size_t listBytes(const struct Graph *graph)
+{
+    return graph->packedBytes + (graph->n + 1) * sizeof(size_t);
+}
+
+int graphCompress(const struct Graph *graph, int compression, struct Graph **compressed)
+{
+    if (!graph || !compressed || compression < GRAPH_COMPRESS_EXACT ||
+        compression > GRAPH_COMPRESS_MATRIX)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (isCompressed(graph))
+    {
+        return GRAPH_NEEDS_EDGE_LIST;
+    }
+    if (graph->wideArc)
+    {
+        return GRAPH_WEIGHT_TYPE; // Packed codes are int
+    }
+
+    int n = graph->n;
+    int maxWeight = graph->minWeight;
+    for (int a = 0; a < graph->arcCount; a++)
+    {
+        maxWeight = graph->weight[a] > maxWeight ? graph->weight[a] : maxWeight;
+    }
+    long long range = (long long)maxWeight - graph->minWeight;
+    if (compression == GRAPH_COMPRESS_MATRIX && range != 0)
+    {
+        return GRAPH_INVALID_ARGUMENT; // A bit carries no weight
+    }
+
+    struct Graph *g = calloc(1, sizeof(struct Graph));
+    if (!g)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    g->n = n;
+    g->edgeCount = graph->edgeCount;
+    g->arcCount = graph->arcCount;
+    g->directed = graph->directed;
+    g->minWeight = graph->minWeight;
+    g->weightType = graph->weightType;
+    g->serial = newGraphSerial();
+    g->weightBase = graph->minWeight;
+    g->weightBytes = weightWidth(range,
+                                 compression == GRAPH_COMPRESS_WEIGHT8    ? 1
+                                 : compression == GRAPH_COMPRESS_WEIGHT16 ? 2
+                                                                          : 4,
+                                 &g->weightStep);
+    g->offset = graphAllocLarge((n + 1) * sizeof(int));
+    bool ok = g->offset != NULL;
+    if (ok)
+    {
+        memcpy(g->offset, graph->offset, (n + 1) * sizeof(int));
+    }
+    if (ok && graph->vertexAt)
+    {
+        g->position = malloc(n * sizeof(int) + 1);
+        g->vertexAt = malloc(n * sizeof(int) + 1);
+        ok = g->position && g->vertexAt;
+        if (ok)
+        {
+            memcpy(g->position, graph->position, n * sizeof(int));
+            memcpy(g->vertexAt, graph->vertexAt, n * sizeof(int));
+        }
+    }
+
+    if (ok && compression != GRAPH_COMPRESS_MATRIX)
+    {
+        ok = packLists(graph, g);
+    }
+
+    // Lossless compression of an unweighted graph takes the matrix if it is smaller
+    size_t matrixBytes = (size_t)n * ((n + 63) / 64) * sizeof(unsigned long long);
+    bool useMatrix = compression == GRAPH_COMPRESS_MATRIX ||
+                     (compression == GRAPH_COMPRESS_EXACT && range == 0 &&
+                      matrixBytes < listBytes(g));
+    if (ok && useMatrix)
+    {
+        free(g->packed);
+        free(g->packedOffset);
+        g->packed = NULL;
+        g->packedOffset = NULL;
+        g->packedBytes = 0;
+        g->weightBytes = 0;
+        ok = packMatrix(graph, g);
+    }
+
+    if (!ok)
+    {
+        graphFree(g);
+        return GRAPH_NO_MEMORY;
+    }
+
+    // Rounded weights can sum past int where the originals did not
+    markWideSums(g);
+    *compressed = g;
+    return GRAPH_OK;
+}
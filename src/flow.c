@@ -0,0 +1,1319 @@
+/**
+ * @file flow.c
+ * @brief Implementation of libgraph's maximum flow engines
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Edmonds-Karp on a mate-arc residual graph whose shortest augmenting
+ * paths come from the direction-optimizing BFS engine, with warm
+ * restarts after capacity changes, min-cut extraction, Gusfield's
+ * Gomory-Hu construction and a Hopcroft-Karp path for bipartite
+ * matching networks.
+ *
+ * Time Complexity: O(VE²) for Edmonds-Karp, O(E√V) for Hopcroft-Karp
+ * Space Complexity: O(V + E)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "flow.h"
+#include "bfs.h"
+#include "graph_internal.h"
+
+struct FlowNetwork *createFlowNetworkFromEdges(int n, int edgeCount, const struct GraphEdge edges[],
+                                               bool directed, int edgeArc[])
+{
+    struct FlowNetwork *net = calloc(1, sizeof(struct FlowNetwork));
+    int *bucket = malloc((n + 1) * sizeof(int));      // Edges grouped by smaller endpoint
+    int *order = malloc(edgeCount * sizeof(int) + 1); // Edge indices in bucket order
+    if (net)
+    {
+        net->n = n;
+        net->firstArc = malloc((n + 1) * sizeof(int));
+        net->parentArc = malloc(n * sizeof(int) + 1);
+        net->queue = malloc(n * sizeof(int) + 1);
+        net->seen = calloc(n + 1, sizeof(unsigned));
+        net->excess = malloc(n * sizeof(int) + 1);
+        net->bfs = createBfsEngine(n, 1);
+    }
+    if (!net || !bucket || !order || !net->firstArc || !net->parentArc || !net->queue ||
+        !net->seen || !net->excess || !net->bfs)
+    {
+        free(bucket);
+        free(order);
+        freeFlowNetwork(net);
+        return NULL;
+    }
+
+    // Group the edges by their smaller endpoint (counting sort)
+    for (int v = 0; v <= n; v++)
+    {
+        bucket[v] = 0;
+    }
+    for (int i = 0; i < edgeCount; i++)
+    {
+        int low = edges[i].u < edges[i].v ? edges[i].u : edges[i].v;
+        bucket[low + 1]++;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        bucket[v + 1] += bucket[v];
+    }
+    for (int i = 0; i < edgeCount; i++)
+    {
+        int low = edges[i].u < edges[i].v ? edges[i].u : edges[i].v;
+        order[bucket[low]++] = i;
+    }
+    for (int v = n; v > 0; v--)
+    {
+        bucket[v] = bucket[v - 1];
+    }
+    bucket[0] = 0;
+
+    // Count arc pairs per vertex. Until the first solve the scratch arrays
+    // are free: excess[v] is the last low vertex that met v, parentArc[v]
+    // its arc low → v and queue[u] the fill cursor of u.
+    for (int v = 0; v < n; v++)
+    {
+        net->firstArc[v] = 0;
+        net->excess[v] = -1;
+    }
+    net->firstArc[n] = 0;
+    for (int low = 0; low < n; low++)
+    {
+        for (int k = bucket[low]; k < bucket[low + 1]; k++)
+        {
+            int high = edges[order[k]].u + edges[order[k]].v - low;
+            if (high != low && net->excess[high] != low)
+            {
+                net->excess[high] = low;
+                net->firstArc[low + 1]++;
+                net->firstArc[high + 1]++;
+            }
+        }
+    }
+    for (int u = 0; u < n; u++)
+    {
+        net->firstArc[u + 1] += net->firstArc[u];
+    }
+
+    net->arcCount = net->firstArc[n];
+    net->head = graphAllocLarge(net->arcCount * sizeof(int) + 1);
+    net->mate = graphAllocLarge(net->arcCount * sizeof(int) + 1);
+    net->capacity = graphAllocLarge(net->arcCount * sizeof(int) + 1);
+    net->residual = graphAllocLarge(net->arcCount * sizeof(int) + 1);
+    if (!net->head || !net->mate || !net->capacity || !net->residual)
+    {
+        free(bucket);
+        free(order);
+        freeFlowNetwork(net);
+        return NULL;
+    }
+
+    // Create the pairs in the same order and add up the capacities
+    memcpy(net->queue, net->firstArc, n * sizeof(int));
+    for (int v = 0; v < n; v++)
+    {
+        net->excess[v] = -1;
+    }
+    for (int low = 0; low < n; low++)
+    {
+        for (int k = bucket[low]; k < bucket[low + 1]; k++)
+        {
+            int i = order[k];
+            int high = edges[i].u + edges[i].v - low;
+            if (high == low)
+            {
+                if (edgeArc)
+                {
+                    edgeArc[i] = -1; // Self-loops carry no flow
+                }
+                continue;
+            }
+
+            if (net->excess[high] != low)
+            {
+                int a = net->queue[low]++;
+                int b = net->queue[high]++;
+                net->head[a] = high;
+                net->head[b] = low;
+                net->mate[a] = b;
+                net->mate[b] = a;
+                net->capacity[a] = 0;
+                net->capacity[b] = 0;
+                net->excess[high] = low;
+                net->parentArc[high] = a;
+            }
+
+            int arc = edges[i].u == low ? net->parentArc[high] : net->mate[net->parentArc[high]];
+            net->capacity[arc] += edges[i].weight;
+            if (!directed)
+            {
+                net->capacity[net->mate[arc]] += edges[i].weight;
+            }
+            if (edgeArc)
+            {
+                edgeArc[i] = arc;
+            }
+        }
+    }
+    free(bucket);
+    free(order);
+
+    memcpy(net->residual, net->capacity, net->arcCount * sizeof(int));
+    memset(net->excess, 0, n * sizeof(int));
+    net->source = -1;
+    net->sink = -1;
+    net->flow = 0;
+    net->augmentations = 0;
+    return net;
+}
+
+struct FlowNetwork *createFlowNetwork(int n, int graph[n][n])
+{
+    // List both directions of every pair together, pairs in row order, so
+    // the arcs of every vertex come out sorted by head
+    int edgeCount = 0;
+    for (int u = 0; u < n; u++)
+    {
+        for (int v = 0; v < n; v++)
+        {
+            edgeCount += u != v && graph[u][v] > 0;
+        }
+    }
+
+    struct GraphEdge *edges = malloc(edgeCount * sizeof(struct GraphEdge) + 1);
+    if (!edges)
+    {
+        return NULL;
+    }
+
+    int i = 0;
+    for (int u = 0; u < n; u++)
+    {
+        for (int v = u + 1; v < n; v++)
+        {
+            if (graph[u][v] > 0)
+            {
+                edges[i++] = (struct GraphEdge){u, v, graph[u][v]};
+            }
+            if (graph[v][u] > 0)
+            {
+                edges[i++] = (struct GraphEdge){v, u, graph[v][u]};
+            }
+        }
+    }
+
+    struct FlowNetwork *net = createFlowNetworkFromEdges(n, edgeCount, edges, true, NULL);
+    free(edges);
+    return net;
+}
+
+void freeFlowNetwork(struct FlowNetwork *net)
+{
+    if (!net)
+    {
+        return;
+    }
+    free(net->firstArc);
+    graphFreeLarge(net->head);
+    graphFreeLarge(net->mate);
+    graphFreeLarge(net->capacity);
+    graphFreeLarge(net->residual);
+    free(net->parentArc);
+    free(net->queue);
+    free(net->seen);
+    free(net->excess);
+    if (net->bfs)
+    {
+        freeBfsEngine(net->bfs);
+    }
+    free(net);
+}
+
+int findArc(const struct FlowNetwork *net, int u, int v)
+{
+    for (int a = net->firstArc[u]; a < net->firstArc[u + 1]; a++)
+    {
+        if (net->head[a] == v)
+        {
+            return a;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Vertices that end a residualBfs() search
+ */
+enum SearchGoal
+{
+    GOAL_NONE,     // Search everything reachable
+    GOAL_TERMINAL, // The source or the sink
+    GOAL_DEFICIT   // A terminal or a vertex with negative excess
+};
+
+/**
+ * @brief BFS over arcs with residual capacity until a goal vertex is met
+ *
+ * A forward search follows arcs start → v. A backward search follows
+ * arcs v → start, so the path it finds ends at start instead of
+ * beginning there. In both cases parentArc[v] is the path arc at v.
+ * Reached vertices are stamped in seen[], so a search costs only what
+ * it visits.
+ *
+ * @param net Flow network
+ * @param start Vertex to search from
+ * @param backward true to search against the arc direction
+ * @param goal enum SearchGoal
+ * @return The goal vertex reached, or -1 if none is reachable
+ */
+static int residualBfs(struct FlowNetwork *net, int start, bool backward, int goal)
+{
+    int front = 0, rear = 0;
+
+    // The O(n) clear only happens once every 2^32 searches
+    if (++net->epoch == 0)
+    {
+        memset(net->seen, 0, net->n * sizeof(unsigned));
+        net->epoch = 1;
+    }
+    net->seen[start] = net->epoch;
+    net->queue[rear++] = start;
+
+    while (front < rear)
+    {
+        int u = net->queue[front++];
+
+        for (int a = net->firstArc[u]; a < net->firstArc[u + 1]; a++)
+        {
+            int v = net->head[a];
+            int arc = backward ? net->mate[a] : a; // Arc actually traversed
+            if (net->seen[v] != net->epoch && net->residual[arc] > 0)
+            {
+                net->seen[v] = net->epoch;
+                net->parentArc[v] = arc;
+                if (goal != GOAL_NONE &&
+                    (v == net->source || v == net->sink ||
+                     (goal == GOAL_DEFICIT && net->excess[v] < 0)))
+                {
+                    return v;
+                }
+                net->queue[rear++] = v;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Push flow along the path found by the last residualBfs() call
+ * @param net Flow network
+ * @param start Vertex the search started from
+ * @param end Goal vertex the search returned
+ * @param backward Direction of the search
+ * @param limit Upper bound on the amount to push
+ * @return Amount of flow pushed
+ */
+static int pushPath(struct FlowNetwork *net, int start, int end, bool backward, int limit)
+{
+    int amount = limit;
+
+    // Find bottleneck capacity
+    for (int v = end; v != start;)
+    {
+        int a = net->parentArc[v];
+        if (net->residual[a] < amount)
+        {
+            amount = net->residual[a];
+        }
+        v = backward ? net->head[a] : net->head[net->mate[a]];
+    }
+
+    // Update residual capacities of the arcs and their mates
+    for (int v = end; v != start;)
+    {
+        int a = net->parentArc[v];
+        net->residual[a] -= amount;
+        net->residual[net->mate[a]] += amount;
+        v = backward ? net->head[a] : net->head[net->mate[a]];
+    }
+
+    net->augmentations++;
+    TRACE_DEBUG("maxflow", "augment", "\"path\": %d, \"amount\": %d", net->augmentations, amount);
+    return amount;
+}
+
+/**
+ * @brief Recompute the flow value as the net outflow of the source
+ * @param net Flow network
+ */
+static void recomputeFlowValue(struct FlowNetwork *net)
+{
+    int s = net->source;
+    net->flow = 0;
+    for (int a = net->firstArc[s]; a < net->firstArc[s + 1]; a++)
+    {
+        net->flow += net->capacity[a] - net->residual[a];
+    }
+}
+
+/**
+ * @brief Augment along shortest paths until the stored flow is maximum
+ *
+ * Paths are found by the direction-optimizing BFS engine on the residual
+ * arcs: an arc is usable while its residual capacity is positive, and
+ * the in-arcs of v are the mates of its out-arcs.
+ *
+ * @param net Flow network
+ * @param checkpoint Receives the residual capacities now and then (may be NULL)
+ */
+static void augmentToMaximum(struct FlowNetwork *net, struct Checkpointer *checkpoint)
+{
+    struct BfsGraph residualGraph = {net->n, net->firstArc, net->head, net->firstArc,
+                                     net->head, net->mate, net->residual, NULL};
+
+    while (true)
+    {
+        bfsSearch(net->bfs, &residualGraph, net->source, net->sink, NULL, NULL, net->parentArc);
+        if (net->parentArc[net->sink] == -1)
+        {
+            break;
+        }
+        net->flow += pushPath(net, net->source, net->sink, false, GRAPH_INF);
+        if (checkpoint && checkpointDue(checkpoint))
+        {
+            checkpointSave(checkpoint, net->flow, net->arcCount, net->residual, NULL);
+        }
+    }
+}
+
+/**
+ * @brief Solve for a maximum flow, continuing from the stored flow if the
+ *        terminals are unchanged
+ * @param net Flow network
+ * @param s Source vertex
+ * @param t Sink vertex
+ * @param checkpoint Receives the residual capacities now and then (may be NULL)
+ * @return Maximum flow value
+ */
+static int solveMaxFlowCheckpointed(struct FlowNetwork *net, int s, int t,
+                                    struct Checkpointer *checkpoint)
+{
+    if (s != net->source || t != net->sink)
+    {
+        memcpy(net->residual, net->capacity, net->arcCount * sizeof(int));
+        net->source = s;
+        net->sink = t;
+        net->flow = 0;
+    }
+
+    net->augmentations = 0;
+    augmentToMaximum(net, checkpoint);
+    return net->flow;
+}
+
+int solveMaxFlow(struct FlowNetwork *net, int s, int t)
+{
+    return solveMaxFlowCheckpointed(net, s, t, NULL);
+}
+
+bool updateCapacities(struct FlowNetwork *net, const struct CapacityChange changes[], int count)
+{
+    int n = net->n;
+
+    // Validate the whole batch before touching the stored flow
+    for (int i = 0; i < count; i++)
+    {
+        const struct CapacityChange *c = &changes[i];
+        if (c->u < 0 || c->u >= n || c->v < 0 || c->v >= n ||
+            c->capacity < 0 || findArc(net, c->u, c->v) == -1)
+        {
+            return false;
+        }
+    }
+
+    if (net->source < 0)
+    {
+        // Nothing solved yet: just store the new capacities
+        for (int i = 0; i < count; i++)
+        {
+            int a = findArc(net, changes[i].u, changes[i].v);
+            net->capacity[a] = changes[i].capacity;
+            net->residual[a] = changes[i].capacity;
+        }
+        return true;
+    }
+
+    int s = net->source, t = net->sink;
+    net->augmentations = 0;
+
+    // Step 1: Apply changes, cutting back flow on arcs that became infeasible
+    for (int i = 0; i < count; i++)
+    {
+        int a = findArc(net, changes[i].u, changes[i].v);
+        int flow = net->capacity[a] - net->residual[a];
+        net->capacity[a] = changes[i].capacity;
+        net->residual[a] = changes[i].capacity - flow;
+
+        if (net->residual[a] < 0)
+        {
+            int cut = -net->residual[a];
+            net->residual[a] = 0;
+            net->residual[net->mate[a]] -= cut;
+            net->excess[changes[i].u] += cut;
+            net->excess[changes[i].v] -= cut;
+        }
+    }
+
+    // Only endpoints of changed edges can hold an excess or a deficit, so
+    // steps 2 and 3 walk the changes instead of the vertices.
+    // Step 2: Push every excess to a deficit, the sink or back to the source
+    for (int i = 0; i < 2 * count; i++)
+    {
+        int x = i % 2 ? changes[i / 2].v : changes[i / 2].u;
+        while (x != s && x != t && net->excess[x] > 0)
+        {
+            int end = residualBfs(net, x, false, GOAL_DEFICIT);
+            if (end == -1)
+            {
+                break;
+            }
+            int limit = net->excess[x];
+            if (end != s && end != t && -net->excess[end] < limit)
+            {
+                limit = -net->excess[end];
+            }
+            int pushed = pushPath(net, x, end, false, limit);
+            net->excess[x] -= pushed;
+            if (end != s && end != t)
+            {
+                net->excess[end] += pushed;
+            }
+        }
+    }
+
+    // Step 3: Refill every remaining deficit from the source or the sink
+    for (int i = 0; i < 2 * count; i++)
+    {
+        int y = i % 2 ? changes[i / 2].v : changes[i / 2].u;
+        while (y != s && y != t && net->excess[y] < 0)
+        {
+            int end = residualBfs(net, y, true, GOAL_TERMINAL);
+            if (end == -1)
+            {
+                break;
+            }
+            net->excess[y] += pushPath(net, y, end, true, -net->excess[y]);
+        }
+    }
+    for (int i = 0; i < count; i++)
+    {
+        net->excess[changes[i].u] = 0;
+        net->excess[changes[i].v] = 0;
+    }
+
+    // Step 4: Continue augmenting from the repaired flow
+    recomputeFlowValue(net);
+    augmentToMaximum(net, NULL);
+    return true;
+}
+
+int minCut(struct FlowNetwork *net, bool sourceSide[], struct CutEdge cutEdges[])
+{
+    // Search the residual graph without any goal vertex
+    residualBfs(net, net->source, false, GOAL_NONE);
+
+    for (int v = 0; v < net->n; v++)
+    {
+        sourceSide[v] = net->seen[v] == net->epoch;
+    }
+
+    int count = 0;
+    for (int u = 0; u < net->n; u++)
+    {
+        if (!sourceSide[u])
+        {
+            continue;
+        }
+        for (int a = net->firstArc[u]; a < net->firstArc[u + 1]; a++)
+        {
+            int v = net->head[a];
+            if (!sourceSide[v] && net->capacity[a] > 0)
+            {
+                if (cutEdges)
+                {
+                    cutEdges[count].u = u;
+                    cutEdges[count].v = v;
+                    cutEdges[count].capacity = net->capacity[a];
+                }
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Structure to hold one max-flow run of the Gomory-Hu builder
+ */
+struct GomoryHuTask
+{
+    struct FlowNetwork *net; // Network owned by the task slot
+    int s;                   // Vertex whose tree edge is being computed
+    int t;                   // parent[s] at the time the task started
+    int value;               // Min cut value between s and t
+    bool *side;              // Source side of the min cut
+};
+
+/**
+ * @brief Solve one s-t min cut of a Gomory-Hu window (pool task)
+ * @param context Task array of the window
+ * @param k Index of the task
+ */
+static void gomoryHuChunk(void *context, int k)
+{
+    struct GomoryHuTask *task = (struct GomoryHuTask *)context + k;
+    task->value = solveMaxFlow(task->net, task->s, task->t);
+    minCut(task->net, task->side, NULL);
+}
+
+/**
+ * @brief Free the networks and cut buffers of the Gomory-Hu tasks
+ * @param tasks Task array (entries may be partly allocated)
+ * @param threads Number of tasks
+ */
+static void releaseGomoryHuTasks(struct GomoryHuTask tasks[], int threads)
+{
+    for (int k = 0; k < threads; k++)
+    {
+        freeFlowNetwork(tasks[k].net);
+        free(tasks[k].side);
+    }
+    free(tasks);
+}
+
+struct GomoryHuTree *buildGomoryHuTree(int n, int graph[n][n], int threads)
+{
+    for (int u = 0; u < n; u++)
+    {
+        for (int v = u + 1; v < n; v++)
+        {
+            if (graph[u][v] != graph[v][u])
+            {
+                return NULL;
+            }
+        }
+    }
+
+    if (threads <= 0)
+    {
+        threads = poolThreads();
+    }
+    if (threads > n - 1)
+    {
+        threads = n > 1 ? n - 1 : 1;
+    }
+
+    struct GomoryHuTree *tree = calloc(1, sizeof(struct GomoryHuTree));
+    struct GomoryHuTask *tasks = calloc(threads, sizeof(struct GomoryHuTask));
+    if (!tree || !tasks)
+    {
+        free(tree);
+        free(tasks);
+        return NULL;
+    }
+    tree->n = n;
+    tree->parent = malloc(n * sizeof(int) + 1);
+    tree->weight = malloc(n * sizeof(int) + 1);
+    tree->depth = malloc(n * sizeof(int) + 1);
+    tree->flowCalls = 0;
+
+    // An empty graph has an empty tree: no root to write and no network to build
+    bool ready = tree->parent && tree->weight && tree->depth;
+    if (ready && n == 0)
+    {
+        free(tasks);
+        return tree;
+    }
+
+    // Every task slot keeps its own network and cut buffer for the whole build
+    for (int k = 0; k < threads && ready; k++)
+    {
+        tasks[k].net = createFlowNetwork(n, graph);
+        tasks[k].side = malloc(n * sizeof(bool) + 1);
+        ready = tasks[k].net && tasks[k].side;
+    }
+    if (!ready)
+    {
+        releaseGomoryHuTasks(tasks, threads);
+        freeGomoryHuTree(tree);
+        return NULL;
+    }
+
+    for (int v = 0; v < n; v++)
+    {
+        tree->parent[v] = 0;
+        tree->weight[v] = 0;
+    }
+    tree->parent[0] = -1;
+
+    int next = 1;
+    while (next < n)
+    {
+        int window = n - next < threads ? n - next : threads;
+
+        // Run the window speculatively with the current parents
+        for (int k = 0; k < window; k++)
+        {
+            tasks[k].s = next + k;
+            tasks[k].t = tree->parent[next + k];
+        }
+        poolFor(window, gomoryHuChunk, tasks);
+        tree->flowCalls += window;
+
+        // Commit in vertex order until a task ran with a stale parent
+        for (int k = 0; k < window; k++)
+        {
+            struct GomoryHuTask *task = &tasks[k];
+            if (tree->parent[task->s] != task->t)
+            {
+                break;
+            }
+            tree->weight[task->s] = task->value;
+            for (int j = task->s + 1; j < n; j++)
+            {
+                if (task->side[j] && tree->parent[j] == task->t)
+                {
+                    tree->parent[j] = task->s;
+                }
+            }
+            next++;
+        }
+    }
+
+    releaseGomoryHuTasks(tasks, threads);
+
+    // Parents always have smaller indices, so depths fill in one pass
+    tree->depth[0] = 0;
+    for (int v = 1; v < n; v++)
+    {
+        tree->depth[v] = tree->depth[tree->parent[v]] + 1;
+    }
+    return tree;
+}
+
+int gomoryHuMinCut(const struct GomoryHuTree *tree, int u, int v)
+{
+    int best = GRAPH_INF;
+
+    // Walk both vertices up to their lowest common ancestor
+    while (u != v)
+    {
+        if (tree->depth[u] < tree->depth[v])
+        {
+            int tmp = u;
+            u = v;
+            v = tmp;
+        }
+        if (tree->weight[u] < best)
+        {
+            best = tree->weight[u];
+        }
+        u = tree->parent[u];
+    }
+    return best;
+}
+
+void freeGomoryHuTree(struct GomoryHuTree *tree)
+{
+    if (!tree)
+    {
+        return;
+    }
+    free(tree->parent);
+    free(tree->weight);
+    free(tree->depth);
+    free(tree);
+}
+
+int hopcroftKarp(int nLeft, int nRight, const int firstEdge[], const int adj[],
+                 int matchLeft[], int matchRight[])
+{
+    int *dist = malloc(nLeft * sizeof(int) + 1);
+    int *queue = malloc(nLeft * sizeof(int) + 1);
+    int *next = malloc(nLeft * sizeof(int) + 1);
+    int *stack = malloc(nLeft * sizeof(int) + 1);
+    int size = 0;
+
+    if (!dist || !queue || !next || !stack)
+    {
+        free(dist);
+        free(queue);
+        free(next);
+        free(stack);
+        return -1;
+    }
+
+    for (int u = 0; u < nLeft; u++)
+    {
+        matchLeft[u] = -1;
+    }
+    for (int v = 0; v < nRight; v++)
+    {
+        matchRight[v] = -1;
+    }
+
+    while (true)
+    {
+        // BFS: layer left vertices by alternating distance from a free
+        // vertex, up to the first layer with an edge to a free right vertex
+        int front = 0, rear = 0;
+        int limit = GRAPH_INF;
+        for (int u = 0; u < nLeft; u++)
+        {
+            dist[u] = matchLeft[u] == -1 ? 0 : GRAPH_INF;
+            if (dist[u] == 0)
+            {
+                queue[rear++] = u;
+            }
+        }
+        while (front < rear && dist[queue[front]] <= limit)
+        {
+            int u = queue[front++];
+            for (int e = firstEdge[u]; e < firstEdge[u + 1]; e++)
+            {
+                int w = matchRight[adj[e]];
+                if (w == -1)
+                {
+                    limit = dist[u];
+                }
+                else if (dist[w] == GRAPH_INF)
+                {
+                    dist[w] = dist[u] + 1;
+                    queue[rear++] = w;
+                }
+            }
+        }
+
+        if (limit == GRAPH_INF)
+        {
+            break; // No augmenting path left: the matching is maximum
+        }
+
+        // DFS: augment along vertex-disjoint paths of exactly that length
+        for (int u = 0; u < nLeft; u++)
+        {
+            next[u] = firstEdge[u];
+        }
+        for (int root = 0; root < nLeft; root++)
+        {
+            if (matchLeft[root] != -1 || dist[root] != 0)
+            {
+                continue;
+            }
+
+            int top = 0;
+            stack[top++] = root;
+            while (top > 0)
+            {
+                int u = stack[top - 1];
+                if (next[u] == firstEdge[u + 1])
+                {
+                    dist[u] = GRAPH_INF; // Dead end: no path continues through u
+                    top--;
+                    continue;
+                }
+
+                int w = matchRight[adj[next[u]]];
+                if (w == -1 && dist[u] == limit)
+                {
+                    // Flip the alternating path held on the stack; its left
+                    // vertices leave the phase, keeping the paths disjoint
+                    for (int i = top - 1; i >= 0; i--)
+                    {
+                        int x = stack[i];
+                        int y = adj[next[x]];
+                        matchLeft[x] = y;
+                        matchRight[y] = x;
+                        dist[x] = GRAPH_INF;
+                    }
+                    size++;
+                    break;
+                }
+                if (w != -1 && dist[u] < limit && dist[w] == dist[u] + 1)
+                {
+                    stack[top++] = w;
+                }
+                else
+                {
+                    next[u]++;
+                }
+            }
+        }
+    }
+
+    free(dist);
+    free(queue);
+    free(next);
+    free(stack);
+    return size;
+}
+
+bool isUnitBipartiteNetwork(int n, int graph[n][n], int s, int t, char side[])
+{
+    for (int v = 0; v < n; v++)
+    {
+        side[v] = 0;
+    }
+
+    // Every edge forces the side of the ordinary vertices it touches
+    for (int u = 0; u < n; u++)
+    {
+        for (int v = 0; v < n; v++)
+        {
+            if (graph[u][v] == 0)
+            {
+                continue;
+            }
+            if (graph[u][v] != 1 || v == s || u == t || (u == s && v == t))
+            {
+                return false;
+            }
+            // s → x makes x an L vertex, x → t an R vertex, u → v both
+            int left = u == s ? v : (v == t ? -1 : u);
+            int right = v == t ? u : (u == s ? -1 : v);
+            if ((left != -1 && side[left] == 2) || (right != -1 && side[right] == 1))
+            {
+                return false;
+            }
+            if (left != -1)
+            {
+                side[left] = 1;
+            }
+            if (right != -1)
+            {
+                side[right] = 2;
+            }
+        }
+    }
+    return true;
+}
+
+int maxFlowAuto(int n, int graph[n][n], int s, int t, struct MatchPair pairs[], int *pairCount)
+{
+    char *side = malloc(n * sizeof(char) + 1);
+    *pairCount = -1;
+    if (!side)
+    {
+        return -1;
+    }
+
+    if (!isUnitBipartiteNetwork(n, graph, s, t, side))
+    {
+        free(side);
+        struct FlowNetwork *net = createFlowNetwork(n, graph);
+        if (!net)
+        {
+            return -1;
+        }
+        int flow = solveMaxFlow(net, s, t);
+        freeFlowNetwork(net);
+        return flow;
+    }
+
+    // Sized for the largest possible sides so one check covers every buffer
+    int *index = malloc(n * sizeof(int) + 1);
+    int *vertexOf = malloc(n * sizeof(int) + 1);
+    int *firstEdge = malloc((n + 1) * sizeof(int));
+    int *adj = malloc((size_t)n * n * sizeof(int) + 1);
+    int *matchLeft = malloc(n * sizeof(int) + 1);
+    int *matchRight = malloc(n * sizeof(int) + 1);
+    int size = -1;
+    if (index && vertexOf && firstEdge && adj && matchLeft && matchRight)
+    {
+        // Number usable L and R vertices consecutively and collect their edges
+        int nLeft = 0, nRight = 0, edges = 0;
+        for (int v = 0; v < n; v++)
+        {
+            if (side[v] == 1 && graph[s][v])
+            {
+                vertexOf[nLeft] = v;
+                index[v] = nLeft++;
+            }
+        }
+        for (int v = 0; v < n; v++)
+        {
+            if (side[v] == 2 && graph[v][t])
+            {
+                vertexOf[nLeft + nRight] = v;
+                index[v] = nRight++;
+            }
+        }
+
+        for (int i = 0; i < nLeft; i++)
+        {
+            int u = vertexOf[i];
+            firstEdge[i] = edges;
+            for (int v = 0; v < n; v++)
+            {
+                if (graph[u][v] && v != t && graph[v][t])
+                {
+                    adj[edges++] = index[v];
+                }
+            }
+        }
+        firstEdge[nLeft] = edges;
+
+        size = hopcroftKarp(nLeft, nRight, firstEdge, adj, matchLeft, matchRight);
+        if (size >= 0)
+        {
+            *pairCount = 0;
+            for (int i = 0; i < nLeft; i++)
+            {
+                if (matchLeft[i] != -1)
+                {
+                    pairs[*pairCount].u = vertexOf[i];
+                    pairs[*pairCount].v = vertexOf[nLeft + matchLeft[i]];
+                    (*pairCount)++;
+                }
+            }
+        }
+    }
+
+    free(side);
+    free(index);
+    free(vertexOf);
+    free(firstEdge);
+    free(adj);
+    free(matchLeft);
+    free(matchRight);
+    return size;
+}
+
+// Flags of unitBipartiteEdges(): the side of a vertex and its terminal edges
+#define SIDE_LEFT 1
+#define SIDE_RIGHT 2
+#define SIDE_FROM_SOURCE 4
+#define SIDE_TO_SINK 8
+
+/**
+ * @brief Check whether a graph's edge list is a unit-capacity bipartite network
+ *
+ * The edge-list counterpart of isUnitBipartiteNetwork(). Edges of weight
+ * 0 are ignored; a second edge s → x or x → t would let x carry two
+ * units, so it fails the check.
+ *
+ * @param graph Directed graph
+ * @param s Source slot
+ * @param t Sink slot
+ * @param side Output: SIDE_* flags of every slot
+ * @return true if max flow from s to t is a bipartite matching
+ */
+static bool unitBipartiteEdges(const struct Graph *graph, int s, int t, char side[])
+{
+    if (!graph->directed || s == t)
+    {
+        return false;
+    }
+    memset(side, 0, graph->n);
+
+    for (int i = 0; i < graph->edgeCount; i++)
+    {
+        const struct GraphEdge *e = &graph->edges[i];
+        if (e->weight == 0)
+        {
+            continue;
+        }
+        if (e->weight != 1 || e->v == s || e->u == t || (e->u == s && e->v == t))
+        {
+            return false;
+        }
+        // s → x makes x an L vertex, x → t an R vertex, u → v both
+        int left = e->u == s ? e->v : (e->v == t ? -1 : e->u);
+        int right = e->v == t ? e->u : (e->u == s ? -1 : e->v);
+        if ((left != -1 && side[left] & SIDE_RIGHT) || (right != -1 && side[right] & SIDE_LEFT))
+        {
+            return false;
+        }
+        int terminal = e->u == s ? SIDE_FROM_SOURCE : e->v == t ? SIDE_TO_SINK : 0;
+        int x = e->u == s ? e->v : e->u;
+        if (terminal && side[x] & terminal)
+        {
+            return false;
+        }
+        side[x] |= terminal;
+        if (left != -1)
+        {
+            side[left] |= SIDE_LEFT;
+        }
+        if (right != -1)
+        {
+            side[right] |= SIDE_RIGHT;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Solve a unit-capacity bipartite network with hopcroftKarp()
+ * @param graph Graph that passed unitBipartiteEdges()
+ * @param ws Workspace of the running query
+ * @param s Source slot
+ * @param t Sink slot
+ * @param side SIDE_* flags from unitBipartiteEdges()
+ * @param flow Output: maximum flow value
+ * @param stored Output: flow of every stored edge (may be NULL)
+ * @return GRAPH_OK or GRAPH_NO_MEMORY
+ */
+static int matchingMaxFlow(const struct Graph *graph, struct GraphWorkspace *ws, int s, int t,
+                           const char side[], int *flow, int stored[])
+{
+    int n = graph->n, m = graph->edgeCount;
+    int *index = wsAlloc(ws, n * sizeof(int) + 1);
+    int *firstEdge = wsAlloc(ws, (n + 1) * sizeof(int));
+    int *adj = wsAlloc(ws, m * sizeof(int) + 1);
+    int *adjEdge = wsAlloc(ws, m * sizeof(int) + 1);
+    int *matchLeft = wsAlloc(ws, n * sizeof(int) + 1);
+    int *matchRight = wsAlloc(ws, n * sizeof(int) + 1);
+    if (!index || !firstEdge || !adj || !adjEdge || !matchLeft || !matchRight)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    // Number the L vertices fed by s and the R vertices that feed t
+    int nLeft = 0, nRight = 0;
+    for (int v = 0; v < n; v++)
+    {
+        bool left = (side[v] & (SIDE_LEFT | SIDE_FROM_SOURCE)) == (SIDE_LEFT | SIDE_FROM_SOURCE);
+        bool right = (side[v] & (SIDE_RIGHT | SIDE_TO_SINK)) == (SIDE_RIGHT | SIDE_TO_SINK);
+        index[v] = left ? nLeft++ : right ? nRight++ : -1;
+    }
+
+    // Group the L → R edges by their L vertex (counting sort)
+    for (int i = 0; i <= nLeft; i++)
+    {
+        firstEdge[i] = 0;
+    }
+    for (int i = 0; i < m; i++)
+    {
+        const struct GraphEdge *e = &graph->edges[i];
+        if (e->weight == 1 && e->u != s && e->v != t && index[e->u] != -1 && index[e->v] != -1)
+        {
+            firstEdge[index[e->u] + 1]++;
+        }
+    }
+    for (int i = 0; i < nLeft; i++)
+    {
+        firstEdge[i + 1] += firstEdge[i];
+    }
+    for (int i = 0; i < m; i++)
+    {
+        const struct GraphEdge *e = &graph->edges[i];
+        if (e->weight == 1 && e->u != s && e->v != t && index[e->u] != -1 && index[e->v] != -1)
+        {
+            int k = firstEdge[index[e->u]]++;
+            adj[k] = index[e->v];
+            adjEdge[k] = i;
+        }
+    }
+    for (int i = nLeft; i > 0; i--)
+    {
+        firstEdge[i] = firstEdge[i - 1];
+    }
+    firstEdge[0] = 0;
+
+    STAT_PHASE(ws, GRAPH_PHASE_SEARCH);
+    *flow = hopcroftKarp(nLeft, nRight, firstEdge, adj, matchLeft, matchRight);
+    if (*flow < 0)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    STAT_ADD(&ws->stats, augmentingPaths, *flow);
+    STAT_PHASE(ws, GRAPH_PHASE_EXPORT);
+
+    if (stored)
+    {
+        // A matched pair (l, r) carries one unit on s → l, l → r and r → t
+        for (int i = 0; i < m; i++)
+        {
+            const struct GraphEdge *e = &graph->edges[i];
+            bool fromSource = e->u == s && index[e->v] != -1 && matchLeft[index[e->v]] != -1;
+            bool toSink = e->v == t && index[e->u] != -1 && matchRight[index[e->u]] != -1;
+            stored[i] = e->weight == 1 && (fromSource || toSink);
+        }
+        for (int l = 0; l < nLeft; l++)
+        {
+            int k = firstEdge[l];
+            while (matchLeft[l] != -1 && adj[k] != matchLeft[l])
+            {
+                k++;
+            }
+            if (matchLeft[l] != -1)
+            {
+                stored[adjEdge[k]] = 1;
+            }
+        }
+    }
+    return GRAPH_OK;
+}
+
+int maxFlowCheckpointed(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                        int sink, int *flow, int edgeFlow[], struct Checkpointer *checkpoint)
+{
+    if (!graph || !flow || source < 0 || source >= graph->n || sink < 0 || sink >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (graph->minWeight < 0)
+    {
+        return GRAPH_NEGATIVE_WEIGHT;
+    }
+    if (isCompressed(graph))
+    {
+        return GRAPH_NEEDS_EDGE_LIST;
+    }
+    if (graph->wideArc)
+    {
+        return GRAPH_WEIGHT_TYPE;
+    }
+
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    if (ws && graph->wideFlow)
+    {
+        // Capacity sums that may overflow int take the saturating kernel
+        int *stored = edgeFlow && graph->inputEdge ? wsAlloc(ws, graph->edgeCount * sizeof(int))
+                                                   : edgeFlow;
+        int status = edgeFlow && !stored ? GRAPH_NO_MEMORY
+                                         : saturatingMaxFlow(graph, ws, vertexSlot(graph, source),
+                                                             vertexSlot(graph, sink), flow, stored,
+                                                             checkpoint);
+        bool copy = (status == GRAPH_OK || status == GRAPH_OVERFLOW) && stored != edgeFlow;
+        for (int i = 0; copy && i < graph->edgeCount; i++)
+        {
+            edgeFlow[graph->inputEdge[i]] = stored[i];
+        }
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+        wsEnd(owned);
+        return status;
+    }
+
+    // Matching networks take Hopcroft-Karp; checkpoints need the residual network
+    char *side = ws && !checkpoint && graph->directed ? wsAlloc(ws, graph->n + 1) : NULL;
+    if (side && unitBipartiteEdges(graph, vertexSlot(graph, source), vertexSlot(graph, sink), side))
+    {
+        size_t bytes = graph->edgeCount * sizeof(int) + 1;
+        int *stored = edgeFlow && graph->inputEdge ? wsAlloc(ws, bytes) : edgeFlow;
+        int status = edgeFlow && !stored
+                         ? GRAPH_NO_MEMORY
+                         : matchingMaxFlow(graph, ws, vertexSlot(graph, source),
+                                           vertexSlot(graph, sink), side, flow, stored);
+        if (status == GRAPH_OK)
+        {
+            TRACE_INFO("maxflow", "done", "\"source\": %d, \"sink\": %d, \"flow\": %d, "
+                       "\"matching\": true", source, sink, *flow);
+        }
+        for (int i = 0; status == GRAPH_OK && stored != edgeFlow && i < graph->edgeCount; i++)
+        {
+            edgeFlow[graph->inputEdge[i]] = stored[i];
+        }
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+        wsEnd(owned);
+        return status;
+    }
+
+    // The network stays in the workspace: asking for the same terminals
+    // again finds the stored flow already maximum
+    struct FlowNetwork *net = ws ? wsFlowNetwork(ws, graph) : NULL;
+    int *left = net && edgeFlow ? wsAlloc(ws, net->arcCount * sizeof(int)) : NULL;
+    int *stored = left && graph->inputEdge ? wsAlloc(ws, graph->edgeCount * sizeof(int)) : edgeFlow;
+    if (!net || (edgeFlow && (!left || !stored)))
+    {
+        wsEnd(owned);
+        return GRAPH_NO_MEMORY;
+    }
+
+    STAT_PHASE(ws, GRAPH_PHASE_SEARCH);
+    STAT_ADD(&ws->stats, edgesScanned, -net->bfs->arcsScanned);
+    long long resumed = -1;
+    int status = checkpoint ? checkpointRestore(checkpoint, net->arcCount, net->residual, NULL,
+                                                &resumed)
+                            : GRAPH_OK;
+    if (status != GRAPH_OK)
+    {
+        wsEnd(owned);
+        return status;
+    }
+    if (resumed >= 0)
+    {
+        // The restored residuals are a flow between these terminals
+        net->source = vertexSlot(graph, source);
+        net->sink = vertexSlot(graph, sink);
+        recomputeFlowValue(net);
+    }
+    *flow = solveMaxFlowCheckpointed(net, vertexSlot(graph, source), vertexSlot(graph, sink),
+                                     checkpoint);
+    STAT_ADD(&ws->stats, edgesScanned, net->bfs->arcsScanned);
+    STAT_ADD(&ws->stats, augmentingPaths, net->augmentations);
+    TRACE_INFO("maxflow", "done", "\"source\": %d, \"sink\": %d, \"flow\": %d, \"paths\": %d",
+               source, sink, *flow, net->augmentations);
+    STAT_PHASE(ws, GRAPH_PHASE_EXPORT);
+
+    if (edgeFlow)
+    {
+        // Split the net flow of every arc pair over the edges that formed
+        // it; left[] holds the flow of each arc still to hand out
+        for (int a = 0; a < net->arcCount; a++)
+        {
+            int f = net->capacity[a] - net->residual[a];
+            left[a] = f > 0 ? f : 0;
+        }
+        for (int i = 0; i < graph->edgeCount; i++)
+        {
+            int a = ws->edgeArc[i];
+            int w = graph->edges[i].weight;
+            if (a == -1)
+            {
+                stored[i] = 0;
+            }
+            else if (graph->directed || left[a] > 0)
+            {
+                stored[i] = left[a] < w ? left[a] : w;
+                left[a] -= stored[i];
+            }
+            else
+            {
+                int b = net->mate[a]; // Undirected edge used from v to u
+                int f = left[b] < w ? left[b] : w;
+                left[b] -= f;
+                stored[i] = -f;
+            }
+        }
+
+        // Stored edge i is the caller's edge inputEdge[i]
+        if (graph->inputEdge)
+        {
+            for (int i = 0; i < graph->edgeCount; i++)
+            {
+                edgeFlow[graph->inputEdge[i]] = stored[i];
+            }
+        }
+    }
+
+    STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    wsEnd(owned);
+    return GRAPH_OK;
+}
+
+int graphMaxFlowWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                   int sink, int *flow, int edgeFlow[])
+{
+    return maxFlowCheckpointed(graph, workspace, source, sink, flow, edgeFlow, NULL);
+}
+
+int graphMaxFlow(const struct Graph *graph, int source, int sink, int *flow, int edgeFlow[])
+{
+    return graphMaxFlowWs(graph, NULL, source, sink, flow, edgeFlow);
+}
@@ -0,0 +1,604 @@
+/**
+ * @file graph.c
+ * @brief Graph construction, accessors and shared helpers of libgraph
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * A graph keeps the edge list it was created from (Bellman-Ford, Kruskal
+ * and max flow work on edges) and a CSR view of the same edges (Dijkstra
+ * and Prim scan the arcs of one vertex at a time). Compressed graphs
+ * (see compress.c) keep only the arcs.
+ *
+ * Time Complexity: O(V + E) to create a graph
+ * Space Complexity: O(V + E)
+ */
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime()
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "graph_internal.h"
+#include "graph_file.h"
+
+int graphApiVersion(void)
+{
+    return GRAPH_API_VERSION;
+}
+
+unsigned long long newGraphSerial(void)
+{
+    static unsigned long long lastSerial = 0;
+    return __atomic_add_fetch(&lastSerial, 1, __ATOMIC_RELAXED);
+}
+
+bool readAll(int fd, void *data, size_t length)
+{
+    char *p = data;
+    while (length > 0)
+    {
+        ssize_t got = read(fd, p, length);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            return false;
+        }
+        p += got;
+        length -= (size_t)got;
+    }
+    return true;
+}
+
+bool writeAll(int fd, const void *data, size_t length)
+{
+    const char *p = data;
+    while (length > 0)
+    {
+        ssize_t written = write(fd, p, length);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        p += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+double nowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+struct Graph *allocGraph(int n, int edgeCount, bool directed)
+{
+    struct Graph *graph = calloc(1, sizeof(struct Graph));
+    if (!graph)
+    {
+        return NULL;
+    }
+
+    size_t arcs = (directed ? 1 : 2) * (size_t)edgeCount;
+    graph->n = n;
+    graph->edgeCount = edgeCount;
+    graph->directed = directed;
+    graph->serial = newGraphSerial();
+    graph->weightStep = 1;
+    graph->edges = graphAllocLarge(edgeCount * sizeof(struct GraphEdge) + 1);
+    graph->offset = graphAllocLarge((n + 1) * sizeof(int));
+    graph->target = graphAllocLarge(arcs * sizeof(int) + 1);
+    graph->weight = graphAllocLarge(arcs * sizeof(int) + 1);
+    graph->edgeOf = graphAllocLarge(arcs * sizeof(int) + 1);
+
+    if (!graph->edges || !graph->offset || !graph->target || !graph->weight || !graph->edgeOf)
+    {
+        graphFree(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+/**
+ * @brief Structure to bound the path and flow sums of a graph's weights
+ *
+ * Edge weights are bucketed by bit length, so the bound on the sum of
+ * the k largest over-estimates only the bucket where k runs out (by less
+ * than a factor of two).
+ */
+struct SumBounds
+{
+    long long bucketCount[32]; // Edges per bit length
+    long long bucketSum[32];   // Weight per bit length
+    int bucketMax[32];         // Largest weight per bit length
+    long long maxAbs;          // Largest absolute arc weight
+    long long maxOut;          // Largest absolute weight leaving one vertex
+};
+
+/**
+ * @brief Add one arc to the sum bounds
+ * @param bounds Bounds
+ * @param weight Arc weight
+ * @param edge true for the one arc that stands for its edge
+ * @param out Absolute weight leaving the tail so far, updated
+ */
+static void boundArc(struct SumBounds *bounds, int weight, bool edge, long long *out)
+{
+    long long w = weight < 0 ? -(long long)weight : weight;
+    bounds->maxAbs = w > bounds->maxAbs ? w : bounds->maxAbs;
+    *out += w;
+    if (edge)
+    {
+        int bits = 0;
+        while (bits < 31 && weight >> bits)
+        {
+            bits++;
+        }
+        bounds->bucketCount[bits]++;
+        bounds->bucketSum[bits] += weight;
+        int top = bounds->bucketMax[bits];
+        bounds->bucketMax[bits] = weight > top ? weight : top;
+    }
+}
+
+/**
+ * @brief Bound the sum of the count largest edge weights from above
+ * @param bounds Bounds of a graph with non-negative weights
+ * @param count Number of weights to sum
+ * @return Upper bound of the sum
+ */
+static long long largestSum(const struct SumBounds *bounds, int count)
+{
+    long long sum = 0, left = count;
+    for (int bits = 31; bits >= 0 && left > 0; bits--)
+    {
+        long long take = bounds->bucketCount[bits] < left ? bounds->bucketCount[bits] : left;
+        sum += take == bounds->bucketCount[bits] ? bounds->bucketSum[bits]
+                                                 : take * bounds->bucketMax[bits];
+        left -= take;
+    }
+    return sum;
+}
+
+void markWideSums(struct Graph *graph)
+{
+    // Undirected graphs store an edge as two arcs: the one with u <= v counts
+    struct SumBounds bounds;
+    memset(&bounds, 0, sizeof(bounds));
+    for (int u = 0; u < graph->n; u++)
+    {
+        long long out = 0;
+        if (isCompressed(graph))
+        {
+            struct ArcCursor arcs;
+            for (arcsBegin(graph, u, &arcs); arcsNext(graph, &arcs, true);)
+            {
+                boundArc(&bounds, arcs.weight, graph->directed || u <= arcs.target, &out);
+            }
+        }
+        else
+        {
+            for (int a = graph->offset[u]; a < graph->offset[u + 1]; a++)
+            {
+                boundArc(&bounds, graph->weight[a], graph->directed || u <= graph->target[a],
+                         &out);
+            }
+        }
+        bounds.maxOut = out > bounds.maxOut ? out : bounds.maxOut;
+    }
+
+    // A flow never exceeds the capacity leaving the source, which an
+    // undirected residual arc can hold twice
+    graph->wideFlow = 2 * bounds.maxOut >= INT_MAX;
+
+    // Without negative weights every distance is a simple path of at most
+    // n - 1 distinct edges, and a relaxation adds one more arc to it; a
+    // negative cycle lets Bellman-Ford repeat arcs, so bound n of the largest
+    graph->widePaths =
+        (graph->minWeight >= 0 ? largestSum(&bounds, graph->n - 1) + bounds.maxAbs
+                               : bounds.maxAbs * graph->n) >= INT_MAX;
+}
+
+void buildArcs(struct Graph *graph)
+{
+    int n = graph->n;
+    int *offset = graph->offset;
+
+    // Count arcs leaving every vertex
+    for (int v = 0; v <= n; v++)
+    {
+        offset[v] = 0;
+    }
+    graph->minWeight = 0;
+    for (int i = 0; i < graph->edgeCount; i++)
+    {
+        const struct GraphEdge *e = &graph->edges[i];
+        offset[e->u + 1]++;
+        if (!graph->directed && e->u != e->v)
+        {
+            offset[e->v + 1]++;
+        }
+        if (i == 0 || e->weight < graph->minWeight)
+        {
+            graph->minWeight = e->weight;
+        }
+    }
+    for (int v = 0; v < n; v++)
+    {
+        offset[v + 1] += offset[v];
+    }
+    graph->arcCount = offset[n];
+
+    // Place arcs using offset[u] as the cursor of u, then shift back
+    for (int i = 0; i < graph->edgeCount; i++)
+    {
+        const struct GraphEdge *e = &graph->edges[i];
+        int a = offset[e->u]++;
+        graph->target[a] = e->v;
+        graph->weight[a] = e->weight;
+        graph->edgeOf[a] = i;
+        if (!graph->directed && e->u != e->v)
+        {
+            int b = offset[e->v]++;
+            graph->target[b] = e->u;
+            graph->weight[b] = e->weight;
+            graph->edgeOf[b] = i;
+        }
+    }
+    for (int v = n; v > 0; v--)
+    {
+        offset[v] = offset[v - 1];
+    }
+    offset[0] = 0;
+
+    markWideSums(graph);
+}
+
+int graphCreate(int n, int edgeCount, const struct GraphEdge edges[], bool directed,
+                struct Graph **graph)
+{
+    if (!graph || n < 0 || edgeCount < 0 || (edgeCount > 0 && !edges))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    for (int i = 0; i < edgeCount; i++)
+    {
+        if (edges[i].u < 0 || edges[i].u >= n || edges[i].v < 0 || edges[i].v >= n)
+        {
+            return GRAPH_INVALID_ARGUMENT;
+        }
+    }
+
+    struct Graph *g = allocGraph(n, edgeCount, directed);
+    if (!g)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    if (edgeCount > 0)
+    {
+        memcpy(g->edges, edges, edgeCount * sizeof(struct GraphEdge));
+    }
+    buildArcs(g);
+
+    *graph = g;
+    return GRAPH_OK;
+}
+
+int graphFromMatrix(int n, const int matrix[], bool directed, struct Graph **graph)
+{
+    if (!graph || n < 0 || (n > 0 && !matrix))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    int edgeCount = 0;
+    for (int u = 0; u < n; u++)
+    {
+        for (int v = directed ? 0 : u + 1; v < n; v++)
+        {
+            edgeCount += matrix[(size_t)u * n + v] != 0;
+        }
+    }
+
+    struct Graph *g = allocGraph(n, edgeCount, directed);
+    if (!g)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    // Row order keeps every vertex's arcs sorted by head
+    int i = 0;
+    for (int u = 0; u < n; u++)
+    {
+        for (int v = directed ? 0 : u + 1; v < n; v++)
+        {
+            if (matrix[(size_t)u * n + v] != 0)
+            {
+                g->edges[i].u = u;
+                g->edges[i].v = v;
+                g->edges[i].weight = matrix[(size_t)u * n + v];
+                i++;
+            }
+        }
+    }
+    buildArcs(g);
+
+    *graph = g;
+    return GRAPH_OK;
+}
+
+int graphLoad(const char *path, struct Graph **graph)
+{
+    struct GraphFile file;
+    if (!graph || !path || openGraphFile(path, &file, true) != GRAPH_FILE_OK)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    // Undirected files store both arcs of an edge: keep the one with u <= v
+    bool directed = file.flags & GRAPH_FILE_DIRECTED;
+    int edgeCount = 0;
+    for (int u = 0; u < file.n; u++)
+    {
+        for (int a = file.offset[u]; a < file.offset[u + 1]; a++)
+        {
+            edgeCount += directed || u <= file.target[a];
+        }
+    }
+
+    struct Graph *g = allocGraph(file.n, edgeCount, directed);
+    if (!g)
+    {
+        closeGraphFile(&file);
+        return GRAPH_NO_MEMORY;
+    }
+
+    int i = 0;
+    for (int u = 0; u < file.n; u++)
+    {
+        for (int a = file.offset[u]; a < file.offset[u + 1]; a++)
+        {
+            if (directed || u <= file.target[a])
+            {
+                g->edges[i].u = u;
+                g->edges[i].v = file.target[a];
+                g->edges[i].weight = file.weight ? file.weight[a] : 1;
+                i++;
+            }
+        }
+    }
+    closeGraphFile(&file);
+    buildArcs(g);
+
+    *graph = g;
+    return GRAPH_OK;
+}
+
+void graphFree(struct Graph *graph)
+{
+    if (!graph)
+    {
+        return;
+    }
+    graphFreeLarge(graph->edges);
+    graphFreeLarge(graph->offset);
+    graphFreeLarge(graph->target);
+    graphFreeLarge(graph->weight);
+    graphFreeLarge(graph->edgeOf);
+    free(graph->position);
+    free(graph->vertexAt);
+    free(graph->inputEdge);
+    free(graph->packed);
+    free(graph->packedOffset);
+    free(graph->matrix);
+    free(graph->wideEdge);
+    free(graph->wideArc);
+    free(graph);
+}
+
+int graphVertexCount(const struct Graph *graph)
+{
+    return graph->n;
+}
+
+int graphEdgeCount(const struct Graph *graph)
+{
+    return graph->edgeCount;
+}
+
+bool graphIsDirected(const struct Graph *graph)
+{
+    return graph->directed;
+}
+
+int graphWeightStep(const struct Graph *graph)
+{
+    return graph->weightStep;
+}
+
+long long graphMemoryUsage(const struct Graph *graph)
+{
+    long long n = graph->n;
+    long long bytes = sizeof(struct Graph) + (n + 1) * sizeof(int);
+
+    if (graph->edges)
+    {
+        bytes += graph->edgeCount * (long long)sizeof(struct GraphEdge);
+        bytes += 3 * (long long)graph->arcCount * sizeof(int); // target, weight, edgeOf
+    }
+    if (graph->position)
+    {
+        bytes += 2 * n * sizeof(int); // position, vertexAt
+    }
+    if (graph->inputEdge)
+    {
+        bytes += graph->edgeCount * (long long)sizeof(int);
+    }
+    if (graph->packed)
+    {
+        bytes += graph->packedBytes + (n + 1) * sizeof(size_t);
+    }
+    if (graph->matrix)
+    {
+        bytes += n * graph->rowWords * (long long)sizeof(unsigned long long);
+    }
+    if (graph->wideArc)
+    {
+        bytes += (graph->edgeCount + (long long)graph->arcCount) * weightSize(graph->weightType);
+    }
+    return bytes;
+}
+
+const char *graphStatusMessage(int status)
+{
+    switch (status)
+    {
+    case GRAPH_OK:
+        return "success";
+    case GRAPH_NO_MEMORY:
+        return "out of memory";
+    case GRAPH_INVALID_ARGUMENT:
+        return "invalid argument";
+    case GRAPH_NEGATIVE_WEIGHT:
+        return "graph has negative edge weights";
+    case GRAPH_NEGATIVE_CYCLE:
+        return "negative cycle reachable from the source";
+    case GRAPH_NOT_CONNECTED:
+        return "graph is not connected";
+    case GRAPH_NEEDS_UNDIRECTED:
+        return "algorithm needs an undirected graph";
+    case GRAPH_IO_ERROR:
+        return "input/output error";
+    case GRAPH_NEEDS_EDGE_LIST:
+        return "algorithm needs the edge list of an uncompressed graph";
+    case GRAPH_WEIGHT_TYPE:
+        return "graph weights do not fit int";
+    case GRAPH_OVERFLOW:
+        return "result does not fit int: use int64 weights";
+    default:
+        return "unknown error";
+    }
+}
+
+int *slotArray(const struct Graph *graph, struct GraphWorkspace *workspace, int out[])
+{
+    if (!out || !graph->vertexAt)
+    {
+        return out;
+    }
+    return wsAlloc(workspace, graph->n * sizeof(int));
+}
+
+void exportSlots(const struct Graph *graph, int slots[], int out[], bool vertexValues)
+{
+    if (!slots || slots == out)
+    {
+        return;
+    }
+    for (int p = 0; p < graph->n; p++)
+    {
+        int value = slots[p];
+        if (vertexValues && value >= 0)
+        {
+            value = graph->vertexAt[value];
+        }
+        out[graph->vertexAt[p]] = value;
+    }
+}
+
+bool heapInit(struct VertexHeap *heap, struct GraphWorkspace *workspace, int n, const int key[])
+{
+    heap->size = 0;
+    heap->key = key;
+    heap->stats = &workspace->stats;
+    heap->vertex = wsAlloc(workspace, n * sizeof(int));
+    heap->position = wsAlloc(workspace, n * sizeof(int));
+    heap->stamp = wsMarks(workspace, n, &heap->epoch);
+    return heap->vertex && heap->position && heap->stamp;
+}
+
+/**
+ * @brief Move the entry at index i up until its parent is not larger
+ * @param heap Heap
+ * @param i Index of the entry
+ */
+static void siftUp(struct VertexHeap *heap, int i)
+{
+    int v = heap->vertex[i];
+    while (i > 0)
+    {
+        int p = (i - 1) / 2;
+        int u = heap->vertex[p];
+        if (heap->key[u] <= heap->key[v])
+        {
+            break;
+        }
+        heap->vertex[i] = u;
+        heap->position[u] = i;
+        i = p;
+    }
+    heap->vertex[i] = v;
+    heap->position[v] = i;
+}
+
+void heapDecrease(struct VertexHeap *heap, int v)
+{
+    if (heap->stamp[v] != heap->epoch)
+    {
+        heap->stamp[v] = heap->epoch;
+        heap->vertex[heap->size] = v;
+        heap->position[v] = heap->size++;
+        STAT_ADD(heap->stats, heapPushes, 1);
+    }
+    else
+    {
+        STAT_ADD(heap->stats, heapDecreases, 1);
+    }
+    siftUp(heap, heap->position[v]);
+}
+
+int heapPopMin(struct VertexHeap *heap)
+{
+    int top = heap->vertex[0];
+    heap->position[top] = -1;
+    STAT_ADD(heap->stats, heapPops, 1);
+
+    int last = heap->vertex[--heap->size];
+    if (heap->size == 0)
+    {
+        return top;
+    }
+
+    // Move the last entry down from the root
+    int i = 0;
+    while (2 * i + 1 < heap->size)
+    {
+        int child = 2 * i + 1;
+        if (child + 1 < heap->size &&
+            heap->key[heap->vertex[child + 1]] < heap->key[heap->vertex[child]])
+        {
+            child++;
+        }
+        if (heap->key[heap->vertex[child]] >= heap->key[last])
+        {
+            break;
+        }
+        heap->vertex[i] = heap->vertex[child];
+        heap->position[heap->vertex[i]] = i;
+        i = child;
+    }
+    heap->vertex[i] = last;
+    heap->position[last] = i;
+    return top;
+}
@@ -0,0 +1,614 @@
+/**
+ * @file graph_file.c
+ * @brief Writer, memory-mapped loader and text converter for graph files
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Loading a graph file costs one mmap() call and a header check, no
+ * matter how large the graph is: pages are brought in by the kernel the
+ * first time an algorithm touches them. Callers that cannot trust the
+ * file ask for an O(V + E) check of the offsets and indices on top.
+ * Files are written to a unique temporary name, synced and renamed into
+ * place, so processes that still have the old version mapped keep
+ * reading a consistent graph.
+ */
+
+#define _POSIX_C_SOURCE 200809L // For mmap(), fstat() and getline()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "graph_file.h"
+#include "bfs.h"
+
+// The header layout is part of the format: fail the build if it changes
+typedef char graphFileHeaderIs128Bytes[sizeof(struct GraphFileHeader) == 128 ? 1 : -1];
+
+/**
+ * @brief Round a file position up to the section alignment
+ * @param pos File position
+ * @return Aligned file position
+ */
+static uint64_t alignUp(uint64_t pos)
+{
+    return (pos + GRAPH_FILE_ALIGN - 1) / GRAPH_FILE_ALIGN * GRAPH_FILE_ALIGN;
+}
+
+/**
+ * @brief Get the number of entries of a section
+ * @param section Section
+ * @param n Number of vertices
+ * @param arcs Number of arcs
+ * @return Number of 32-bit entries
+ */
+static uint64_t sectionLength(int section, uint64_t n, uint64_t arcs)
+{
+    return section == SECTION_OFFSET || section == SECTION_IN_OFFSET ? n + 1 : arcs;
+}
+
+int writeGraphFile(const char *path, const struct GraphFileData *data)
+{
+    const int *arrays[SECTION_COUNT] = {data->offset, data->target, data->weight, data->capacity,
+                                        data->inOffset, data->inSource, data->inArc};
+    struct GraphFileHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, 8);
+    header.version = GRAPH_FILE_VERSION;
+    header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+    header.flags = (data->directed ? GRAPH_FILE_DIRECTED : 0) |
+                   (data->weight ? GRAPH_FILE_WEIGHTS : 0) |
+                   (data->capacity ? GRAPH_FILE_CAPACITIES : 0) |
+                   (data->inOffset && data->inSource && data->inArc ? GRAPH_FILE_IN_ARCS : 0);
+    header.vertices = (uint64_t)data->n;
+    header.arcs = (uint64_t)data->arcs;
+
+    if (!(header.flags & GRAPH_FILE_IN_ARCS))
+    {
+        arrays[SECTION_IN_OFFSET] = arrays[SECTION_IN_SOURCE] = arrays[SECTION_IN_ARC] = NULL;
+    }
+
+    // Lay out the present sections one after another on aligned positions
+    uint64_t pos = sizeof(header);
+    for (int i = 0; i < SECTION_COUNT; i++)
+    {
+        if (arrays[i])
+        {
+            pos = alignUp(pos);
+            header.section[i] = pos;
+            pos += sectionLength(i, header.vertices, header.arcs) * sizeof(int);
+        }
+    }
+
+    // A unique name next to the target keeps concurrent writers apart and
+    // lets rename() replace the file atomically
+    size_t tmpLength = strlen(path) + sizeof(".XXXXXX");
+    char *tmpPath = malloc(tmpLength);
+    if (!tmpPath)
+    {
+        return GRAPH_FILE_IO_ERROR;
+    }
+    snprintf(tmpPath, tmpLength, "%s.XXXXXX", path);
+
+    int fd = mkstemp(tmpPath);
+    FILE *out = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if (!out)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            unlink(tmpPath);
+        }
+        free(tmpPath);
+        return GRAPH_FILE_IO_ERROR;
+    }
+
+    static const char zeros[GRAPH_FILE_ALIGN] = {0};
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    pos = sizeof(header);
+    for (int i = 0; i < SECTION_COUNT && ok; i++)
+    {
+        if (!arrays[i])
+        {
+            continue;
+        }
+        size_t gap = (size_t)(header.section[i] - pos);
+        size_t count = (size_t)sectionLength(i, header.vertices, header.arcs);
+        ok = fwrite(zeros, 1, gap, out) == gap &&
+             fwrite(arrays[i], sizeof(int), count, out) == count;
+        pos = header.section[i] + count * sizeof(int);
+    }
+
+    // mkstemp() creates the file private to the owner; graph files are shared.
+    // The data must be on disk before the rename makes it visible
+    ok = ok && fchmod(fd, 0644) == 0;
+    ok = ok && fflush(out) == 0 && fsync(fd) == 0;
+    ok = fclose(out) == 0 && ok;
+    ok = ok && rename(tmpPath, path) == 0;
+    if (!ok)
+    {
+        unlink(tmpPath);
+    }
+    free(tmpPath);
+    return ok ? GRAPH_FILE_OK : GRAPH_FILE_IO_ERROR;
+}
+
+/**
+ * @brief Check that two present sections do not share any bytes
+ * @param header File header
+ * @param i First section
+ * @param j Second section
+ * @return true if the sections are disjoint or one is absent
+ */
+static bool sectionsDisjoint(const struct GraphFileHeader *header, int i, int j)
+{
+    uint64_t a = header->section[i], b = header->section[j];
+    if (a == 0 || b == 0)
+    {
+        return true;
+    }
+    uint64_t aEnd = a + sectionLength(i, header->vertices, header->arcs) * sizeof(int);
+    uint64_t bEnd = b + sectionLength(j, header->vertices, header->arcs) * sizeof(int);
+    return aEnd <= b || bEnd <= a;
+}
+
+/**
+ * @brief Check that an offset array is monotonic and its indices are in range
+ * @param offset Offsets (n + 1 entries, offset[0] == 0 and offset[n] == arcs)
+ * @param index Index of every arc
+ * @param n Number of vertices
+ * @param limit Every index must lie in [0, limit)
+ * @return true if the arrays are consistent
+ */
+static bool arraysValid(const int *offset, const int *index, int n, int limit)
+{
+    for (int u = 0; u < n; u++)
+    {
+        if (offset[u] > offset[u + 1])
+        {
+            return false;
+        }
+        for (int a = offset[u]; a < offset[u + 1]; a++)
+        {
+            if (index[a] < 0 || index[a] >= limit)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check the contents of the index arrays of a mapped file
+ *
+ * One pass over the offsets, targets and in-arcs: O(V + E).
+ *
+ * @param file Mapped graph (n, arcs and the array pointers set)
+ * @return true if every offset is monotonic and every index is in range
+ */
+static bool contentsValid(const struct GraphFile *file)
+{
+    if (!arraysValid(file->offset, file->target, file->n, file->n))
+    {
+        return false;
+    }
+    if (!file->inOffset)
+    {
+        return true;
+    }
+    return file->inOffset[0] == 0 && file->inOffset[file->n] == file->arcs &&
+           arraysValid(file->inOffset, file->inSource, file->n, file->n) &&
+           arraysValid(file->inOffset, file->inArc, file->n, file->arcs);
+}
+
+int openGraphFile(const char *path, struct GraphFile *file, bool validate)
+{
+    memset(file, 0, sizeof(*file));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return GRAPH_FILE_IO_ERROR;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return GRAPH_FILE_IO_ERROR;
+    }
+    if ((uint64_t)st.st_size < sizeof(struct GraphFileHeader))
+    {
+        close(fd);
+        return GRAPH_FILE_BAD_MAGIC;
+    }
+
+    // Shared read-only mapping: every process uses the same page-cache pages
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return GRAPH_FILE_IO_ERROR;
+    }
+
+    const struct GraphFileHeader *header = map;
+    int status = GRAPH_FILE_OK;
+
+    if (memcmp(header->magic, GRAPH_FILE_MAGIC, 8) != 0)
+    {
+        status = GRAPH_FILE_BAD_MAGIC;
+    }
+    else if (header->version != GRAPH_FILE_VERSION || header->byteOrder != GRAPH_FILE_BYTE_ORDER)
+    {
+        status = GRAPH_FILE_BAD_VERSION;
+    }
+    else if (header->vertices >= INT_MAX || header->arcs > INT_MAX)
+    {
+        status = GRAPH_FILE_TOO_LARGE;
+    }
+    else
+    {
+        const int **arrays[SECTION_COUNT] = {&file->offset, &file->target, &file->weight,
+                                             &file->capacity, &file->inOffset, &file->inSource,
+                                             &file->inArc};
+        for (int i = 0; i < SECTION_COUNT; i++)
+        {
+            uint64_t pos = header->section[i];
+            uint64_t bytes = sectionLength(i, header->vertices, header->arcs) * sizeof(int);
+            if (pos == 0)
+            {
+                continue;
+            }
+            if (pos < sizeof(struct GraphFileHeader) || pos % GRAPH_FILE_ALIGN != 0 ||
+                pos > size || bytes > size - pos)
+            {
+                status = GRAPH_FILE_BAD_LAYOUT;
+                break;
+            }
+            *arrays[i] = (const int *)((const char *)map + pos);
+        }
+        for (int i = 0; i < SECTION_COUNT && status == GRAPH_FILE_OK; i++)
+        {
+            for (int j = i + 1; j < SECTION_COUNT; j++)
+            {
+                if (!sectionsDisjoint(header, i, j))
+                {
+                    status = GRAPH_FILE_BAD_LAYOUT;
+                    break;
+                }
+            }
+        }
+
+        uint32_t flags = header->flags;
+        bool hasInArcs = file->inOffset && file->inSource && file->inArc;
+        if (status == GRAPH_FILE_OK &&
+            (!file->offset || !file->target ||
+             !(flags & GRAPH_FILE_WEIGHTS) != !file->weight ||
+             !(flags & GRAPH_FILE_CAPACITIES) != !file->capacity ||
+             !(flags & GRAPH_FILE_IN_ARCS) != !hasInArcs ||
+             file->offset[0] != 0 || (uint64_t)file->offset[header->vertices] != header->arcs))
+        {
+            status = GRAPH_FILE_BAD_LAYOUT;
+        }
+    }
+
+    file->n = (int)header->vertices;
+    file->arcs = (int)header->arcs;
+    if (status == GRAPH_FILE_OK && validate && !contentsValid(file))
+    {
+        status = GRAPH_FILE_BAD_CONTENTS;
+    }
+
+    if (status != GRAPH_FILE_OK)
+    {
+        munmap(map, size);
+        memset(file, 0, sizeof(*file));
+        return status;
+    }
+
+    file->flags = header->flags;
+    file->map = map;
+    file->mapSize = size;
+    return GRAPH_FILE_OK;
+}
+
+void closeGraphFile(struct GraphFile *file)
+{
+    if (file->map)
+    {
+        munmap(file->map, file->mapSize);
+    }
+    memset(file, 0, sizeof(*file));
+}
+
+/**
+ * @brief Structure to collect the edges of a text edge list
+ */
+struct EdgeBuffer
+{
+    long long count;    // Number of edges read
+    long long capacity; // Number of edges the arrays can hold
+    int columns;        // Values per line (2, 3 or 4)
+    int *u, *v, *w, *c; // Endpoints, weights and capacities
+};
+
+/**
+ * @brief Grow an edge buffer so it can hold one more edge
+ * @param edges Edge buffer
+ * @return false if memory ran out
+ */
+static bool growEdges(struct EdgeBuffer *edges)
+{
+    if (edges->count < edges->capacity)
+    {
+        return true;
+    }
+
+    long long capacity = edges->capacity ? 2 * edges->capacity : 1024;
+    int **arrays[4] = {&edges->u, &edges->v, &edges->w, &edges->c};
+    for (int i = 0; i < edges->columns; i++)
+    {
+        int *grown = realloc(*arrays[i], (size_t)capacity * sizeof(int));
+        if (!grown)
+        {
+            return false;
+        }
+        *arrays[i] = grown;
+    }
+    edges->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Parse up to four integers from one line of an edge list
+ * @param line Line text
+ * @param values Output values
+ * @return Number of values parsed, or -1 on malformed input
+ */
+static int parseLine(const char *line, long long values[4])
+{
+    int count = 0;
+    const char *p = line;
+
+    while (true)
+    {
+        while (*p == ' ' || *p == '\t' || *p == ',')
+        {
+            p++;
+        }
+        if (*p == '\0' || *p == '\n' || *p == '\r' || *p == '#')
+        {
+            return count;
+        }
+        if (count == 4)
+        {
+            return -1;
+        }
+
+        bool negative = *p == '-';
+        if (negative || *p == '+')
+        {
+            p++;
+        }
+        if (*p < '0' || *p > '9')
+        {
+            return -1;
+        }
+
+        long long value = 0;
+        while (*p >= '0' && *p <= '9')
+        {
+            value = value * 10 + (*p++ - '0');
+            if (value > INT_MAX)
+            {
+                return -1;
+            }
+        }
+        values[count++] = negative ? -value : value;
+    }
+}
+
+int convertEdgeList(const char *textPath, const char *binaryPath, bool directed, long *line)
+{
+    FILE *in = fopen(textPath, "r");
+    if (!in)
+    {
+        return GRAPH_FILE_IO_ERROR;
+    }
+
+    struct EdgeBuffer edges;
+    memset(&edges, 0, sizeof(edges));
+    int status = GRAPH_FILE_OK;
+    int n = 0;
+    long lineNo = 0;
+    char *text = NULL;
+    size_t textSize = 0;
+
+    // Step 1: Read all edges
+    while (getline(&text, &textSize, in) != -1)
+    {
+        long long values[4];
+        int count = parseLine(text, values);
+        lineNo++;
+
+        if (count == 0)
+        {
+            continue; // Blank or comment line
+        }
+        if (edges.columns == 0 && count >= 2)
+        {
+            edges.columns = count;
+        }
+        if (count != edges.columns || values[0] < 0 || values[1] < 0 ||
+            values[0] >= INT_MAX - 1 || values[1] >= INT_MAX - 1)
+        {
+            status = GRAPH_FILE_PARSE_ERROR;
+            break;
+        }
+        if (!growEdges(&edges))
+        {
+            status = GRAPH_FILE_IO_ERROR;
+            break;
+        }
+
+        int *arrays[4] = {edges.u, edges.v, edges.w, edges.c};
+        for (int i = 0; i < count; i++)
+        {
+            arrays[i][edges.count] = (int)values[i];
+        }
+        for (int i = 0; i < 2; i++)
+        {
+            if (values[i] + 1 > n)
+            {
+                n = (int)values[i] + 1;
+            }
+        }
+        edges.count++;
+    }
+    free(text);
+    fclose(in);
+
+    if (line)
+    {
+        *line = status == GRAPH_FILE_PARSE_ERROR ? lineNo : 0;
+    }
+
+    // Step 2: Count arcs per tail; undirected edges give two arcs
+    long long arcCount = 0;
+    for (long long i = 0; i < edges.count && status == GRAPH_FILE_OK; i++)
+    {
+        arcCount += directed || edges.u[i] == edges.v[i] ? 1 : 2;
+    }
+    if (status == GRAPH_FILE_OK && arcCount > INT_MAX)
+    {
+        status = GRAPH_FILE_TOO_LARGE;
+    }
+
+    int *offset = NULL, *target = NULL, *weight = NULL, *capacity = NULL;
+    int *inOffset = NULL, *inSource = NULL, *inArc = NULL;
+    if (status == GRAPH_FILE_OK)
+    {
+        int arcs = (int)arcCount;
+        offset = calloc((size_t)n + 1, sizeof(int));
+        target = malloc((size_t)arcs * sizeof(int) + 1);
+        weight = edges.columns >= 3 ? malloc((size_t)arcs * sizeof(int) + 1) : NULL;
+        capacity = edges.columns >= 4 ? malloc((size_t)arcs * sizeof(int) + 1) : NULL;
+        int *cursor = malloc((size_t)n * sizeof(int) + 1);
+
+        if (!offset || !target || !cursor || (edges.columns >= 3 && !weight) ||
+            (edges.columns >= 4 && !capacity))
+        {
+            status = GRAPH_FILE_IO_ERROR;
+        }
+        else
+        {
+            // Step 3: Counting sort of the arcs by tail
+            for (long long i = 0; i < edges.count; i++)
+            {
+                offset[edges.u[i] + 1]++;
+                if (!directed && edges.u[i] != edges.v[i])
+                {
+                    offset[edges.v[i] + 1]++;
+                }
+            }
+            for (int v = 0; v < n; v++)
+            {
+                offset[v + 1] += offset[v];
+            }
+            memcpy(cursor, offset, (size_t)n * sizeof(int));
+
+            for (long long i = 0; i < edges.count; i++)
+            {
+                for (int side = 0; side < 2; side++)
+                {
+                    int from = side ? edges.v[i] : edges.u[i];
+                    int to = side ? edges.u[i] : edges.v[i];
+                    if (side && (directed || from == to))
+                    {
+                        break;
+                    }
+                    int a = cursor[from]++;
+                    target[a] = to;
+                    if (weight)
+                    {
+                        weight[a] = edges.w[i];
+                    }
+                    if (capacity)
+                    {
+                        capacity[a] = edges.c[i];
+                    }
+                }
+            }
+
+            // Directed graphs also store in-arcs for bottom-up traversal
+            if (directed)
+            {
+                inOffset = malloc(((size_t)n + 1) * sizeof(int));
+                inSource = malloc((size_t)arcs * sizeof(int) + 1);
+                inArc = malloc((size_t)arcs * sizeof(int) + 1);
+                if (!inOffset || !inSource || !inArc)
+                {
+                    status = GRAPH_FILE_IO_ERROR;
+                }
+                else
+                {
+                    buildInArcs(n, offset, target, inOffset, inSource, inArc);
+                }
+            }
+
+            if (status == GRAPH_FILE_OK)
+            {
+                struct GraphFileData data = {n, arcs, directed, offset, target, weight,
+                                             capacity, inOffset, inSource, inArc};
+                status = writeGraphFile(binaryPath, &data);
+            }
+        }
+        free(cursor);
+    }
+
+    free(edges.u);
+    free(edges.v);
+    free(edges.w);
+    free(edges.c);
+    free(offset);
+    free(target);
+    free(weight);
+    free(capacity);
+    free(inOffset);
+    free(inSource);
+    free(inArc);
+    return status;
+}
+
+const char *graphFileStatusMessage(int status)
+{
+    switch (status)
+    {
+    case GRAPH_FILE_OK:
+        return "success";
+    case GRAPH_FILE_IO_ERROR:
+        return "file could not be opened, read, mapped or written";
+    case GRAPH_FILE_BAD_MAGIC:
+        return "not a graph file";
+    case GRAPH_FILE_BAD_VERSION:
+        return "unsupported format version or byte order";
+    case GRAPH_FILE_BAD_LAYOUT:
+        return "corrupt section layout";
+    case GRAPH_FILE_TOO_LARGE:
+        return "graph exceeds 32-bit vertex or arc indices";
+    case GRAPH_FILE_PARSE_ERROR:
+        return "malformed edge list line";
+    case GRAPH_FILE_BAD_CONTENTS:
+        return "offsets out of order or indices out of range";
+    default:
+        return "unknown error";
+    }
+}
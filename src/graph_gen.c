@@ -0,0 +1,252 @@
+/**
+ * @file graph_gen.c
+ * @brief Synthetic graph generators of libgraph
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * All randomness comes from splitmix64, which is fast, has a 64-bit
+ * state and gives the same sequence everywhere (rand() does not).
+ *
+ * Time Complexity: O(E · scale) for R-MAT, O(V + E) for the others
+ * Space Complexity: O(E) for the edge list (O(V) extra to permute IDs)
+ */
+
+#include <stdlib.h>
+
+#include "graph_gen.h"
+
+/**
+ * @brief Advance a splitmix64 generator
+ * @param state Generator state
+ * @return Next 64 random bits
+ */
+static unsigned long long nextRandom(unsigned long long *state)
+{
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Draw a uniform integer below a bound
+ * @param state Generator state
+ * @param bound Exclusive upper bound (1 .. 2^31 - 1)
+ * @return Integer in 0 .. bound - 1
+ */
+static int randomBelow(unsigned long long *state, int bound)
+{
+    return (int)(((nextRandom(state) >> 32) * (unsigned long long)bound) >> 32);
+}
+
+/**
+ * @brief Draw a uniform weight
+ * @param state Generator state
+ * @param maxWeight Largest weight
+ * @return Weight in 1 .. maxWeight
+ */
+static int randomWeight(unsigned long long *state, int maxWeight)
+{
+    return 1 + randomBelow(state, maxWeight);
+}
+
+/**
+ * @brief Fill an array with a uniformly random permutation (Fisher-Yates)
+ * @param state Generator state
+ * @param n Number of entries
+ * @param perm Output: permutation of 0 .. n - 1
+ */
+static void randomPermutation(unsigned long long *state, int n, int perm[])
+{
+    for (int i = 0; i < n; i++)
+    {
+        perm[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--)
+    {
+        int j = randomBelow(state, i + 1);
+        int tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+}
+
+struct GraphEdge *generateRmat(int scale, int edgeFactor, int maxWeight, unsigned long long seed,
+                               int *edgeCount)
+{
+    if (scale < 1 || scale > 30 || edgeFactor < 0 || maxWeight < 1 || !edgeCount ||
+        (long long)edgeFactor << scale > INT_MAX)
+    {
+        return NULL;
+    }
+
+    int n = 1 << scale, m = edgeFactor << scale;
+    struct GraphEdge *edges = malloc(m * sizeof(struct GraphEdge) + 1);
+    int *perm = malloc(n * sizeof(int));
+    if (!edges || !perm)
+    {
+        free(edges);
+        free(perm);
+        return NULL;
+    }
+
+    // Quadrant thresholds out of 2^32: a = 0.57, a + b = 0.76, a + b + c = 0.95
+    const unsigned long long a = 2448131359ULL, ab = 3264175145ULL, abc = 4080218931ULL;
+    unsigned long long state = seed;
+    for (int i = 0; i < m; i++)
+    {
+        int u = 0, v = 0;
+        for (int bit = scale - 1; bit >= 0; bit--)
+        {
+            unsigned long long r = nextRandom(&state) >> 32;
+            if (r >= a && r < ab)
+            {
+                v |= 1 << bit; // Quadrant b
+            }
+            else if (r >= ab && r < abc)
+            {
+                u |= 1 << bit; // Quadrant c
+            }
+            else if (r >= abc)
+            {
+                u |= 1 << bit; // Quadrant d
+                v |= 1 << bit;
+            }
+        }
+        edges[i].u = u;
+        edges[i].v = v;
+        edges[i].weight = randomWeight(&state, maxWeight);
+    }
+
+    randomPermutation(&state, n, perm);
+    for (int i = 0; i < m; i++)
+    {
+        edges[i].u = perm[edges[i].u];
+        edges[i].v = perm[edges[i].v];
+    }
+    free(perm);
+
+    *edgeCount = m;
+    return edges;
+}
+
+struct GraphEdge *generateErdosRenyi(int n, int m, int maxWeight, unsigned long long seed)
+{
+    if (n < 1 || m < 0 || maxWeight < 1)
+    {
+        return NULL;
+    }
+
+    struct GraphEdge *edges = malloc(m * sizeof(struct GraphEdge) + 1);
+    if (!edges)
+    {
+        return NULL;
+    }
+
+    unsigned long long state = seed;
+    for (int i = 0; i < m; i++)
+    {
+        edges[i].u = randomBelow(&state, n);
+        edges[i].v = randomBelow(&state, n);
+        edges[i].weight = randomWeight(&state, maxWeight);
+    }
+    return edges;
+}
+
+struct GraphEdge *generateGrid(int rows, int cols, int maxWeight, unsigned long long seed,
+                               int *edgeCount)
+{
+    if (rows < 1 || cols < 1 || maxWeight < 1 || !edgeCount ||
+        2LL * rows * cols > INT_MAX)
+    {
+        return NULL;
+    }
+
+    int m = rows * (cols - 1) + (rows - 1) * cols;
+    struct GraphEdge *edges = malloc(m * sizeof(struct GraphEdge) + 1);
+    if (!edges)
+    {
+        return NULL;
+    }
+
+    unsigned long long state = seed;
+    int i = 0;
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            int v = r * cols + c;
+            if (c + 1 < cols)
+            {
+                edges[i++] = (struct GraphEdge){v, v + 1, randomWeight(&state, maxWeight)};
+            }
+            if (r + 1 < rows)
+            {
+                edges[i++] = (struct GraphEdge){v, v + cols, randomWeight(&state, maxWeight)};
+            }
+        }
+    }
+
+    *edgeCount = m;
+    return edges;
+}
+
+struct GraphEdge *generateBipartiteFlow(int left, int right, int degree, int maxCapacity,
+                                        unsigned long long seed, int *edgeCount)
+{
+    if (left < 1 || right < 1 || degree < 0 || maxCapacity < 1 || !edgeCount ||
+        (long long)left * (degree + 1) + right > INT_MAX || (long long)left + right + 2 > INT_MAX)
+    {
+        return NULL;
+    }
+
+    int m = left * (degree + 1) + right;
+    struct GraphEdge *edges = malloc(m * sizeof(struct GraphEdge) + 1);
+    if (!edges)
+    {
+        return NULL;
+    }
+
+    unsigned long long state = seed;
+    int sink = left + right + 1, i = 0;
+    for (int u = 1; u <= left; u++)
+    {
+        edges[i++] = (struct GraphEdge){0, u, randomWeight(&state, maxCapacity)};
+        for (int k = 0; k < degree; k++)
+        {
+            int v = left + 1 + randomBelow(&state, right);
+            edges[i++] = (struct GraphEdge){u, v, randomWeight(&state, maxCapacity)};
+        }
+    }
+    for (int v = left + 1; v < sink; v++)
+    {
+        edges[i++] = (struct GraphEdge){v, sink, randomWeight(&state, maxCapacity)};
+    }
+
+    *edgeCount = m;
+    return edges;
+}
+
+int shuffleVertexIds(int n, struct GraphEdge edges[], int edgeCount, unsigned long long seed)
+{
+    if (n < 0 || edgeCount < 0 || (edgeCount > 0 && !edges))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    int *perm = malloc(n * sizeof(int) + 1);
+    if (!perm)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    unsigned long long state = seed;
+    randomPermutation(&state, n, perm);
+    for (int i = 0; i < edgeCount; i++)
+    {
+        edges[i].u = perm[edges[i].u];
+        edges[i].v = perm[edges[i].v];
+    }
+    free(perm);
+    return GRAPH_OK;
+}
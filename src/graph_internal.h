@@ -0,0 +1,711 @@
+/**
+ * @file graph_internal.h
+ * @brief Layout of struct Graph and helpers shared by the libgraph sources
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Not installed: callers only see the opaque handle from graph.h, so this
+ * layout can change without breaking the API.
+ */
+
+#ifndef GRAPH_INTERNAL_H
+#define GRAPH_INTERNAL_H
+
+#include <stddef.h>
+
+#include "graph.h"
+
+/**
+ * @brief Structure of a graph: the input edges plus a CSR view of them
+ *
+ * Out-arcs of u are arcs offset[u] .. offset[u + 1] - 1. A directed edge
+ * gives one arc; an undirected edge gives one arc per endpoint (one arc
+ * for a self-loop). edgeOf[a] maps an arc back to its stored edge.
+ *
+ * A graph made by graphReorder() stores vertex slots instead of the
+ * caller's vertex IDs: vertex v lives in slot position[v] and slot p
+ * holds vertex vertexAt[p]. Its edges are sorted by slot and inputEdge[i]
+ * is the caller's index of stored edge i. The algorithms run on slots and
+ * the public functions translate at the boundary. All three arrays are
+ * NULL for a graph in input order.
+ *
+ * A graph made by graphCompress() keeps offset[] (so degrees stay O(1))
+ * but drops edges, target, weight, edgeOf and inputEdge. Its arcs are
+ * either packed lists or a bit matrix, read with arcsBegin()/arcsNext().
+ * Packed arcs of u start at byte packedOffset[u]; each is a varint gap
+ * (zigzag of head - u for the first arc, head - previous head after it)
+ * followed by weightBytes little-endian bytes of a weight code. Arc
+ * weight = weightBase + code * weightStep. A matrix has rowWords 64-bit
+ * words per vertex with bit v of row u set for arc u → v.
+ *
+ * A graph from graphCreateTyped() whose weights do not fit int keeps
+ * them in wideEdge (per stored edge) and wideArc (per arc) as its
+ * weightType; edges[].weight and weight[] then hold the weights clamped
+ * to int with their sign kept, so minWeight still tells whether any
+ * weight is negative. widePaths is set when a path sum and wideFlow when
+ * a flow may overflow int; each routes its int kernels to the saturating
+ * ones.
+ */
+struct Graph
+{
+    int n;                      // Number of vertices
+    int edgeCount;              // Number of input edges
+    int arcCount;               // Number of arcs
+    bool directed;              // true for a directed graph
+    int minWeight;              // Smallest edge weight (0 if there are no edges)
+    unsigned long long serial;  // Unique per graph, so workspaces can cache per-graph state
+    struct GraphEdge *edges;    // Edges in input order (slot order if reordered)
+    int *offset;                // Out-arc offsets (n + 1 entries)
+    int *target;                // Head of every arc
+    int *weight;                // Weight of every arc
+    int *edgeOf;                // Stored edge of every arc
+    int *position;              // Slot of every vertex (NULL = identity)
+    int *vertexAt;              // Vertex of every slot (NULL = identity)
+    int *inputEdge;             // Caller's index of every stored edge (NULL = identity)
+    unsigned char *packed;      // Packed arcs of a compressed graph (NULL = not packed)
+    size_t packedBytes;         // Size of packed
+    size_t *packedOffset;       // Byte offset of every vertex's arcs in packed (n + 1 entries)
+    unsigned long long *matrix; // Bit matrix of a compressed graph (NULL = not a matrix)
+    int rowWords;               // Words per matrix row
+    int weightBytes;            // Bytes per packed weight code (0, 1, 2 or 4)
+    int weightBase;             // Weight of code 0 (also the weight of every matrix arc)
+    int weightStep;             // Weight of one code unit (1 = exact)
+    int weightType;             // enum GraphWeightType of the caller's weights
+    void *wideEdge;             // Weight of every stored edge as weightType (NULL = fits int)
+    void *wideArc;              // Weight of every arc as weightType (NULL = fits int)
+    bool widePaths;             // Some path sum may overflow int
+    bool wideFlow;              // Some flow may overflow int
+};
+
+/**
+ * @brief Check whether a graph keeps only compressed arcs
+ * @param graph Graph
+ * @return true if graph came from graphCompress()
+ */
+static inline bool isCompressed(const struct Graph *graph)
+{
+    return graph->packed || graph->matrix;
+}
+
+/**
+ * @brief Get the size of one weight of a type
+ * @param weightType enum GraphWeightType
+ * @return Bytes per weight
+ */
+static inline size_t weightSize(int weightType)
+{
+    return weightType == GRAPH_WEIGHT_INT32 || weightType == GRAPH_WEIGHT_FLOAT ? 4 : 8;
+}
+
+/**
+ * @brief Structure to walk the arcs of one vertex of a compressed graph
+ */
+struct ArcCursor
+{
+    const unsigned char *next;     // Next packed arc
+    const unsigned long long *row; // Matrix row of the vertex
+    unsigned long long bits;       // Matrix bits not returned yet in word
+    int word;                      // Matrix word being read
+    int left;                      // Arcs not returned yet
+    bool first;                    // Next packed gap is the zigzag one
+    int target;                    // Head of the arc returned last
+    int weight;                    // Weight of the arc returned last
+};
+
+/**
+ * @brief Read one LEB128 varint
+ * @param p Read position, advanced past the varint
+ * @return Decoded value
+ */
+static inline unsigned readVarint(const unsigned char **p)
+{
+    unsigned value = *(*p)++;
+    if (value < 0x80)
+    {
+        return value; // Most gaps of a well-ordered graph fit in one byte
+    }
+    value &= 0x7f;
+    for (int shift = 7;; shift += 7)
+    {
+        unsigned byte = *(*p)++;
+        value |= (byte & 0x7f) << shift;
+        if (byte < 0x80)
+        {
+            return value;
+        }
+    }
+}
+
+/**
+ * @brief Start walking the arcs of u on a compressed graph
+ * @param graph Compressed graph
+ * @param u Tail slot
+ * @param cursor Output: cursor before the first arc
+ */
+static inline void arcsBegin(const struct Graph *graph, int u, struct ArcCursor *cursor)
+{
+    bool matrix = graph->matrix != NULL;
+    cursor->next = matrix ? NULL : graph->packed + graph->packedOffset[u];
+    cursor->row = matrix ? graph->matrix + (size_t)u * graph->rowWords : NULL;
+    cursor->bits = matrix && graph->rowWords > 0 ? cursor->row[0] : 0;
+    cursor->word = 0;
+    cursor->left = graph->offset[u + 1] - graph->offset[u];
+    cursor->first = true;
+    cursor->target = u; // The first gap is relative to the tail
+    cursor->weight = graph->weightBase;
+}
+
+/**
+ * @brief Decode the next arc
+ * @param graph Compressed graph
+ * @param cursor Cursor from arcsBegin(); target and weight are set
+ * @param weights false to skip weight codes (BFS)
+ * @return false once every arc has been returned
+ */
+static inline bool arcsNext(const struct Graph *graph, struct ArcCursor *cursor, bool weights)
+{
+    if (cursor->left == 0)
+    {
+        return false;
+    }
+    cursor->left--;
+
+    if (graph->matrix)
+    {
+        while (cursor->bits == 0)
+        {
+            cursor->bits = cursor->row[++cursor->word];
+        }
+        cursor->target = cursor->word * 64 + __builtin_ctzll(cursor->bits);
+        cursor->bits &= cursor->bits - 1;
+        return true;
+    }
+
+    unsigned gap = readVarint(&cursor->next);
+    if (cursor->first)
+    {
+        cursor->target += (int)(gap >> 1) ^ -(int)(gap & 1); // Undo the zigzag
+        cursor->first = false;
+    }
+    else
+    {
+        cursor->target += (int)gap;
+    }
+
+    if (graph->weightBytes == 0)
+    {
+        return true;
+    }
+    if (weights)
+    {
+        const unsigned char *w = cursor->next;
+        unsigned code = w[0];
+        if (graph->weightBytes >= 2)
+        {
+            code |= (unsigned)w[1] << 8;
+        }
+        if (graph->weightBytes == 4)
+        {
+            code |= (unsigned)w[2] << 16 | (unsigned)w[3] << 24;
+        }
+        cursor->weight = (int)((unsigned)graph->weightBase + code * (unsigned)graph->weightStep);
+    }
+    cursor->next += graph->weightBytes;
+    return true;
+}
+
+/**
+ * @brief Structure of a workspace: an arena for per-query scratch arrays
+ *        plus state that survives between queries
+ *
+ * Every query starts with wsBegin(), which rewinds the arena. Arrays are
+ * carved from one block; if a query needs more, the extra blocks are
+ * merged into one bigger block at the next rewind, so a workspace stops
+ * allocating once it has seen its largest query. Marks are stamped with
+ * an epoch that is raised per use instead of clearing n flags.
+ */
+struct GraphWorkspace
+{
+    unsigned char *block;          // Arena block
+    size_t capacity;               // Size of the arena block
+    size_t used;                   // Bytes of the block handed out since the last rewind
+    size_t overflow;               // Bytes handed out from extra blocks since the last rewind
+    void *extra;                   // Extra blocks of this query (linked through their first bytes)
+    unsigned *stamp;               // Epoch stamps of the marks
+    int stampCount;                // Number of stamps allocated
+    unsigned epoch;                // Current epoch of the marks
+    long long allocations;         // System allocations made so far
+    struct BfsEngine *bfs;         // Cached BFS engine
+    unsigned long long inSerial;   // Graph whose in-arcs are cached (0 = none)
+    int *inOffset;                 // Cached in-arc offsets
+    int *inSource;                 // Cached in-arc tails
+    int *inArc;                    // Cached out-arc index of every in-arc
+    unsigned long long flowSerial; // Graph whose flow network is cached (0 = none)
+    struct FlowNetwork *flow;      // Cached flow network (keeps its last flow)
+    int *edgeArc;                  // Arc of every edge of the cached flow network
+    struct GraphStats stats;       // Counters and phase times (GRAPH_STATS builds only)
+    int phase;                     // Phase being timed (GRAPH_PHASE_COUNT = none)
+    double phaseStart;             // Start of that phase in milliseconds
+};
+
+/*
+ * Instrumentation hooks. Without -DGRAPH_STATS they expand to nothing
+ * (the stats pointer is only evaluated to keep -Wextra quiet), so the
+ * default build has no counting in any hot loop.
+ */
+#ifdef GRAPH_STATS
+#define STAT_ADD(stats, counter, amount) ((stats)->counter += (amount))
+#define STAT_PHASE(workspace, phase) wsPhase(workspace, phase)
+#else
+#define STAT_ADD(stats, counter, amount) ((void)(stats))
+#define STAT_PHASE(workspace, phase) ((void)(workspace))
+#endif
+
+/*
+ * Trace points. GRAPH_TRACE is the most detailed level compiled in
+ * (default 0: none); points above it expand to nothing, arguments
+ * included. Compiled-in points cost one load and compare while the
+ * runtime level is lower. Arguments after the event are a printf format
+ * for the remaining JSON members and its values.
+ */
+#ifndef GRAPH_TRACE
+#define GRAPH_TRACE 0
+#endif
+
+extern int traceLevel; // Runtime level set by graphTraceSet()
+
+#define TRACE_AT(level, ...) \
+    (traceLevel >= (level) ? traceEvent((level), __VA_ARGS__) : (void)0)
+
+#if GRAPH_TRACE >= 1
+#define TRACE_INFO(...) TRACE_AT(GRAPH_TRACE_INFO, __VA_ARGS__)
+#else
+#define TRACE_INFO(...) ((void)0)
+#endif
+
+#if GRAPH_TRACE >= 2
+#define TRACE_DEBUG(...) TRACE_AT(GRAPH_TRACE_DEBUG, __VA_ARGS__)
+#else
+#define TRACE_DEBUG(...) ((void)0)
+#endif
+
+#if GRAPH_TRACE >= 3
+#define TRACE_VERBOSE(...) TRACE_AT(GRAPH_TRACE_VERBOSE, __VA_ARGS__)
+#else
+#define TRACE_VERBOSE(...) ((void)0)
+#endif
+
+/**
+ * @brief Append one trace record to the trace buffer
+ * @param level enum GraphTraceLevel of the record
+ * @param algorithm Algorithm emitting it
+ * @param event Event name
+ * @param format printf format of the remaining JSON members (without
+ *               braces or a leading comma), then its arguments
+ */
+void traceEvent(int level, const char *algorithm, const char *event, const char *format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+/**
+ * @brief Charge the time since the last phase change to the running
+ *        phase and start timing the next one
+ * @param workspace Workspace of the query (may be NULL)
+ * @param phase Next enum GraphPhase, or GRAPH_PHASE_COUNT to stop timing
+ */
+void wsPhase(struct GraphWorkspace *workspace, int phase);
+
+/**
+ * @brief Start a query: rewind a workspace, or create one for this call
+ * @param workspace Caller's workspace (may be NULL)
+ * @param owned Output: the workspace to pass to wsEnd() (NULL if the
+ *              caller's workspace is used)
+ * @return Workspace to use, or NULL if memory ran out
+ */
+struct GraphWorkspace *wsBegin(struct GraphWorkspace *workspace, struct GraphWorkspace **owned);
+
+/**
+ * @brief End a query started with wsBegin()
+ * @param owned Workspace created by wsBegin() (may be NULL)
+ */
+void wsEnd(struct GraphWorkspace *owned);
+
+/**
+ * @brief Carve a 64-byte aligned array from the arena
+ *
+ * The array stays valid until the next wsBegin() on the workspace.
+ *
+ * @param workspace Workspace
+ * @param bytes Size of the array
+ * @return Array, or NULL if memory ran out
+ */
+void *wsAlloc(struct GraphWorkspace *workspace, size_t bytes);
+
+/**
+ * @brief Get a fresh set of n marks in O(1)
+ *
+ * Vertex v is marked iff stamp[v] == epoch. Setting stamp[v] = epoch
+ * marks it. Taking new marks unmarks every vertex, so a query can hold
+ * only one set at a time.
+ *
+ * @param workspace Workspace
+ * @param n Number of marks
+ * @param epoch Output: epoch of the new marks
+ * @return Stamp array, or NULL if memory ran out
+ */
+unsigned *wsMarks(struct GraphWorkspace *workspace, int n, unsigned *epoch);
+
+/**
+ * @brief Get a BFS engine for n vertices and the given number of parts per level
+ * @param workspace Workspace (keeps the engine for later queries)
+ * @param n Number of vertices
+ * @param threads Number of parts per level (0 = threads of the shared pool)
+ * @return Engine, or NULL if memory ran out
+ */
+struct BfsEngine *wsBfsEngine(struct GraphWorkspace *workspace, int n, int threads);
+
+/**
+ * @brief Get the in-arcs of a directed graph
+ * @param workspace Workspace (keeps them for later queries on the graph)
+ * @param graph Directed graph
+ * @return false if memory ran out; otherwise inOffset, inSource and
+ *         inArc of the workspace hold the in-arcs
+ */
+bool wsInArcs(struct GraphWorkspace *workspace, const struct Graph *graph);
+
+/**
+ * @brief Get the flow network of a graph
+ *
+ * The network is kept with its last flow, so a repeated query with the
+ * same terminals is answered without augmenting.
+ *
+ * @param workspace Workspace (keeps the network for later queries)
+ * @param graph Graph with non-negative weights
+ * @return Network, or NULL if memory ran out; edgeArc of the workspace
+ *         holds the arc of every stored edge
+ */
+struct FlowNetwork *wsFlowNetwork(struct GraphWorkspace *workspace, const struct Graph *graph);
+
+/**
+ * @brief Loop body of a parallel loop
+ * @param context Pointer given to poolFor()
+ * @param chunk Chunk to run, 0 .. chunks - 1
+ */
+typedef void (*PoolChunkFn)(void *context, int chunk);
+
+/**
+ * @brief Loop body of a parallel sum
+ * @param context Pointer given to poolSum()
+ * @param chunk Chunk to run, 0 .. chunks - 1
+ * @return Value of the chunk
+ */
+typedef long long (*PoolSumFn)(void *context, int chunk);
+
+/**
+ * @brief Get the number of threads of the shared pool
+ * @return Threads running tasks, the calling thread included
+ */
+int poolThreads(void);
+
+/**
+ * @brief Get the number of NUMA nodes the pinned workers of the shared pool span
+ *
+ * Starts the pool if it is not running yet.
+ *
+ * @return Nodes spanned, 1 if the workers are not pinned
+ */
+int poolNodes(void);
+
+/**
+ * @brief Run run(context, chunk) for every chunk on the shared pool
+ *
+ * Returns when every chunk is done. The calling thread runs chunks too,
+ * so a loop body may start parallel loops of its own.
+ *
+ * @param chunks Number of chunks
+ * @param run Loop body
+ * @param context Argument of the loop body
+ */
+void poolFor(int chunks, PoolChunkFn run, void *context);
+
+/**
+ * @brief Sum run(context, chunk) over every chunk on the shared pool
+ * @param chunks Number of chunks
+ * @param run Loop body
+ * @param context Argument of the loop body
+ * @return Sum of the values of all chunks
+ */
+long long poolSum(int chunks, PoolSumFn run, void *context);
+
+/**
+ * @brief Get the first index of a chunk when count items are split evenly
+ * @param count Number of items
+ * @param chunks Number of chunks
+ * @param chunk Chunk, 0 .. chunks (chunks gives count)
+ * @return First item of the chunk
+ */
+static inline int chunkStart(int count, int chunks, int chunk)
+{
+    return (int)((long long)count * chunk / chunks);
+}
+
+/**
+ * @brief Get a serial number no other graph has had
+ * @return New serial
+ */
+unsigned long long newGraphSerial(void);
+
+/**
+ * @brief Allocate an empty graph with room for its edges and arcs
+ * @param n Number of vertices
+ * @param edgeCount Number of edges
+ * @param directed true for a directed graph
+ * @return Graph with uninitialized arrays, or NULL if memory ran out
+ */
+struct Graph *allocGraph(int n, int edgeCount, bool directed);
+
+/**
+ * @brief Build the CSR arcs of a graph whose edge list is filled in
+ * @param graph Graph from allocGraph()
+ */
+void buildArcs(struct Graph *graph);
+
+/**
+ * @brief Set widePaths and wideFlow from the arc weights of a graph
+ * @param graph CSR or compressed graph with its arcs in place
+ */
+void markWideSums(struct Graph *graph);
+
+/**
+ * @brief Read all of a byte range, retrying short and interrupted reads
+ * @param fd Source
+ * @param data Output: bytes read
+ * @param length Number of bytes
+ * @return true on success, false on an error or early end of file
+ */
+bool readAll(int fd, void *data, size_t length);
+
+/**
+ * @brief Write all of a byte range, retrying short and interrupted writes
+ * @param fd Destination
+ * @param data Bytes to write
+ * @param length Number of bytes
+ * @return true on success
+ */
+bool writeAll(int fd, const void *data, size_t length);
+
+/**
+ * @brief Read a monotonic clock
+ * @return Current time in milliseconds
+ */
+double nowMs(void);
+
+/*
+ * Checkpoints (checkpoint.c): a struct Checkpointer holds the snapshot a
+ * run resumes from and the thread that writes new ones. Solvers restore
+ * their state once, then offer it between passes or augmenting paths.
+ */
+struct Checkpointer;
+
+/**
+ * @brief Saturating int32 kernels for graphs whose path sums may overflow int
+ *
+ * Same contract as the slot kernels of shortest_path.c and flow.c, with
+ * every sum clamped to ±GRAPH_INF (see weight_kernels.h). The callers
+ * turn a clamped distance of a reachable vertex into GRAPH_OVERFLOW.
+ *
+ * @param graph Graph with widePaths set
+ * @param workspace Workspace of a running query
+ * @param source Source slot
+ * @param dist Output: n distances by slot
+ * @param parent Output: n parent slots by slot (may be NULL)
+ * @return GRAPH_OK, GRAPH_NEGATIVE_CYCLE (Bellman-Ford) or GRAPH_NO_MEMORY
+ */
+int saturatingDijkstra(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                       int dist[], int parent[]);
+int saturatingBellmanFord(const struct Graph *graph, struct GraphWorkspace *workspace,
+                          int source, int dist[], int parent[]);
+
+/**
+ * @brief Saturating int32 max flow for graphs whose capacity sums may overflow int
+ * @param graph Graph with wideFlow set
+ * @param workspace Workspace of a running query
+ * @param source Source slot
+ * @param sink Sink slot
+ * @param flow Output: flow value, at most GRAPH_INF
+ * @param edgeFlow Output: flow of every stored edge (may be NULL)
+ * @param checkpoint Checkpointer (NULL = none)
+ * @return GRAPH_OK, GRAPH_OVERFLOW (flow above GRAPH_INF), GRAPH_NO_MEMORY or the
+ *         failure of checkpointRestore()
+ */
+int saturatingMaxFlow(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                      int sink, int *flow, int edgeFlow[], struct Checkpointer *checkpoint);
+
+/**
+ * @brief Copy the snapshot a run resumes from into the solver's arrays
+ * @param checkpoint Checkpointer of the run
+ * @param count Values per array the solver expects
+ * @param first Output: first array (count values)
+ * @param second Output: second array (count values; NULL for one-array snapshots)
+ * @param progress Output: progress of the snapshot, -1 if there is none to resume
+ * @return GRAPH_OK, or GRAPH_INVALID_ARGUMENT if the snapshot does not fit
+ */
+int checkpointRestore(struct Checkpointer *checkpoint, int count, int first[], int second[],
+                      long long *progress);
+
+/**
+ * @brief Check whether the checkpoint interval has passed
+ * @param checkpoint Checkpointer of the run
+ * @return true if checkpointSave() should be called now
+ */
+bool checkpointDue(struct Checkpointer *checkpoint);
+
+/**
+ * @brief Hand the solver state to the writer thread
+ *
+ * Copies the arrays and returns at once; the state is dropped if the
+ * previous snapshot is still being written.
+ *
+ * @param checkpoint Checkpointer of the run
+ * @param progress Completed passes or flow value
+ * @param count Values per array
+ * @param first First array
+ * @param second Second array (NULL for one-array snapshots)
+ */
+void checkpointSave(struct Checkpointer *checkpoint, long long progress, int count,
+                    const int first[], const int second[]);
+
+/**
+ * @brief Bellman-Ford on the slots of a graph with optional checkpoints
+ * @param graph Graph (sums clamp to ±GRAPH_INF if widePaths is set)
+ * @param workspace Workspace of a running query
+ * @param source Source slot
+ * @param dist Output: n distances by slot
+ * @param parent Output: n parent slots by slot (may be NULL without checkpoints)
+ * @param checkpoint Checkpointer (NULL = none)
+ * @return GRAPH_OK, GRAPH_NEGATIVE_CYCLE, GRAPH_OVERFLOW (widePaths only) or the
+ *         failure of checkpointRestore()
+ */
+int bellmanFordCheckpointed(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                            int dist[], int parent[], struct Checkpointer *checkpoint);
+
+/**
+ * @brief graphMaxFlowWs() with optional checkpoints of the residual capacities
+ * @param graph Graph
+ * @param workspace Workspace (NULL = temporary)
+ * @param source Source vertex
+ * @param sink Sink vertex
+ * @param flow Output: maximum flow value
+ * @param edgeFlow Output: flow on every input edge (may be NULL)
+ * @param checkpoint Checkpointer (NULL = none)
+ * @return As graphMaxFlowWs(), or the failure of checkpointRestore()
+ */
+int maxFlowCheckpointed(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                        int sink, int *flow, int edgeFlow[], struct Checkpointer *checkpoint);
+
+/**
+ * @brief Translate a caller's vertex ID to its slot
+ * @param graph Graph
+ * @param v Vertex ID
+ * @return Slot of v
+ */
+static inline int vertexSlot(const struct Graph *graph, int v)
+{
+    return graph->position ? graph->position[v] : v;
+}
+
+/**
+ * @brief Translate a slot back to the caller's vertex ID
+ * @param graph Graph
+ * @param p Slot
+ * @return Vertex stored in slot p
+ */
+static inline int slotVertex(const struct Graph *graph, int p)
+{
+    return graph->vertexAt ? graph->vertexAt[p] : p;
+}
+
+/**
+ * @brief Get an array an algorithm can fill per slot
+ *
+ * For a graph in input order this is the caller's array itself; for a
+ * reordered graph it is an arena array that exportSlots() later copies
+ * to the caller's array.
+ *
+ * @param graph Graph
+ * @param workspace Workspace of the query
+ * @param out Caller's output array of n entries (may be NULL)
+ * @return Array of n entries, or NULL if out is NULL or memory ran out
+ */
+int *slotArray(const struct Graph *graph, struct GraphWorkspace *workspace, int out[]);
+
+/**
+ * @brief Copy per-slot results to the caller's array in vertex order
+ *
+ * Does nothing if slots is the caller's array.
+ *
+ * @param graph Graph
+ * @param slots Array from slotArray() (may be NULL)
+ * @param out Caller's output array
+ * @param vertexValues true if the values are slots themselves (parents),
+ *                     which are translated back as well (-1 is kept)
+ */
+void exportSlots(const struct Graph *graph, int slots[], int out[], bool vertexValues);
+
+/**
+ * @brief Structure to represent an indexed binary min-heap of vertices
+ *
+ * Every vertex is in the heap at most once and its key can be lowered in
+ * place, so the heap never holds more than n entries. A vertex is known
+ * to the heap once its stamp carries the heap's epoch, so starting a
+ * heap costs O(1) instead of clearing n positions.
+ */
+struct VertexHeap
+{
+    int size;        // Number of vertices in the heap
+    int *vertex;     // Heap-ordered vertices
+    int *position;   // position[v] = index of v in vertex[], -1 once popped
+    unsigned *stamp; // stamp[v] == epoch once v has been inserted
+    unsigned epoch;  // Epoch of this heap's marks
+    const int *key;  // Keys of all vertices (dist[] or key[] of the caller)
+    struct GraphStats *stats; // Statistics of the workspace the heap lives in
+};
+
+/**
+ * @brief Set up an empty heap for n vertices in a workspace
+ *
+ * Takes the workspace's marks (see wsMarks()).
+ *
+ * @param heap Heap to initialize
+ * @param workspace Workspace of the query
+ * @param n Number of vertices
+ * @param key Key array the heap orders by
+ * @return false if memory ran out
+ */
+bool heapInit(struct VertexHeap *heap, struct GraphWorkspace *workspace, int n, const int key[]);
+
+/**
+ * @brief Check whether a vertex has already been popped
+ * @param heap Heap
+ * @param v Vertex
+ * @return true if v was inserted and then removed by heapPopMin()
+ */
+static inline bool heapPopped(const struct VertexHeap *heap, int v)
+{
+    return heap->stamp[v] == heap->epoch && heap->position[v] == -1;
+}
+
+/**
+ * @brief Insert v, or restore heap order after key[v] was lowered
+ * @param heap Heap
+ * @param v Vertex
+ */
+void heapDecrease(struct VertexHeap *heap, int v);
+
+/**
+ * @brief Remove and return the vertex with the smallest key
+ * @param heap Non-empty heap
+ * @return Vertex with the smallest key
+ */
+int heapPopMin(struct VertexHeap *heap);
+
+#endif // GRAPH_INTERNAL_H
@@ -0,0 +1,242 @@
+/**
+ * @file graph_output.c
+ * @brief Bulk output of shortest-path results and on-demand paths
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Text output formats integers by hand into one large buffer; printf()
+ * costs more per number than the search spends per vertex. Binary
+ * output hands the caller's arrays straight to write().
+ *
+ * Time Complexity: O(V) per result, O(path length) per path
+ * Space Complexity: O(OUTPUT_BUFFER_SIZE)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph_internal.h"
+#include "graph_output.h"
+
+#define OUTPUT_BUFFER_SIZE (1 << 20) // Bytes formatted before each write()
+#define OUTPUT_LINE_MAX 64           // Longest line graphWriteResult() formats
+
+/**
+ * @brief Structure to hold a text output buffer
+ */
+struct OutputBuffer
+{
+    int fd;     // Destination
+    char *data; // OUTPUT_BUFFER_SIZE bytes
+    int used;   // Bytes not written yet
+    bool ok;    // false once a write failed
+};
+
+/**
+ * @brief Write the buffered text and empty the buffer
+ * @param out Buffer
+ */
+static void flushBuffer(struct OutputBuffer *out)
+{
+    if (out->ok && out->used > 0)
+    {
+        out->ok = writeAll(out->fd, out->data, out->used);
+    }
+    out->used = 0;
+}
+
+/**
+ * @brief Make room for at least bytes more characters
+ * @param out Buffer
+ * @param bytes Characters about to be appended (<= OUTPUT_BUFFER_SIZE)
+ */
+static void reserve(struct OutputBuffer *out, int bytes)
+{
+    if (out->used + bytes > OUTPUT_BUFFER_SIZE)
+    {
+        flushBuffer(out);
+    }
+}
+
+/**
+ * @brief Append a decimal integer (room must be reserved)
+ * @param out Buffer
+ * @param value Integer
+ */
+static void putInt(struct OutputBuffer *out, int value)
+{
+    char digits[12];
+    int count = 0;
+    unsigned magnitude = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+
+    do
+    {
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (value < 0)
+    {
+        out->data[out->used++] = '-';
+    }
+    while (count > 0)
+    {
+        out->data[out->used++] = digits[--count];
+    }
+}
+
+/**
+ * @brief Append a distance, "inf" for unreachable (room must be reserved)
+ * @param out Buffer
+ * @param dist Distance
+ */
+static void putDist(struct OutputBuffer *out, int dist)
+{
+    if (dist == GRAPH_INF)
+    {
+        memcpy(out->data + out->used, "inf", 3);
+        out->used += 3;
+    }
+    else
+    {
+        putInt(out, dist);
+    }
+}
+
+/**
+ * @brief Append one character (room must be reserved)
+ * @param out Buffer
+ * @param c Character
+ */
+static void putChar(struct OutputBuffer *out, char c)
+{
+    out->data[out->used++] = c;
+}
+
+int graphWriteResult(int fd, int format, int n, int source, const int dist[], const int parent[])
+{
+    if (fd < 0 || n < 0 || !dist || (format != GRAPH_OUTPUT_TEXT && format != GRAPH_OUTPUT_BINARY))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    if (format == GRAPH_OUTPUT_BINARY)
+    {
+        struct GraphResultHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, GRAPH_RESULT_MAGIC, 8);
+        header.version = GRAPH_RESULT_VERSION;
+        header.byteOrder = GRAPH_RESULT_BYTE_ORDER;
+        header.flags = parent ? GRAPH_RESULT_PARENTS : 0;
+        header.source = source;
+        header.vertices = (uint64_t)n;
+
+        bool ok = writeAll(fd, &header, sizeof(header)) &&
+                  writeAll(fd, dist, (size_t)n * sizeof(int)) &&
+                  (!parent || writeAll(fd, parent, (size_t)n * sizeof(int)));
+        return ok ? GRAPH_OK : GRAPH_IO_ERROR;
+    }
+
+    struct OutputBuffer out = {fd, malloc(OUTPUT_BUFFER_SIZE), 0, true};
+    if (!out.data)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    for (int v = 0; v < n && out.ok; v++)
+    {
+        reserve(&out, OUTPUT_LINE_MAX);
+        putInt(&out, v);
+        putChar(&out, ' ');
+        putDist(&out, dist[v]);
+        putChar(&out, ' ');
+        putInt(&out, parent ? parent[v] : -1);
+        putChar(&out, '\n');
+    }
+    flushBuffer(&out);
+
+    free(out.data);
+    return out.ok ? GRAPH_OK : GRAPH_IO_ERROR;
+}
+
+int graphPathTo(int n, const int parent[], int target, int path[], int *length)
+{
+    if (!parent || !path || !length || target < 0 || target >= n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    // Walk up to the root; more than n steps means parent[] has a cycle
+    int count = 0;
+    for (int v = target; v != -1; v = parent[v])
+    {
+        if (count == n || v < 0 || v >= n)
+        {
+            return GRAPH_INVALID_ARGUMENT;
+        }
+        path[count++] = v;
+    }
+
+    for (int i = 0, j = count - 1; i < j; i++, j--)
+    {
+        int tmp = path[i];
+        path[i] = path[j];
+        path[j] = tmp;
+    }
+    *length = count;
+    return GRAPH_OK;
+}
+
+int graphWritePaths(int fd, int n, const int dist[], const int parent[], const int targets[],
+                    int count)
+{
+    if (fd < 0 || n < 0 || !dist || !parent || count < 0 || (count > 0 && !targets))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    struct OutputBuffer out = {fd, malloc(OUTPUT_BUFFER_SIZE), 0, true};
+    int *path = malloc(n * sizeof(int) + 1);
+    int status = out.data && path ? GRAPH_OK : GRAPH_NO_MEMORY;
+
+    for (int i = 0; i < count && status == GRAPH_OK && out.ok; i++)
+    {
+        int t = targets[i];
+        int length = 0;
+        if (t < 0 || t >= n)
+        {
+            status = GRAPH_INVALID_ARGUMENT;
+            break;
+        }
+        if (dist[t] != GRAPH_INF)
+        {
+            status = graphPathTo(n, parent, t, path, &length);
+        }
+        if (status != GRAPH_OK)
+        {
+            break; // No line for a target whose path cannot be followed
+        }
+
+        reserve(&out, OUTPUT_LINE_MAX);
+        putInt(&out, t);
+        putChar(&out, ' ');
+        putDist(&out, dist[t]);
+        for (int k = 0; k < length; k++)
+        {
+            reserve(&out, 12);
+            putChar(&out, ' ');
+            putInt(&out, path[k]);
+        }
+        reserve(&out, 1);
+        putChar(&out, '\n');
+    }
+    flushBuffer(&out);
+
+    free(out.data);
+    free(path);
+    if (status == GRAPH_OK && !out.ok)
+    {
+        status = GRAPH_IO_ERROR;
+    }
+    return status;
+}
@@ -0,0 +1,333 @@
+/**
+ * @file memory.c
+ * @brief Huge-page and NUMA-aware allocation of the library's large arrays
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Random access over arrays of many gigabytes misses the TLB on almost
+ * every step with 4 KB pages, and on a multi-socket host half of the
+ * accesses go to the other node's memory. Large arrays are therefore
+ * mapped directly: with MAP_HUGETLB from the reserved huge page pool,
+ * or 2 MB aligned and advised with MADV_HUGEPAGE so the kernel backs
+ * them with transparent huge pages. Their pages are then interleaved
+ * over the NUMA nodes with mbind(), or written first by the workers of
+ * the thread pool so each node holds the chunks its workers touched;
+ * that needs workers pinned over several nodes, else pages interleave.
+ *
+ * Every array starts with a 64-byte header recording how it was mapped,
+ * so graphFreeLarge() needs no size and can undo either kind.
+ *
+ * Time Complexity: O(1) per array, O(bytes / threads) for first touch
+ * Space Complexity: up to one huge page of rounding per array
+ */
+
+#define _GNU_SOURCE // For MAP_HUGETLB, MADV_HUGEPAGE and syscall()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "graph_internal.h"
+
+#define MEMORY_HEADER 64                  // Bytes in front of every array (keeps 64-byte alignment)
+#define MEMORY_HUGE_PAGE (2u << 20)       // Huge page size of x86-64 and 4 KB-page arm64
+#define MEMORY_MAX_NODES 64               // Highest NUMA node number looked up
+#define MEMORY_TOUCH_CHUNK (64u << 20)    // Bytes one first-touch task writes at most
+#define MEMORY_MPOL_INTERLEAVE 3          // MPOL_INTERLEAVE of <linux/mempolicy.h>
+
+/**
+ * @brief Structure of the header in front of every large array
+ */
+struct LargeHeader
+{
+    size_t bytes;  // Size the caller asked for
+    size_t mapped; // Length of the mapping, 0 if the array came from malloc()
+    int pages;     // enum GraphPagePolicy in effect
+    int numa;      // enum GraphNumaPolicy in effect
+};
+
+/**
+ * @brief Structure of the region a first-touch task writes
+ */
+struct TouchRegion
+{
+    char *start;  // First byte
+    size_t bytes; // Length
+    int chunks;   // Tasks the region is split into
+};
+
+static struct GraphMemoryConfig memoryConfig = {GRAPH_PAGES_NORMAL, GRAPH_NUMA_LOCAL,
+                                                MEMORY_HUGE_PAGE};
+static long long heldBytes[3];   // Bytes held per enum GraphPagePolicy
+static long long fallbackCount;  // Arrays that got a weaker policy than configured
+static int lastPages = GRAPH_PAGES_NORMAL;
+static int lastNuma = GRAPH_NUMA_LOCAL;
+
+/**
+ * @brief Count the NUMA nodes listed in sysfs (read once)
+ * @return Highest node number plus one (1 without NUMA information)
+ */
+static int nodeCount(void)
+{
+    static int nodes = 0;
+    int known = __atomic_load_n(&nodes, __ATOMIC_RELAXED);
+    if (known > 0)
+    {
+        return known;
+    }
+    int found = 1;
+    for (int node = 1; node < MEMORY_MAX_NODES; node++)
+    {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", node);
+        if (access(path, F_OK) == 0)
+        {
+            found = node + 1;
+        }
+    }
+    __atomic_store_n(&nodes, found, __ATOMIC_RELAXED);
+    return found;
+}
+
+/**
+ * @brief Check whether transparent huge pages are enabled (read once)
+ * @return false if the kernel has no THP support or it is set to "never"
+ */
+static bool transparentAvailable(void)
+{
+    static int state = 0; // 0 = unknown, 1 = available, 2 = not available
+    int known = __atomic_load_n(&state, __ATOMIC_RELAXED);
+    if (known == 0)
+    {
+        char mode[128] = "";
+        FILE *file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+        if (file)
+        {
+            if (!fgets(mode, sizeof(mode), file))
+            {
+                mode[0] = '\0';
+            }
+            fclose(file);
+        }
+        known = file && !strstr(mode, "[never]") ? 1 : 2;
+        __atomic_store_n(&state, known, __ATOMIC_RELAXED);
+    }
+    return known == 1;
+}
+
+/**
+ * @brief Round a size up to a multiple of a power of two
+ * @param bytes Size
+ * @param unit Power of two
+ * @return Rounded size
+ */
+static size_t roundUp(size_t bytes, size_t unit)
+{
+    return (bytes + unit - 1) & ~(unit - 1);
+}
+
+/**
+ * @brief Map anonymous memory starting on a huge page boundary
+ *
+ * Over-maps by one huge page and unmaps the unaligned head and tail, so
+ * the kernel can back the whole range with huge pages.
+ *
+ * @param bytes Length (a multiple of MEMORY_HUGE_PAGE)
+ * @return Mapping, or NULL
+ */
+static void *mapAligned(size_t bytes)
+{
+    char *raw = mmap(NULL, bytes + MEMORY_HUGE_PAGE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+    {
+        return NULL;
+    }
+    char *start = (char *)roundUp((size_t)raw, MEMORY_HUGE_PAGE);
+    size_t head = start - raw;
+    if (head > 0)
+    {
+        munmap(raw, head);
+    }
+    munmap(start + bytes, MEMORY_HUGE_PAGE - head);
+    return start;
+}
+
+/**
+ * @brief Write one chunk of a first-touch region (task of poolFor())
+ * @param context struct TouchRegion
+ * @param chunk Chunk index
+ */
+static void touchChunk(void *context, int chunk)
+{
+    const struct TouchRegion *region = context;
+    size_t pages = region->bytes / MEMORY_HUGE_PAGE;
+    size_t first = pages * chunk / region->chunks;
+    size_t last = pages * (chunk + 1) / region->chunks;
+    memset(region->start + first * MEMORY_HUGE_PAGE, 0, (last - first) * MEMORY_HUGE_PAGE);
+}
+
+/**
+ * @brief Place the pages of a fresh mapping on the NUMA nodes
+ * @param start Mapping (nothing written yet)
+ * @param bytes Length (a multiple of MEMORY_HUGE_PAGE)
+ * @param numa Wanted enum GraphNumaPolicy
+ * @return Policy that took effect
+ */
+static int placePages(char *start, size_t bytes, int numa)
+{
+    int nodes = nodeCount();
+    if (numa == GRAPH_NUMA_LOCAL || nodes < 2)
+    {
+        return GRAPH_NUMA_LOCAL;
+    }
+
+    // Unpinned workers migrate, so their first touch says nothing about
+    // the node: that case is interleaved instead
+    if (numa == GRAPH_NUMA_FIRST_TOUCH && poolNodes() > 1)
+    {
+        int chunks = (int)(bytes / MEMORY_TOUCH_CHUNK) + 1;
+        if (chunks < 4 * poolThreads())
+        {
+            chunks = 4 * poolThreads();
+        }
+        struct TouchRegion region = {start, bytes, chunks};
+        poolFor(region.chunks, touchChunk, &region);
+        return GRAPH_NUMA_FIRST_TOUCH;
+    }
+    unsigned long mask = nodes >= 64 ? ~0UL : (1UL << nodes) - 1;
+    long ok = syscall(SYS_mbind, start, bytes, MEMORY_MPOL_INTERLEAVE, &mask,
+                      (unsigned long)MEMORY_MAX_NODES + 1, 0);
+    return ok == 0 ? GRAPH_NUMA_INTERLEAVE : GRAPH_NUMA_LOCAL;
+}
+
+/**
+ * @brief Map memory with the strongest available page policy
+ * @param bytes Length (a multiple of MEMORY_HUGE_PAGE)
+ * @param pages Wanted enum GraphPagePolicy
+ * @param taken Output: policy that took effect
+ * @return Mapping, or NULL
+ */
+static char *mapPages(size_t bytes, int pages, int *taken)
+{
+    if (pages == GRAPH_PAGES_EXPLICIT)
+    {
+        char *start = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (start != MAP_FAILED)
+        {
+            *taken = GRAPH_PAGES_EXPLICIT;
+            return start;
+        }
+    }
+    if (pages != GRAPH_PAGES_NORMAL && transparentAvailable())
+    {
+        char *start = mapAligned(bytes);
+        if (start && madvise(start, bytes, MADV_HUGEPAGE) == 0)
+        {
+            *taken = GRAPH_PAGES_TRANSPARENT;
+            return start;
+        }
+        if (start)
+        {
+            *taken = GRAPH_PAGES_NORMAL; // Mapped but not advised: still usable
+            return start;
+        }
+    }
+    char *start = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    *taken = GRAPH_PAGES_NORMAL;
+    return start == MAP_FAILED ? NULL : start;
+}
+
+void *graphAllocLarge(size_t bytes)
+{
+    struct GraphMemoryConfig config = memoryConfig;
+    struct LargeHeader *header;
+    bool plain = config.pages == GRAPH_PAGES_NORMAL && config.numa == GRAPH_NUMA_LOCAL;
+    if (plain || bytes < config.threshold)
+    {
+        void *block;
+        if (posix_memalign(&block, MEMORY_HEADER, MEMORY_HEADER + bytes) != 0)
+        {
+            return NULL;
+        }
+        header = block;
+        header->mapped = 0;
+        header->pages = GRAPH_PAGES_NORMAL;
+        header->numa = GRAPH_NUMA_LOCAL;
+    }
+    else
+    {
+        size_t mapped = roundUp(MEMORY_HEADER + bytes, MEMORY_HUGE_PAGE);
+        int pages;
+        header = (struct LargeHeader *)mapPages(mapped, config.pages, &pages);
+        if (!header)
+        {
+            return NULL;
+        }
+        int numa = placePages((char *)header, mapped, config.numa);
+        header->mapped = mapped;
+        header->pages = pages;
+        header->numa = numa;
+        __atomic_store_n(&lastPages, pages, __ATOMIC_RELAXED);
+        __atomic_store_n(&lastNuma, numa, __ATOMIC_RELAXED);
+        if (pages != config.pages || numa != config.numa)
+        {
+            __atomic_add_fetch(&fallbackCount, 1, __ATOMIC_RELAXED);
+        }
+        TRACE_DEBUG("memory", "map", "\"bytes\": %zu, \"pages\": %d, \"numa\": %d", bytes, pages,
+                    numa);
+    }
+    header->bytes = bytes;
+    __atomic_add_fetch(&heldBytes[header->pages], (long long)bytes, __ATOMIC_RELAXED);
+    return (char *)header + MEMORY_HEADER;
+}
+
+void graphFreeLarge(void *array)
+{
+    if (!array)
+    {
+        return;
+    }
+    struct LargeHeader *header = (struct LargeHeader *)((char *)array - MEMORY_HEADER);
+    __atomic_sub_fetch(&heldBytes[header->pages], (long long)header->bytes, __ATOMIC_RELAXED);
+    if (header->mapped == 0)
+    {
+        free(header);
+    }
+    else
+    {
+        munmap(header, header->mapped);
+    }
+}
+
+int graphMemoryConfigure(const struct GraphMemoryConfig *config)
+{
+    if (!config || config->pages < GRAPH_PAGES_NORMAL || config->pages > GRAPH_PAGES_EXPLICIT ||
+        config->numa < GRAPH_NUMA_LOCAL || config->numa > GRAPH_NUMA_FIRST_TOUCH)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    memoryConfig = *config;
+    return GRAPH_OK;
+}
+
+int graphMemoryInfo(struct GraphMemoryInfo *info)
+{
+    if (!info)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    info->pages = __atomic_load_n(&lastPages, __ATOMIC_RELAXED);
+    info->numa = __atomic_load_n(&lastNuma, __ATOMIC_RELAXED);
+    info->nodes = nodeCount();
+    info->transparentAvailable = transparentAvailable();
+    info->normalBytes = __atomic_load_n(&heldBytes[GRAPH_PAGES_NORMAL], __ATOMIC_RELAXED);
+    info->transparentBytes = __atomic_load_n(&heldBytes[GRAPH_PAGES_TRANSPARENT], __ATOMIC_RELAXED);
+    info->explicitBytes = __atomic_load_n(&heldBytes[GRAPH_PAGES_EXPLICIT], __ATOMIC_RELAXED);
+    info->fallbacks = __atomic_load_n(&fallbackCount, __ATOMIC_RELAXED);
+    return GRAPH_OK;
+}
@@ -0,0 +1,634 @@
+/**
+ * @file min_cost_flow.c
+ * @brief Implementation of libgraph's min-cost maximum flow engine
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * The min-cost flow engine finds, among all maximum flows from a source
+ * to a sink, one of minimum total cost. It augments along shortest paths
+ * of the residual graph like Ford-Fulkerson, but measures path length by
+ * edge cost. A Bellman-Ford pass computes initial vertex potentials so
+ * that negative edge costs are allowed, and every later shortest path is
+ * found by Dijkstra's algorithm on the non-negative reduced costs.
+ *
+ * A capacity-scaling variant augments in units of Δ = 2^k, halving Δ
+ * each phase, so the number of augmentations grows with log(U) instead
+ * of with the flow value when capacities are large.
+ *
+ * Time Complexity: O(F (E log V)) successive shortest paths,
+ *                  O(E log U (E log V)) with capacity scaling
+ * Space Complexity: O(V + E)
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "flow.h"
+
+#define COST_INF LLONG_MAX
+
+/**
+ * @brief Structure to represent a binary min-heap of (distance, vertex) pairs
+ */
+struct CostHeap
+{
+    long long *key; // Distance of every entry
+    int *vertex;    // Vertex of every entry
+    int size;       // Number of entries
+};
+
+/**
+ * @brief Structure to hold the scratch arrays of one solve
+ */
+struct CostScratch
+{
+    long long *potential; // Vertex potentials
+    long long *dist;      // Reduced distances of the latest search
+    long long *excess;    // Supply minus demand per vertex (scaling only)
+    int *parentArc;       // Arc used to reach every vertex
+    int *queue;           // BFS queue (scaling only)
+    bool *isSource;       // Start vertices of the latest search
+    struct CostHeap heap; // Heap with room for 2E + V entries
+};
+
+/**
+ * @brief Allocate the scratch arrays of one solve
+ * @param net Cost network
+ * @param scratch Output: scratch arrays
+ * @return true, or false (with nothing allocated) if memory ran out
+ */
+static bool allocScratch(const struct CostNetwork *net, struct CostScratch *scratch)
+{
+    size_t V = net->V, entries = 2 * (size_t)net->E + V;
+    scratch->potential = malloc(V * sizeof(long long) + 1);
+    scratch->dist = malloc(V * sizeof(long long) + 1);
+    scratch->excess = malloc(V * sizeof(long long) + 1);
+    scratch->parentArc = malloc(V * sizeof(int) + 1);
+    scratch->queue = malloc(V * sizeof(int) + 1);
+    scratch->isSource = malloc(V * sizeof(bool) + 1);
+    scratch->heap.key = malloc(entries * sizeof(long long) + 1);
+    scratch->heap.vertex = malloc(entries * sizeof(int) + 1);
+    if (scratch->potential && scratch->dist && scratch->excess && scratch->parentArc &&
+        scratch->queue && scratch->isSource && scratch->heap.key && scratch->heap.vertex)
+    {
+        return true;
+    }
+    free(scratch->potential);
+    free(scratch->dist);
+    free(scratch->excess);
+    free(scratch->parentArc);
+    free(scratch->queue);
+    free(scratch->isSource);
+    free(scratch->heap.key);
+    free(scratch->heap.vertex);
+    return false;
+}
+
+/**
+ * @brief Free the scratch arrays of one solve
+ * @param scratch Scratch arrays from allocScratch()
+ */
+static void freeScratch(struct CostScratch *scratch)
+{
+    free(scratch->potential);
+    free(scratch->dist);
+    free(scratch->excess);
+    free(scratch->parentArc);
+    free(scratch->queue);
+    free(scratch->isSource);
+    free(scratch->heap.key);
+    free(scratch->heap.vertex);
+}
+
+struct CostNetwork *createCostNetwork(int V, int E)
+{
+    if (V < 0 || E < 0)
+    {
+        return NULL;
+    }
+    struct CostNetwork *net = calloc(1, sizeof(struct CostNetwork));
+    if (!net)
+    {
+        return NULL;
+    }
+    size_t arcs = 2 * (size_t)E;
+    net->V = V;
+    net->E = 0;
+    net->maxEdges = E;
+    net->firstOut = malloc(V * sizeof(int) + 1);
+    net->nextOut = malloc(arcs * sizeof(int) + 1);
+    net->head = malloc(arcs * sizeof(int) + 1);
+    net->capacity = malloc(arcs * sizeof(int) + 1);
+    net->residual = malloc(arcs * sizeof(int) + 1);
+    net->cost = malloc(arcs * sizeof(int) + 1);
+    if (!net->firstOut || !net->nextOut || !net->head || !net->capacity || !net->residual ||
+        !net->cost)
+    {
+        freeCostNetwork(net);
+        return NULL;
+    }
+
+    for (int v = 0; v < V; v++)
+    {
+        net->firstOut[v] = -1;
+    }
+    return net;
+}
+
+void freeCostNetwork(struct CostNetwork *net)
+{
+    if (!net)
+    {
+        return;
+    }
+    free(net->firstOut);
+    free(net->nextOut);
+    free(net->head);
+    free(net->capacity);
+    free(net->residual);
+    free(net->cost);
+    free(net);
+}
+
+int addCostEdge(struct CostNetwork *net, int u, int v, int capacity, int cost)
+{
+    if (net->E == net->maxEdges || u < 0 || u >= net->V || v < 0 || v >= net->V || capacity < 0)
+    {
+        return -1;
+    }
+
+    int a = 2 * net->E;
+    net->head[a] = v;
+    net->capacity[a] = capacity;
+    net->residual[a] = capacity;
+    net->cost[a] = cost;
+    net->nextOut[a] = net->firstOut[u];
+    net->firstOut[u] = a;
+
+    net->head[a + 1] = u;
+    net->capacity[a + 1] = 0;
+    net->residual[a + 1] = 0;
+    net->cost[a + 1] = -cost;
+    net->nextOut[a + 1] = net->firstOut[v];
+    net->firstOut[v] = a + 1;
+
+    return net->E++;
+}
+
+int costEdgeFlow(const struct CostNetwork *net, int edge)
+{
+    return net->capacity[2 * edge] - net->residual[2 * edge];
+}
+
+/**
+ * @brief Push an entry onto the heap
+ * @param heap Heap
+ * @param key Distance of the entry
+ * @param vertex Vertex of the entry
+ */
+static void heapPush(struct CostHeap *heap, long long key, int vertex)
+{
+    int i = heap->size++;
+    while (i > 0 && heap->key[(i - 1) / 2] > key)
+    {
+        heap->key[i] = heap->key[(i - 1) / 2];
+        heap->vertex[i] = heap->vertex[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap->key[i] = key;
+    heap->vertex[i] = vertex;
+}
+
+/**
+ * @brief Pop the entry with the smallest distance from the heap
+ * @param heap Non-empty heap
+ * @param key Output: distance of the entry
+ * @return Vertex of the entry
+ */
+static int heapPop(struct CostHeap *heap, long long *key)
+{
+    int top = heap->vertex[0];
+    *key = heap->key[0];
+
+    long long lastKey = heap->key[--heap->size];
+    int lastVertex = heap->vertex[heap->size];
+    int i = 0;
+    while (2 * i + 1 < heap->size)
+    {
+        int child = 2 * i + 1;
+        if (child + 1 < heap->size && heap->key[child + 1] < heap->key[child])
+        {
+            child++;
+        }
+        if (heap->key[child] >= lastKey)
+        {
+            break;
+        }
+        heap->key[i] = heap->key[child];
+        heap->vertex[i] = heap->vertex[child];
+        i = child;
+    }
+    heap->key[i] = lastKey;
+    heap->vertex[i] = lastVertex;
+    return top;
+}
+
+/**
+ * @brief Compute initial vertex potentials with Bellman-Ford
+ *
+ * Every vertex starts at distance 0, as if a virtual source had a
+ * zero-cost edge to it, so the potentials make the reduced cost of every
+ * arc with residual capacity non-negative.
+ *
+ * @param net Cost network
+ * @param potential Output array of V potentials
+ * @return false if the network has a negative-cost cycle, true otherwise
+ */
+static bool initPotentials(const struct CostNetwork *net, long long potential[])
+{
+    int V = net->V;
+
+    for (int v = 0; v < V; v++)
+    {
+        potential[v] = 0;
+    }
+
+    // Relax all arcs V times; the last pass only checks for cycles
+    for (int i = 1; i <= V; i++)
+    {
+        bool updated = false;
+
+        for (int a = 0; a < 2 * net->E; a++)
+        {
+            int u = net->head[a ^ 1];
+            int v = net->head[a];
+
+            if (net->residual[a] > 0 && potential[u] + net->cost[a] < potential[v])
+            {
+                potential[v] = potential[u] + net->cost[a];
+                updated = true;
+            }
+        }
+
+        if (!updated)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Dijkstra's algorithm on reduced costs over arcs with enough residual
+ *
+ * The search starts from every vertex whose flag in isSource is set and
+ * only follows arcs with residual capacity of at least delta.
+ *
+ * @param net Cost network
+ * @param potential Vertex potentials (reduced costs must be non-negative)
+ * @param isSource Flags of the start vertices
+ * @param delta Minimum residual capacity of a usable arc
+ * @param dist Output array of reduced distances (COST_INF if unreachable)
+ * @param parentArc Output array with the arc used to reach every vertex
+ * @param heap Heap with room for 2E + V entries
+ */
+static void dijkstraReduced(const struct CostNetwork *net, const long long potential[],
+                            const bool isSource[], int delta, long long dist[],
+                            int parentArc[], struct CostHeap *heap)
+{
+    heap->size = 0;
+    for (int v = 0; v < net->V; v++)
+    {
+        dist[v] = COST_INF;
+        parentArc[v] = -1;
+        if (isSource[v])
+        {
+            dist[v] = 0;
+            heapPush(heap, 0, v);
+        }
+    }
+
+    while (heap->size > 0)
+    {
+        long long d;
+        int u = heapPop(heap, &d);
+
+        if (d > dist[u])
+        {
+            continue; // Stale heap entry
+        }
+
+        for (int a = net->firstOut[u]; a != -1; a = net->nextOut[a])
+        {
+            int v = net->head[a];
+            if (net->residual[a] < delta)
+            {
+                continue;
+            }
+
+            long long reduced = net->cost[a] + potential[u] - potential[v];
+            if (d + reduced < dist[v])
+            {
+                dist[v] = d + reduced;
+                parentArc[v] = a;
+                heapPush(heap, dist[v], v);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Push flow along the parent arcs from a vertex back to a search root
+ * @param net Cost network
+ * @param parentArc Parent arcs filled by dijkstraReduced()
+ * @param end Last vertex of the path
+ * @param amount Flow to push
+ * @return Cost of pushing the flow
+ */
+static long long pushPath(struct CostNetwork *net, const int parentArc[], int end, int amount)
+{
+    long long pathCost = 0;
+
+    for (int a = parentArc[end]; a != -1; a = parentArc[net->head[a ^ 1]])
+    {
+        net->residual[a] -= amount;
+        net->residual[a ^ 1] += amount;
+        pathCost += net->cost[a];
+    }
+    return pathCost * amount;
+}
+
+/**
+ * @brief Discard the stored flow and check the terminals of a solve
+ * @param net Cost network
+ * @param s Source vertex
+ * @param t Sink vertex
+ * @param result Output: zeroed
+ * @return GRAPH_OK or GRAPH_INVALID_ARGUMENT
+ */
+static int beginSolve(struct CostNetwork *net, int s, int t, struct CostFlowResult *result)
+{
+    if (!net || !result || s < 0 || s >= net->V || t < 0 || t >= net->V)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    memcpy(net->residual, net->capacity, 2 * (size_t)net->E * sizeof(int));
+    result->flow = 0;
+    result->cost = 0;
+    result->augmentations = 0;
+    return GRAPH_OK;
+}
+
+int minCostMaxFlow(struct CostNetwork *net, int s, int t, struct CostFlowResult *result)
+{
+    int status = beginSolve(net, s, t, result);
+    if (status != GRAPH_OK || s == t)
+    {
+        return status;
+    }
+
+    struct CostScratch scratch;
+    if (!allocScratch(net, &scratch))
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    long long *potential = scratch.potential;
+    long long *dist = scratch.dist;
+    int *parentArc = scratch.parentArc;
+    if (!initPotentials(net, potential))
+    {
+        freeScratch(&scratch);
+        return GRAPH_NEGATIVE_CYCLE;
+    }
+
+    int V = net->V;
+    memset(scratch.isSource, false, V * sizeof(bool));
+    scratch.isSource[s] = true;
+
+    while (true)
+    {
+        dijkstraReduced(net, potential, scratch.isSource, 1, dist, parentArc, &scratch.heap);
+        if (dist[t] == COST_INF)
+        {
+            break; // No augmenting path left: the flow is maximum
+        }
+
+        for (int v = 0; v < V; v++)
+        {
+            if (dist[v] != COST_INF)
+            {
+                potential[v] += dist[v];
+            }
+        }
+
+        // Find bottleneck capacity along the cheapest path
+        int pathFlow = INT_MAX;
+        for (int a = parentArc[t]; a != -1; a = parentArc[net->head[a ^ 1]])
+        {
+            if (net->residual[a] < pathFlow)
+            {
+                pathFlow = net->residual[a];
+            }
+        }
+
+        result->cost += pushPath(net, parentArc, t, pathFlow);
+        result->flow += pathFlow;
+        result->augmentations++;
+    }
+
+    freeScratch(&scratch);
+    return GRAPH_OK;
+}
+
+/**
+ * @brief Compute the maximum flow value with BFS augmenting paths
+ *
+ * Used by the scaling variant to size the supply of the source. The
+ * residual capacities are left at the maximum flow.
+ *
+ * @param net Cost network
+ * @param s Source vertex
+ * @param t Sink vertex (not s)
+ * @param parentArc Scratch array of V entries
+ * @param queue Scratch array of V entries
+ * @return Maximum flow value
+ */
+static int maxFlowValue(struct CostNetwork *net, int s, int t, int parentArc[], int queue[])
+{
+    int flow = 0;
+
+    while (true)
+    {
+        int front = 0, rear = 0;
+        for (int v = 0; v < net->V; v++)
+        {
+            parentArc[v] = -2;
+        }
+        parentArc[s] = -1;
+        queue[rear++] = s;
+
+        while (front < rear && parentArc[t] == -2)
+        {
+            int u = queue[front++];
+            for (int a = net->firstOut[u]; a != -1; a = net->nextOut[a])
+            {
+                int v = net->head[a];
+                if (parentArc[v] == -2 && net->residual[a] > 0)
+                {
+                    parentArc[v] = a;
+                    queue[rear++] = v;
+                }
+            }
+        }
+
+        if (parentArc[t] == -2)
+        {
+            return flow;
+        }
+
+        int pathFlow = INT_MAX;
+        for (int a = parentArc[t]; a != -1; a = parentArc[net->head[a ^ 1]])
+        {
+            if (net->residual[a] < pathFlow)
+            {
+                pathFlow = net->residual[a];
+            }
+        }
+        for (int a = parentArc[t]; a != -1; a = parentArc[net->head[a ^ 1]])
+        {
+            net->residual[a] -= pathFlow;
+            net->residual[a ^ 1] += pathFlow;
+        }
+        flow += pathFlow;
+    }
+}
+
+int minCostMaxFlowScaling(struct CostNetwork *net, int s, int t, struct CostFlowResult *result)
+{
+    int status = beginSolve(net, s, t, result);
+    if (status != GRAPH_OK || s == t)
+    {
+        return status;
+    }
+
+    struct CostScratch scratch;
+    if (!allocScratch(net, &scratch))
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    long long *potential = scratch.potential;
+    long long *dist = scratch.dist;
+    long long *excess = scratch.excess;
+    int *parentArc = scratch.parentArc;
+    bool *isSource = scratch.isSource;
+    if (!initPotentials(net, potential))
+    {
+        freeScratch(&scratch);
+        return GRAPH_NEGATIVE_CYCLE;
+    }
+
+    // Step 1: Size the supply with a plain maximum flow, then start from zero
+    int V = net->V;
+    int total = maxFlowValue(net, s, t, parentArc, scratch.queue);
+    memcpy(net->residual, net->capacity, 2 * (size_t)net->E * sizeof(int));
+
+    memset(excess, 0, V * sizeof(long long));
+    excess[s] = total;
+    excess[t] = -total;
+
+    int largest = total;
+    for (int a = 0; a < 2 * net->E; a += 2)
+    {
+        if (net->capacity[a] > largest)
+        {
+            largest = net->capacity[a];
+        }
+    }
+    int delta = 1;
+    while (delta <= largest / 2)
+    {
+        delta *= 2;
+    }
+
+    // Step 2: Scaling phases
+    for (; delta >= 1; delta /= 2)
+    {
+        // Saturate Δ-arcs that violate reduced-cost optimality
+        for (int a = 0; a < 2 * net->E; a++)
+        {
+            int u = net->head[a ^ 1];
+            int v = net->head[a];
+            int r = net->residual[a];
+
+            if (r >= delta && net->cost[a] + potential[u] - potential[v] < 0)
+            {
+                net->residual[a] = 0;
+                net->residual[a ^ 1] += r;
+                excess[u] -= r;
+                excess[v] += r;
+            }
+        }
+
+        // Move Δ units from excess vertices to deficit vertices
+        while (true)
+        {
+            bool anySource = false;
+            for (int v = 0; v < V; v++)
+            {
+                isSource[v] = excess[v] >= delta;
+                anySource = anySource || isSource[v];
+            }
+            if (!anySource)
+            {
+                break;
+            }
+
+            dijkstraReduced(net, potential, isSource, delta, dist, parentArc, &scratch.heap);
+
+            // Cheapest reachable deficit vertex
+            int target = -1;
+            for (int v = 0; v < V; v++)
+            {
+                if (excess[v] <= -delta && dist[v] != COST_INF &&
+                    (target == -1 || dist[v] < dist[target]))
+                {
+                    target = v;
+                }
+            }
+            if (target == -1)
+            {
+                break;
+            }
+
+            // Capping at the target distance keeps every Δ-arc non-negative
+            long long cap = dist[target];
+            for (int v = 0; v < V; v++)
+            {
+                potential[v] += dist[v] < cap ? dist[v] : cap;
+            }
+
+            int origin = target;
+            while (parentArc[origin] != -1)
+            {
+                origin = net->head[parentArc[origin] ^ 1];
+            }
+
+            result->cost += pushPath(net, parentArc, target, delta);
+            excess[origin] -= delta;
+            excess[target] += delta;
+            result->augmentations++;
+        }
+    }
+
+    // The flow may have been routed with cancellations; report its real cost
+    result->flow = total;
+    result->cost = 0;
+    for (int a = 0; a < 2 * net->E; a += 2)
+    {
+        result->cost += (long long)(net->capacity[a] - net->residual[a]) * net->cost[a];
+    }
+
+    freeScratch(&scratch);
+    return GRAPH_OK;
+}
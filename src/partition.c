@@ -0,0 +1,957 @@
+/**
+ * @file partition.c
+ * @brief Partitioned shortest paths and BFS across worker processes
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * The caller splits the vertices by arc count, forks one worker per
+ * range and collects the owned slices of dist[] and parent[] at the
+ * end. Every superstep has two all-to-all exchanges: update batches,
+ * then a small status record with the lowest pending distance and any
+ * failure, so all workers take the same decisions without a master.
+ *
+ * An all-to-all exchange is scheduled as a round-robin tournament: in
+ * every round each worker is paired with one partner (or sits out) and
+ * the lower endpoint sends before it receives. No cycle of blocked
+ * senders can form, so any transport with blocking send and receive
+ * works, whatever its buffer sizes.
+ *
+ * Time Complexity: O(VE / P) per worker for Bellman-Ford, O((V + E) / P)
+ *                  per worker and bucket for delta-stepping and BFS
+ * Space Complexity: O((V + E) / P) per worker
+ */
+
+#define _POSIX_C_SOURCE 200809L // For fork(), socketpair() and MSG_NOSIGNAL
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "graph_file.h"
+#include "graph_internal.h"
+#include "partition.h"
+
+#define PART_RECEIVE_CHUNK 4096 // Updates received and applied at a time
+
+/**
+ * @brief Structure of one distance update for a vertex owned elsewhere
+ */
+struct PartUpdate
+{
+    int vertex; // Global vertex id
+    int dist;   // Candidate distance
+    int parent; // Global id of the vertex it was relaxed from
+};
+
+/**
+ * @brief Structure of the status every worker sends after a superstep
+ */
+struct PartStatus
+{
+    int minPending; // Lowest distance of an active vertex (GRAPH_INF = none)
+    int status;     // GRAPH_OK or the failure of this worker
+};
+
+/**
+ * @brief Structure of the result header a worker sends to the caller
+ */
+struct PartResult
+{
+    int status;         // Agreed status of the run
+    int count;          // Number of owned vertices
+    int arrays;         // 1 if dist (and parent) of the owned vertices follow
+    int supersteps;     // Supersteps run
+    long long updates;  // Updates this worker sent
+    long long messages; // Messages this worker sent to other workers
+    long long bytes;    // Bytes this worker sent to other workers
+};
+
+/**
+ * @brief Structure describing a run; workers inherit it through fork()
+ */
+struct PartRun
+{
+    const char *path;                       // Graph file
+    int n;                                  // Number of vertices
+    int parts;                              // Number of workers
+    int source;                             // Source vertex
+    int delta;                              // Bucket width (0 = Bellman-Ford)
+    bool hops;                              // Unit weights (BFS)
+    bool parents;                           // Send parents back to the caller
+    const int *first;                       // parts + 1 range boundaries
+    const struct GraphTransport *transport; // Message transport
+    void *state;                            // Transport state
+};
+
+/**
+ * @brief Structure of a growing list of outgoing updates
+ */
+struct PartOutbox
+{
+    struct PartUpdate *data; // Updates
+    int count;               // Number of updates
+    int capacity;            // Allocated updates
+};
+
+/**
+ * @brief Structure holding the state of one worker
+ */
+struct Part
+{
+    const struct PartRun *run; // Run description
+    int self;                  // Worker index
+    int lo;                    // First owned vertex
+    int count;                 // Number of owned vertices
+    int *offset;               // count + 1 arc offsets, rebased to 0
+    int *target;               // Global head of every owned arc
+    int *weight;               // Weight of every owned arc (NULL = 1)
+    int *dist;                 // Distance of every owned vertex
+    int *parent;               // Parent of every owned vertex
+    unsigned char *pending;    // Owned vertex waits to be relaxed
+    int *active;               // Pending vertices of this superstep
+    int activeCount;           // Number of active vertices
+    int *next;                 // Pending vertices of the next superstep
+    int nextCount;             // Number of next vertices
+    struct PartOutbox *outbox; // Updates per destination worker
+    int status;                // GRAPH_OK or the first local failure
+    long long updates;         // Updates sent
+    long long messages;        // Messages sent to other workers
+    long long bytes;           // Bytes sent to other workers
+};
+
+/**
+ * @brief Structure of the socket transport state
+ */
+struct SocketTransport
+{
+    int endpoints; // Number of processes
+    int fd[];      // fd[a * endpoints + b]: end of process a towards b, -1 if none
+};
+
+/**
+ * @brief Create a socket pair between every two endpoints
+ * @param endpoints Number of processes
+ * @return Transport state, or NULL if sockets could not be created
+ */
+static void *socketCreate(int endpoints)
+{
+    struct SocketTransport *t =
+        malloc(sizeof(*t) + (size_t)endpoints * endpoints * sizeof(int) + 1);
+    if (!t)
+    {
+        return NULL;
+    }
+    t->endpoints = endpoints;
+    for (int i = 0; i < endpoints * endpoints; i++)
+    {
+        t->fd[i] = -1;
+    }
+    for (int a = 0; a < endpoints; a++)
+    {
+        for (int b = a + 1; b < endpoints; b++)
+        {
+            int pair[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+            {
+                for (int i = 0; i < endpoints * endpoints; i++)
+                {
+                    if (t->fd[i] >= 0)
+                    {
+                        close(t->fd[i]);
+                    }
+                }
+                free(t);
+                return NULL;
+            }
+            t->fd[a * endpoints + b] = pair[0];
+            t->fd[b * endpoints + a] = pair[1];
+        }
+    }
+    return t;
+}
+
+/**
+ * @brief Close the socket ends that belong to other processes
+ * @param state Transport state
+ * @param self Endpoint of the calling process
+ */
+static void socketAttach(void *state, int self)
+{
+    struct SocketTransport *t = state;
+    for (int i = 0; i < t->endpoints * t->endpoints; i++)
+    {
+        if (i / t->endpoints != self && t->fd[i] >= 0)
+        {
+            close(t->fd[i]);
+            t->fd[i] = -1;
+        }
+    }
+}
+
+/**
+ * @brief Send all bytes to one endpoint, retrying short and interrupted sends
+ * @param state Transport state
+ * @param self Endpoint of the calling process
+ * @param to Destination endpoint
+ * @param data Bytes to send
+ * @param bytes Number of bytes
+ * @return 0 on success, -1 if the peer is gone
+ */
+static int socketSend(void *state, int self, int to, const void *data, size_t bytes)
+{
+    struct SocketTransport *t = state;
+    int fd = t->fd[self * t->endpoints + to];
+    const char *p = data;
+    while (bytes > 0)
+    {
+        ssize_t sent = send(fd, p, bytes, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            return -1;
+        }
+        p += sent;
+        bytes -= (size_t)sent;
+    }
+    return 0;
+}
+
+/**
+ * @brief Receive exactly the given number of bytes from one endpoint
+ * @param state Transport state
+ * @param self Endpoint of the calling process
+ * @param from Source endpoint
+ * @param data Output: received bytes
+ * @param bytes Number of bytes
+ * @return 0 on success, -1 if the peer is gone
+ */
+static int socketReceive(void *state, int self, int from, void *data, size_t bytes)
+{
+    struct SocketTransport *t = state;
+    return readAll(t->fd[self * t->endpoints + from], data, bytes) ? 0 : -1;
+}
+
+/**
+ * @brief Close the remaining socket ends and free the state
+ * @param state Transport state
+ * @param self Endpoint of the calling process
+ */
+static void socketDestroy(void *state, int self)
+{
+    struct SocketTransport *t = state;
+    (void)self;
+    for (int i = 0; i < t->endpoints * t->endpoints; i++)
+    {
+        if (t->fd[i] >= 0)
+        {
+            close(t->fd[i]);
+        }
+    }
+    free(t);
+}
+
+const struct GraphTransport graphSocketTransport = {
+    "unix-socket", socketCreate, socketAttach, socketSend, socketReceive, socketDestroy,
+};
+
+/**
+ * @brief Find the partner of a worker in one round of the exchange schedule
+ *
+ * Circle method: with an even number of slots, the last slot meets the
+ * slot of the round and every other pair sums to twice the round.
+ *
+ * @param self Worker index
+ * @param round Round, 0 .. slots - 2
+ * @param parts Number of workers
+ * @return Partner index, or -1 if the worker sits out this round
+ */
+static int partnerOf(int self, int round, int parts)
+{
+    int last = parts + (parts & 1) - 1;
+    int partner;
+    if (self == last)
+    {
+        partner = round;
+    }
+    else if (self == round)
+    {
+        partner = last;
+    }
+    else
+    {
+        partner = ((2 * round - self) % last + last) % last;
+    }
+    return partner < parts ? partner : -1;
+}
+
+/**
+ * @brief Number of rounds of the exchange schedule
+ * @param parts Number of workers
+ * @return Rounds in which every pair of workers meets once
+ */
+static int roundCount(int parts)
+{
+    return parts + (parts & 1) - 1;
+}
+
+/**
+ * @brief Find the worker that owns a vertex
+ * @param run Run description
+ * @param v Global vertex id
+ * @return Worker index
+ */
+static int ownerOf(const struct PartRun *run, int v)
+{
+    int lo = 0;
+    int hi = run->parts - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) / 2;
+        if (run->first[mid] <= v)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Send bytes to another worker and count them
+ * @param part Worker state
+ * @param to Destination worker
+ * @param data Bytes to send
+ * @param bytes Number of bytes
+ * @return 0 on success, -1 on a transport failure
+ */
+static int partSend(struct Part *part, int to, const void *data, size_t bytes)
+{
+    part->messages++;
+    part->bytes += (long long)bytes;
+    return part->run->transport->send(part->run->state, part->self, to, data, bytes);
+}
+
+/**
+ * @brief Lower the distance of an owned vertex and mark it pending
+ * @param part Worker state
+ * @param v Global vertex id (owned by this worker)
+ * @param candidate Candidate distance
+ * @param from Global id of the vertex it was relaxed from
+ */
+static void relaxOwned(struct Part *part, int v, long long candidate, int from)
+{
+    int i = v - part->lo;
+    if (candidate >= part->dist[i])
+    {
+        return;
+    }
+    part->dist[i] = candidate < -GRAPH_INF ? -GRAPH_INF : (int)candidate;
+    part->parent[i] = from;
+    if (!part->pending[i])
+    {
+        part->pending[i] = 1;
+        part->next[part->nextCount++] = i;
+    }
+}
+
+/**
+ * @brief Queue an update for a vertex owned by another worker
+ * @param part Worker state
+ * @param owner Worker owning v
+ * @param v Global vertex id
+ * @param candidate Candidate distance (below GRAPH_INF)
+ * @param from Global id of the vertex it was relaxed from
+ */
+static void queueUpdate(struct Part *part, int owner, int v, long long candidate, int from)
+{
+    struct PartOutbox *box = &part->outbox[owner];
+    if (box->count == box->capacity)
+    {
+        int capacity = box->capacity ? 2 * box->capacity : 256;
+        struct PartUpdate *data = realloc(box->data, capacity * sizeof(struct PartUpdate) + 1);
+        if (!data)
+        {
+            part->status = GRAPH_NO_MEMORY;
+            return;
+        }
+        box->data = data;
+        box->capacity = capacity;
+    }
+    struct PartUpdate *u = &box->data[box->count++];
+    u->vertex = v;
+    u->dist = candidate < -GRAPH_INF ? -GRAPH_INF : (int)candidate;
+    u->parent = from;
+}
+
+/**
+ * @brief Copy the owned slice of the graph file into worker memory
+ * @param part Worker state (run, self, lo and count set)
+ * @return GRAPH_OK, GRAPH_INVALID_ARGUMENT, GRAPH_NEGATIVE_WEIGHT or GRAPH_NO_MEMORY
+ */
+static int loadPart(struct Part *part)
+{
+    const struct PartRun *run = part->run;
+    struct GraphFile file;
+    if (openGraphFile(run->path, &file, false) != GRAPH_FILE_OK || file.n != run->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    // Each worker checks only its own slice, after copying it (see below)
+    int base = file.offset[part->lo];
+    int arcs = file.offset[part->lo + part->count] - base;
+    if (arcs < 0)
+    {
+        closeGraphFile(&file);
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    bool weighted = !run->hops && file.weight;
+    part->offset = malloc((part->count + 1) * sizeof(int));
+    part->target = malloc(arcs * sizeof(int) + 1);
+    part->weight = weighted ? malloc(arcs * sizeof(int) + 1) : NULL;
+    if (!part->offset || !part->target || (weighted && !part->weight))
+    {
+        closeGraphFile(&file);
+        return GRAPH_NO_MEMORY;
+    }
+    for (int i = 0; i <= part->count; i++)
+    {
+        part->offset[i] = file.offset[part->lo + i] - base;
+    }
+    memcpy(part->target, file.target + base, arcs * sizeof(int));
+    if (weighted)
+    {
+        memcpy(part->weight, file.weight + base, arcs * sizeof(int));
+    }
+    closeGraphFile(&file);
+
+    for (int i = 0; i < part->count; i++)
+    {
+        if (part->offset[i] > part->offset[i + 1])
+        {
+            return GRAPH_INVALID_ARGUMENT;
+        }
+    }
+    for (int a = 0; a < arcs; a++)
+    {
+        if (part->target[a] < 0 || part->target[a] >= run->n)
+        {
+            return GRAPH_INVALID_ARGUMENT;
+        }
+    }
+
+    if (weighted && run->delta > 0)
+    {
+        for (int a = 0; a < arcs; a++)
+        {
+            if (part->weight[a] < 0)
+            {
+                return GRAPH_NEGATIVE_WEIGHT;
+            }
+        }
+    }
+
+    part->dist = malloc(part->count * sizeof(int) + 1);
+    part->parent = malloc(part->count * sizeof(int) + 1);
+    part->pending = calloc(part->count + 1, 1);
+    part->active = malloc(part->count * sizeof(int) + 1);
+    part->next = malloc(part->count * sizeof(int) + 1);
+    part->outbox = calloc(run->parts, sizeof(struct PartOutbox));
+    if (!part->dist || !part->parent || !part->pending || !part->active || !part->next ||
+        !part->outbox)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    for (int i = 0; i < part->count; i++)
+    {
+        part->dist[i] = GRAPH_INF;
+        part->parent[i] = -1;
+    }
+    if (run->source >= part->lo && run->source < part->lo + part->count)
+    {
+        relaxOwned(part, run->source, 0, -1);
+    }
+    return GRAPH_OK;
+}
+
+/**
+ * @brief Release the memory of a worker
+ * @param part Worker state
+ */
+static void freePart(struct Part *part)
+{
+    if (part->outbox)
+    {
+        for (int p = 0; p < part->run->parts; p++)
+        {
+            free(part->outbox[p].data);
+        }
+    }
+    free(part->outbox);
+    free(part->offset);
+    free(part->target);
+    free(part->weight);
+    free(part->dist);
+    free(part->parent);
+    free(part->pending);
+    free(part->active);
+    free(part->next);
+}
+
+/**
+ * @brief Relax the active vertices below the bucket limit
+ *
+ * Active vertices at or above the limit stay pending for a later bucket.
+ *
+ * @param part Worker state
+ * @param limit Exclusive distance limit of the current bucket
+ */
+static void relaxActive(struct Part *part, long long limit)
+{
+    const struct PartRun *run = part->run;
+    int *swap = part->active;
+    part->active = part->next;
+    part->next = swap;
+    part->activeCount = part->nextCount;
+    part->nextCount = 0;
+
+    for (int k = 0; k < part->activeCount; k++)
+    {
+        int i = part->active[k];
+        if (part->dist[i] >= limit)
+        {
+            part->next[part->nextCount++] = i;
+            continue;
+        }
+        part->pending[i] = 0;
+        int u = part->lo + i;
+        for (int a = part->offset[i]; a < part->offset[i + 1]; a++)
+        {
+            int v = part->target[a];
+            long long candidate = (long long)part->dist[i] + (part->weight ? part->weight[a] : 1);
+            if (candidate >= GRAPH_INF)
+            {
+                continue;
+            }
+            if (v >= part->lo && v < part->lo + part->count)
+            {
+                relaxOwned(part, v, candidate, u);
+            }
+            else
+            {
+                queueUpdate(part, ownerOf(run, v), v, candidate, u);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Receive one update batch from a partner and apply it
+ * @param part Worker state
+ * @param from Partner worker
+ * @param buffer PART_RECEIVE_CHUNK updates of scratch space
+ * @return 0 on success, -1 on a transport failure
+ */
+static int receiveBatch(struct Part *part, int from, struct PartUpdate *buffer)
+{
+    const struct PartRun *run = part->run;
+    int count;
+    if (run->transport->receive(run->state, part->self, from, &count, sizeof(count)) != 0)
+    {
+        return -1;
+    }
+    while (count > 0)
+    {
+        int chunk = count < PART_RECEIVE_CHUNK ? count : PART_RECEIVE_CHUNK;
+        if (run->transport->receive(run->state, part->self, from, buffer,
+                                    chunk * sizeof(struct PartUpdate)) != 0)
+        {
+            return -1;
+        }
+        for (int k = 0; k < chunk; k++)
+        {
+            relaxOwned(part, buffer[k].vertex, buffer[k].dist, buffer[k].parent);
+        }
+        count -= chunk;
+    }
+    return 0;
+}
+
+/**
+ * @brief Send the queued update batch for a partner
+ * @param part Worker state
+ * @param to Partner worker
+ * @return 0 on success, -1 on a transport failure
+ */
+static int sendBatch(struct Part *part, int to)
+{
+    struct PartOutbox *box = &part->outbox[to];
+    if (partSend(part, to, &box->count, sizeof(box->count)) != 0 ||
+        (box->count > 0 &&
+         partSend(part, to, box->data, box->count * sizeof(struct PartUpdate)) != 0))
+    {
+        return -1;
+    }
+    part->updates += box->count;
+    box->count = 0;
+    return 0;
+}
+
+/**
+ * @brief Exchange the update batches with every other worker
+ * @param part Worker state
+ * @param buffer PART_RECEIVE_CHUNK updates of scratch space
+ * @return 0 on success, -1 on a transport failure
+ */
+static int exchangeUpdates(struct Part *part, struct PartUpdate *buffer)
+{
+    int parts = part->run->parts;
+    for (int round = 0; round < roundCount(parts); round++)
+    {
+        int partner = partnerOf(part->self, round, parts);
+        if (partner < 0)
+        {
+            continue;
+        }
+        bool sendFirst = part->self < partner;
+        if ((sendFirst && sendBatch(part, partner) != 0) ||
+            receiveBatch(part, partner, buffer) != 0 ||
+            (!sendFirst && sendBatch(part, partner) != 0))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Exchange status records and combine them
+ *
+ * All workers see the same records, so all reach the same result: the
+ * lowest pending distance and the failure of the lowest failing worker.
+ *
+ * @param part Worker state
+ * @param own Status of this worker
+ * @param global Output: combined status
+ * @return 0 on success, -1 on a transport failure
+ */
+static int exchangeStatus(struct Part *part, struct PartStatus own, struct PartStatus *global)
+{
+    const struct PartRun *run = part->run;
+    *global = own;
+    int failing = own.status != GRAPH_OK ? part->self : run->parts;
+    for (int round = 0; round < roundCount(run->parts); round++)
+    {
+        int partner = partnerOf(part->self, round, run->parts);
+        if (partner < 0)
+        {
+            continue;
+        }
+        struct PartStatus other;
+        bool sendFirst = part->self < partner;
+        if ((sendFirst && partSend(part, partner, &own, sizeof(own)) != 0) ||
+            run->transport->receive(run->state, part->self, partner, &other, sizeof(other)) != 0 ||
+            (!sendFirst && partSend(part, partner, &own, sizeof(own)) != 0))
+        {
+            return -1;
+        }
+        if (other.minPending < global->minPending)
+        {
+            global->minPending = other.minPending;
+        }
+        if (other.status != GRAPH_OK && partner < failing)
+        {
+            failing = partner;
+            global->status = other.status;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Lowest distance among the pending vertices of a worker
+ * @param part Worker state
+ * @return Distance, or GRAPH_INF if nothing is pending
+ */
+static int minPending(const struct Part *part)
+{
+    int best = GRAPH_INF;
+    for (int k = 0; k < part->nextCount; k++)
+    {
+        int d = part->dist[part->next[k]];
+        best = d < best ? d : best;
+    }
+    return best;
+}
+
+/**
+ * @brief Run one worker from loading its slice to sending its results
+ * @param run Run description
+ * @param self Worker index
+ * @return Process exit code: 0, or 1 on a transport failure
+ */
+static int runPart(const struct PartRun *run, int self)
+{
+    struct Part part = {0};
+    part.run = run;
+    part.self = self;
+    part.lo = run->first[self];
+    part.count = run->first[self + 1] - run->first[self];
+
+    struct PartUpdate *buffer = malloc(PART_RECEIVE_CHUNK * sizeof(struct PartUpdate));
+    int loaded = buffer ? loadPart(&part) : GRAPH_NO_MEMORY;
+    struct PartStatus own = {loaded == GRAPH_OK ? minPending(&part) : GRAPH_INF, loaded};
+    struct PartStatus global;
+    int failed = exchangeStatus(&part, own, &global);
+
+    int supersteps = 0;
+    while (!failed && global.status == GRAPH_OK && global.minPending != GRAPH_INF)
+    {
+        if (run->delta == 0 && supersteps >= run->n)
+        {
+            // Still improving after V supersteps: a path with V arcs got shorter
+            global.status = GRAPH_NEGATIVE_CYCLE;
+            break;
+        }
+        long long limit = LLONG_MAX;
+        if (run->delta > 0)
+        {
+            limit = ((long long)global.minPending / run->delta + 1) * run->delta;
+        }
+        relaxActive(&part, limit);
+        failed = exchangeUpdates(&part, buffer);
+        supersteps++;
+
+        own.minPending = minPending(&part);
+        own.status = part.status;
+        failed = failed || exchangeStatus(&part, own, &global);
+    }
+
+    if (!failed)
+    {
+        bool arrays = loaded == GRAPH_OK;
+        struct PartResult result = {global.status, part.count, arrays, supersteps,
+                                    part.updates, part.messages, part.bytes};
+        const struct GraphTransport *t = run->transport;
+        failed = t->send(run->state, self, run->parts, &result, sizeof(result)) != 0 ||
+                 (arrays && t->send(run->state, self, run->parts, part.dist,
+                                    part.count * sizeof(int)) != 0) ||
+                 (arrays && run->parents &&
+                  t->send(run->state, self, run->parts, part.parent,
+                          part.count * sizeof(int)) != 0);
+    }
+    freePart(&part);
+    free(buffer);
+    return failed ? 1 : 0;
+}
+
+/**
+ * @brief Split the vertices into ranges with about the same number of arcs
+ * @param file Mapped graph file (only the offsets are read)
+ * @param parts Number of ranges
+ * @param first Output: parts + 1 range boundaries
+ */
+static void splitByArcs(const struct GraphFile *file, int parts, int first[])
+{
+    first[0] = 0;
+    for (int p = 1; p < parts; p++)
+    {
+        // Lowest vertex whose arcs start at or after an equal share of the arcs
+        long long share = (long long)file->arcs * p / parts;
+        int lo = first[p - 1];
+        int hi = file->n;
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (file->offset[mid] < share)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        first[p] = lo;
+    }
+    first[parts] = file->n;
+}
+
+/**
+ * @brief Collect the results of every worker
+ * @param run Run description
+ * @param dist Output: n distances
+ * @param parent Output: n parents (may be NULL)
+ * @param report Output: summed counters
+ * @return Agreed status, GRAPH_IO_ERROR on a transport failure or
+ *         GRAPH_NO_MEMORY if a worker lost its results
+ */
+static int collectResults(const struct PartRun *run, int dist[], int parent[],
+                          struct GraphPartitionReport *report)
+{
+    const struct GraphTransport *t = run->transport;
+    int status = GRAPH_OK;
+    for (int p = 0; p < run->parts; p++)
+    {
+        struct PartResult result;
+        int lo = run->first[p];
+        int count = run->first[p + 1] - lo;
+        if (t->receive(run->state, run->parts, p, &result, sizeof(result)) != 0 ||
+            result.count != count)
+        {
+            return GRAPH_IO_ERROR;
+        }
+        if (result.arrays &&
+            (t->receive(run->state, run->parts, p, dist + lo, count * sizeof(int)) != 0 ||
+             (run->parents &&
+              t->receive(run->state, run->parts, p, parent + lo, count * sizeof(int)) != 0)))
+        {
+            return GRAPH_IO_ERROR;
+        }
+        if (!result.arrays && result.status == GRAPH_OK)
+        {
+            result.status = GRAPH_NO_MEMORY;
+        }
+        status = status == GRAPH_OK ? result.status : status;
+        report->supersteps = result.supersteps;
+        report->updates += result.updates;
+        report->messages += result.messages;
+        report->bytes += result.bytes;
+    }
+    return status;
+}
+
+/**
+ * @brief Fork the workers of a run and collect their results
+ * @param path Graph file
+ * @param source Source vertex
+ * @param config Partitioning (may be NULL)
+ * @param hops true for BFS (unit weights, one level per superstep)
+ * @param dist Output: n distances
+ * @param parent Output: n parents (may be NULL)
+ * @param report Output: counters (may be NULL)
+ * @return As graphPartitionedShortestPaths()
+ */
+static int runPartitioned(const char *path, int source, const struct GraphPartitionConfig *config,
+                          bool hops, int dist[], int parent[], struct GraphPartitionReport *report)
+{
+    struct GraphPartitionConfig defaults = {1, 0, NULL};
+    config = config ? config : &defaults;
+    struct GraphFile file;
+    if (!path || !dist || config->parts < 1 || config->delta < 0 ||
+        openGraphFile(path, &file, true) != GRAPH_FILE_OK)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (source < 0 || source >= file.n)
+    {
+        closeGraphFile(&file);
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    struct PartRun run;
+    run.path = path;
+    run.n = file.n;
+    run.parts = config->parts < file.n ? config->parts : file.n;
+    run.source = source;
+    run.delta = hops ? 1 : config->delta;
+    run.hops = hops;
+    run.parents = parent != NULL;
+    run.transport = config->transport ? config->transport : &graphSocketTransport;
+
+    int *first = malloc((run.parts + 1) * sizeof(int));
+    pid_t *pids = malloc(run.parts * sizeof(pid_t));
+    if (!first || !pids)
+    {
+        closeGraphFile(&file);
+        free(first);
+        free(pids);
+        return GRAPH_NO_MEMORY;
+    }
+    splitByArcs(&file, run.parts, first);
+    closeGraphFile(&file);
+    run.first = first;
+
+    run.state = run.transport->create(run.parts + 1);
+    if (!run.state)
+    {
+        free(first);
+        free(pids);
+        return GRAPH_IO_ERROR;
+    }
+
+    int forked = 0;
+    for (; forked < run.parts; forked++)
+    {
+        pids[forked] = fork();
+        if (pids[forked] < 0)
+        {
+            break;
+        }
+        if (pids[forked] == 0)
+        {
+            run.transport->attach(run.state, forked);
+            int code = runPart(&run, forked);
+            run.transport->destroy(run.state, forked);
+            _exit(code);
+        }
+    }
+
+    // Dropping the other ends lets workers waiting on a missing peer see EOF
+    run.transport->attach(run.state, run.parts);
+    struct GraphPartitionReport counters = {run.parts, 0, 0, 0, 0};
+    int status = GRAPH_IO_ERROR;
+    if (forked == run.parts)
+    {
+        status = collectResults(&run, dist, parent, &counters);
+    }
+    run.transport->destroy(run.state, run.parts);
+
+    for (int p = 0; p < forked; p++)
+    {
+        int code = 0;
+        pid_t done;
+        while ((done = waitpid(pids[p], &code, 0)) < 0 && errno == EINTR)
+        {
+        }
+        if (done < 0 || !WIFEXITED(code) || WEXITSTATUS(code) != 0)
+        {
+            status = GRAPH_IO_ERROR;
+        }
+    }
+
+    TRACE_INFO("partition", "done",
+               "\"parts\": %d, \"supersteps\": %d, \"updates\": %lld, \"bytes\": %lld",
+               counters.parts, counters.supersteps, counters.updates, counters.bytes);
+    if (report)
+    {
+        *report = counters;
+    }
+    free(first);
+    free(pids);
+    return status;
+}
+
+int graphPartitionedShortestPaths(const char *path, int source,
+                                  const struct GraphPartitionConfig *config, int dist[],
+                                  int parent[], struct GraphPartitionReport *report)
+{
+    return runPartitioned(path, source, config, false, dist, parent, report);
+}
+
+int graphPartitionedBfs(const char *path, int source, const struct GraphPartitionConfig *config,
+                        int dist[], int parent[], struct GraphPartitionReport *report)
+{
+    return runPartitioned(path, source, config, true, dist, parent, report);
+}
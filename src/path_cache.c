@@ -0,0 +1,576 @@
+/**
+ * @file path_cache.c
+ * @brief Byte-budgeted cache of completed shortest-path trees
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Every tree is keyed by graph version (the graph's serial, which no
+ * other graph ever gets) and source, and lives in one block: a header
+ * followed by n distance codes and n parent codes of the narrowest of 1,
+ * 2 or 4 bytes. A code is the value plus one, so 0 stands for GRAPH_INF
+ * or -1. Trees hang in hash buckets for lookup and in one recency list
+ * for eviction. LRU evicts the oldest tree. LFU evicts the tree with the
+ * lowest priority = age + uses, where age is the priority of the last
+ * tree evicted (LFU with dynamic aging), so trees that were hot for a
+ * replaced graph age out instead of staying forever. The LFU victim is
+ * found by a scan of the list, which only runs on a miss and costs far
+ * less than the Dijkstra search of that miss.
+ *
+ * Time Complexity: O(1) to find a tree, O(V) to copy it out, O(path
+ *                  length) to walk a path, O(entries) per LFU eviction
+ * Space Complexity: at most the byte budget plus the hash buckets
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "graph_internal.h"
+
+#define CACHE_MIN_BUCKETS 64 // Hash buckets of an empty cache
+
+/**
+ * @brief Structure of one cached tree
+ */
+struct CacheEntry
+{
+    unsigned long long serial; // Version of the graph the tree was computed on
+    int source;                // Source vertex
+    int n;                     // Number of vertices
+    int distBytes;             // Bytes per distance code
+    int parentBytes;           // Bytes per parent code
+    long long uses;            // Queries answered by the tree, the miss included
+    long long priority;        // LFU priority at the last use
+    size_t bytes;              // Size of the block
+    struct CacheEntry *newer;  // Next entry towards the most recently used
+    struct CacheEntry *older;  // Next entry towards the least recently used
+    struct CacheEntry *chain;  // Next entry of the same hash bucket
+    unsigned char codes[];     // n distance codes, then n parent codes
+};
+
+/**
+ * @brief Structure of a cache
+ */
+struct GraphPathCache
+{
+    pthread_mutex_t lock;        // Guards everything below
+    int policy;                  // enum GraphCachePolicy
+    long long budget;            // Byte budget
+    long long bytes;             // Bytes of all entries
+    int entries;                 // Number of entries
+    int buckets;                 // Number of hash buckets (a power of two)
+    struct CacheEntry **bucket;  // Hash buckets
+    struct CacheEntry *newest;   // Most recently used entry
+    struct CacheEntry *oldest;   // Least recently used entry
+    long long age;               // LFU priority of the last evicted entry
+    long long hits;              // Queries answered from the cache
+    long long misses;            // Queries that searched
+    long long evictions;         // Entries evicted for space
+};
+
+/**
+ * @brief Choose the code width of a value range
+ * @param maxValue Largest value (codes hold maxValue + 1)
+ * @return Bytes per code (1, 2 or 4)
+ */
+static int codeWidth(long long maxValue)
+{
+    return maxValue + 1 <= 0xff ? 1 : maxValue + 1 <= 0xffff ? 2 : 4;
+}
+
+/**
+ * @brief Read code i of an array
+ * @param codes Code array
+ * @param width Bytes per code
+ * @param i Index
+ * @return Code
+ */
+static inline unsigned readCode(const unsigned char *codes, int width, int i)
+{
+    const unsigned char *p = codes + (size_t)i * width;
+    unsigned code = p[0];
+    if (width >= 2)
+    {
+        code |= (unsigned)p[1] << 8;
+    }
+    if (width == 4)
+    {
+        code |= (unsigned)p[2] << 16 | (unsigned)p[3] << 24;
+    }
+    return code;
+}
+
+/**
+ * @brief Write code i of an array
+ * @param codes Code array
+ * @param width Bytes per code
+ * @param i Index
+ * @param code Code
+ */
+static inline void writeCode(unsigned char *codes, int width, int i, unsigned code)
+{
+    unsigned char *p = codes + (size_t)i * width;
+    for (int b = 0; b < width; b++)
+    {
+        p[b] = (unsigned char)(code >> (8 * b));
+    }
+}
+
+/**
+ * @brief Get the distance of a vertex from a cached tree
+ * @param entry Tree
+ * @param v Vertex
+ * @return Distance, or GRAPH_INF if unreachable
+ */
+static inline int entryDist(const struct CacheEntry *entry, int v)
+{
+    unsigned code = readCode(entry->codes, entry->distBytes, v);
+    return code == 0 ? GRAPH_INF : (int)(code - 1);
+}
+
+/**
+ * @brief Get the parent of a vertex from a cached tree
+ * @param entry Tree
+ * @param v Vertex
+ * @return Parent, or -1
+ */
+static inline int entryParent(const struct CacheEntry *entry, int v)
+{
+    const unsigned char *parents = entry->codes + (size_t)entry->n * entry->distBytes;
+    return (int)readCode(parents, entry->parentBytes, v) - 1;
+}
+
+/**
+ * @brief Pack a shortest-path tree into one block
+ * @param serial Graph version
+ * @param source Source vertex
+ * @param n Number of vertices
+ * @param dist Distances
+ * @param parent Parents
+ * @return Entry (not linked yet), or NULL if memory ran out
+ */
+static struct CacheEntry *packTree(unsigned long long serial, int source, int n, const int dist[],
+                                   const int parent[])
+{
+    int maxDist = 0;
+    for (int v = 0; v < n; v++)
+    {
+        maxDist = dist[v] != GRAPH_INF && dist[v] > maxDist ? dist[v] : maxDist;
+    }
+    int distBytes = codeWidth(maxDist);
+    int parentBytes = codeWidth(n - 1);
+    size_t bytes = sizeof(struct CacheEntry) + (size_t)n * (distBytes + parentBytes);
+
+    struct CacheEntry *entry = malloc(bytes);
+    if (!entry)
+    {
+        return NULL;
+    }
+    entry->serial = serial;
+    entry->source = source;
+    entry->n = n;
+    entry->distBytes = distBytes;
+    entry->parentBytes = parentBytes;
+    entry->uses = 1;
+    entry->bytes = bytes;
+
+    unsigned char *parents = entry->codes + (size_t)n * distBytes;
+    for (int v = 0; v < n; v++)
+    {
+        writeCode(entry->codes, distBytes, v, dist[v] == GRAPH_INF ? 0 : (unsigned)dist[v] + 1);
+        writeCode(parents, parentBytes, v, (unsigned)(parent[v] + 1));
+    }
+    return entry;
+}
+
+/**
+ * @brief Get the hash bucket of a key
+ * @param cache Cache
+ * @param serial Graph version
+ * @param source Source vertex
+ * @return Bucket index
+ */
+static int bucketOf(const struct GraphPathCache *cache, unsigned long long serial, int source)
+{
+    unsigned long long h = (serial * 0x9e3779b97f4a7c15ULL) ^ (unsigned)source;
+    h ^= h >> 29;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    return (int)((h ^ (h >> 32)) & (unsigned)(cache->buckets - 1));
+}
+
+/**
+ * @brief Find the tree of a key
+ * @param cache Locked cache
+ * @param serial Graph version
+ * @param source Source vertex
+ * @return Entry, or NULL if not cached
+ */
+static struct CacheEntry *findEntry(const struct GraphPathCache *cache, unsigned long long serial,
+                                    int source)
+{
+    struct CacheEntry *entry = cache->bucket[bucketOf(cache, serial, source)];
+    while (entry && (entry->serial != serial || entry->source != source))
+    {
+        entry = entry->chain;
+    }
+    return entry;
+}
+
+/**
+ * @brief Take an entry out of the recency list
+ * @param cache Locked cache
+ * @param entry Linked entry
+ */
+static void unlinkRecency(struct GraphPathCache *cache, struct CacheEntry *entry)
+{
+    if (entry->newer)
+    {
+        entry->newer->older = entry->older;
+    }
+    else
+    {
+        cache->newest = entry->older;
+    }
+    if (entry->older)
+    {
+        entry->older->newer = entry->newer;
+    }
+    else
+    {
+        cache->oldest = entry->newer;
+    }
+}
+
+/**
+ * @brief Put an entry at the most recently used end of the list
+ * @param cache Locked cache
+ * @param entry Entry not in the list
+ */
+static void pushNewest(struct GraphPathCache *cache, struct CacheEntry *entry)
+{
+    entry->newer = NULL;
+    entry->older = cache->newest;
+    if (cache->newest)
+    {
+        cache->newest->newer = entry;
+    }
+    else
+    {
+        cache->oldest = entry;
+    }
+    cache->newest = entry;
+}
+
+/**
+ * @brief Record a use of a cached tree
+ * @param cache Locked cache
+ * @param entry Entry
+ */
+static void touchEntry(struct GraphPathCache *cache, struct CacheEntry *entry)
+{
+    entry->uses++;
+    entry->priority = cache->age + entry->uses;
+    unlinkRecency(cache, entry);
+    pushNewest(cache, entry);
+}
+
+/**
+ * @brief Unlink and free an entry
+ * @param cache Locked cache
+ * @param entry Linked entry
+ */
+static void removeEntry(struct GraphPathCache *cache, struct CacheEntry *entry)
+{
+    struct CacheEntry **link = &cache->bucket[bucketOf(cache, entry->serial, entry->source)];
+    while (*link != entry)
+    {
+        link = &(*link)->chain;
+    }
+    *link = entry->chain;
+    unlinkRecency(cache, entry);
+    cache->bytes -= entry->bytes;
+    cache->entries--;
+    free(entry);
+}
+
+/**
+ * @brief Evict the entry the policy gives up first
+ * @param cache Locked, non-empty cache
+ */
+static void evictOne(struct GraphPathCache *cache)
+{
+    struct CacheEntry *victim = cache->oldest;
+    if (cache->policy == GRAPH_CACHE_LFU)
+    {
+        // Strictly lower only, so ties go to the least recently used
+        for (struct CacheEntry *e = victim->newer; e; e = e->newer)
+        {
+            victim = e->priority < victim->priority ? e : victim;
+        }
+        cache->age = victim->priority;
+    }
+    TRACE_DEBUG("path-cache", "evict", "\"source\": %d, \"uses\": %lld", victim->source,
+                victim->uses);
+    removeEntry(cache, victim);
+    cache->evictions++;
+}
+
+/**
+ * @brief Double the hash buckets once entries outnumber them
+ * @param cache Locked cache
+ */
+static void growBuckets(struct GraphPathCache *cache)
+{
+    if (cache->entries <= cache->buckets)
+    {
+        return;
+    }
+    struct CacheEntry **old = cache->bucket;
+    int oldBuckets = cache->buckets;
+    struct CacheEntry **grown = calloc(2 * (size_t)oldBuckets, sizeof(struct CacheEntry *));
+    if (!grown)
+    {
+        return; // Longer chains, still correct
+    }
+    cache->bucket = grown;
+    cache->buckets = 2 * oldBuckets;
+    for (int b = 0; b < oldBuckets; b++)
+    {
+        while (old[b])
+        {
+            struct CacheEntry *entry = old[b];
+            old[b] = entry->chain;
+            int k = bucketOf(cache, entry->serial, entry->source);
+            entry->chain = grown[k];
+            grown[k] = entry;
+        }
+    }
+    free(old);
+}
+
+/**
+ * @brief Add a tree, evicting others until it fits the budget
+ *
+ * A tree larger than the whole budget, or one another thread cached
+ * first, is freed instead.
+ *
+ * @param cache Cache (not locked)
+ * @param entry Packed tree (may be NULL)
+ */
+static void insertEntry(struct GraphPathCache *cache, struct CacheEntry *entry)
+{
+    if (!entry)
+    {
+        return;
+    }
+    pthread_mutex_lock(&cache->lock);
+    if ((long long)entry->bytes > cache->budget || findEntry(cache, entry->serial, entry->source))
+    {
+        pthread_mutex_unlock(&cache->lock);
+        free(entry);
+        return;
+    }
+    while (cache->bytes + (long long)entry->bytes > cache->budget)
+    {
+        evictOne(cache);
+    }
+
+    entry->priority = cache->age + entry->uses;
+    int k = bucketOf(cache, entry->serial, entry->source);
+    entry->chain = cache->bucket[k];
+    cache->bucket[k] = entry;
+    pushNewest(cache, entry);
+    cache->bytes += entry->bytes;
+    cache->entries++;
+    growBuckets(cache);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+int graphPathCacheCreate(long long budget, int policy, struct GraphPathCache **cache)
+{
+    if (!cache || budget < 0 || (policy != GRAPH_CACHE_LRU && policy != GRAPH_CACHE_LFU))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    struct GraphPathCache *c = calloc(1, sizeof(struct GraphPathCache));
+    struct CacheEntry **bucket = calloc(CACHE_MIN_BUCKETS, sizeof(struct CacheEntry *));
+    if (!c || !bucket)
+    {
+        free(c);
+        free(bucket);
+        return GRAPH_NO_MEMORY;
+    }
+    pthread_mutex_init(&c->lock, NULL);
+    c->policy = policy;
+    c->budget = budget;
+    c->buckets = CACHE_MIN_BUCKETS;
+    c->bucket = bucket;
+    *cache = c;
+    return GRAPH_OK;
+}
+
+void graphPathCacheDrop(struct GraphPathCache *cache, const struct Graph *graph)
+{
+    pthread_mutex_lock(&cache->lock);
+    struct CacheEntry *entry = cache->oldest;
+    while (entry)
+    {
+        struct CacheEntry *next = entry->newer;
+        if (!graph || entry->serial == graph->serial)
+        {
+            removeEntry(cache, entry);
+        }
+        entry = next;
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+int graphPathCacheInfo(struct GraphPathCache *cache, struct GraphPathCacheInfo *info)
+{
+    if (!cache || !info)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    pthread_mutex_lock(&cache->lock);
+    info->budget = cache->budget;
+    info->bytes = cache->bytes;
+    info->entries = cache->entries;
+    info->hits = cache->hits;
+    info->misses = cache->misses;
+    info->evictions = cache->evictions;
+    pthread_mutex_unlock(&cache->lock);
+    return GRAPH_OK;
+}
+
+void graphPathCacheFree(struct GraphPathCache *cache)
+{
+    if (!cache)
+    {
+        return;
+    }
+    graphPathCacheDrop(cache, NULL);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->bucket);
+    free(cache);
+}
+
+/**
+ * @brief Look up a tree and count the hit or miss
+ * @param cache Cache (locked on return if the tree was found)
+ * @param graph Graph
+ * @param source Source vertex
+ * @return Entry with the cache still locked, or NULL with it unlocked
+ */
+static struct CacheEntry *lookupLocked(struct GraphPathCache *cache, const struct Graph *graph,
+                                       int source)
+{
+    pthread_mutex_lock(&cache->lock);
+    struct CacheEntry *entry = findEntry(cache, graph->serial, source);
+    if (entry)
+    {
+        cache->hits++;
+        touchEntry(cache, entry);
+        TRACE_DEBUG("path-cache", "hit", "\"source\": %d, \"uses\": %lld", source, entry->uses);
+        return entry;
+    }
+    cache->misses++;
+    pthread_mutex_unlock(&cache->lock);
+    TRACE_DEBUG("path-cache", "miss", "\"source\": %d", source);
+    return NULL;
+}
+
+int graphDijkstraCached(const struct Graph *graph, struct GraphWorkspace *workspace,
+                        struct GraphPathCache *cache, int source, int dist[], int parent[])
+{
+    if (!graph || !cache || !dist || source < 0 || source >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    struct CacheEntry *entry = lookupLocked(cache, graph, source);
+    if (entry)
+    {
+        for (int v = 0; v < graph->n; v++)
+        {
+            dist[v] = entryDist(entry, v);
+        }
+        for (int v = 0; parent && v < graph->n; v++)
+        {
+            parent[v] = entryParent(entry, v);
+        }
+        pthread_mutex_unlock(&cache->lock);
+        return GRAPH_OK;
+    }
+
+    // The tree needs parents even if the caller does not
+    int *treeParent = parent ? parent : malloc(graph->n * sizeof(int) + 1);
+    if (!treeParent)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    int status = graphDijkstraWs(graph, workspace, source, dist, treeParent);
+    if (status == GRAPH_OK)
+    {
+        insertEntry(cache, packTree(graph->serial, source, graph->n, dist, treeParent));
+    }
+    if (treeParent != parent)
+    {
+        free(treeParent);
+    }
+    return status;
+}
+
+int graphShortestPathCached(const struct Graph *graph, struct GraphWorkspace *workspace,
+                            struct GraphPathCache *cache, int source, int target, int path[],
+                            int *length, int *distance)
+{
+    if (!graph || !cache || !path || !length || source < 0 || source >= graph->n || target < 0 ||
+        target >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    struct CacheEntry *entry = lookupLocked(cache, graph, source);
+    int *dist = NULL, *parent = NULL;
+    int status = GRAPH_OK;
+    if (!entry)
+    {
+        dist = malloc(graph->n * sizeof(int) + 1);
+        parent = malloc(graph->n * sizeof(int) + 1);
+        status = dist && parent ? graphDijkstraWs(graph, workspace, source, dist, parent)
+                                : GRAPH_NO_MEMORY;
+    }
+
+    if (status == GRAPH_OK)
+    {
+        // Count the hops from target back to source, then fill the path backwards
+        int d = entry ? entryDist(entry, target) : dist[target];
+        int hops = 0;
+        for (int v = target; d != GRAPH_INF && v != source; hops++)
+        {
+            v = entry ? entryParent(entry, v) : parent[v];
+        }
+        *length = d == GRAPH_INF ? 0 : hops + 1;
+        for (int k = *length - 1, v = target; k >= 0; k--)
+        {
+            path[k] = v;
+            v = entry ? entryParent(entry, v) : parent[v];
+        }
+        if (distance)
+        {
+            *distance = d;
+        }
+    }
+
+    if (entry)
+    {
+        pthread_mutex_unlock(&cache->lock);
+    }
+    else if (status == GRAPH_OK)
+    {
+        insertEntry(cache, packTree(graph->serial, source, graph->n, dist, parent));
+    }
+    free(dist);
+    free(parent);
+    return status;
+}
@@ -0,0 +1,584 @@
+/**
+ * @file pool.c
+ * @brief Work-stealing thread pool shared by every parallel algorithm
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * One pool per process, started by the first parallel query, so
+ * concurrent queries share its threads instead of each starting their
+ * own. Every worker owns a deque: it pushes and pops work at the tail,
+ * idle workers steal from the head of other deques (same NUMA node
+ * first). Threads that are not workers push into deque 0. A thread that
+ * waits for its tasks runs queued tasks meanwhile, so parallel loops may
+ * nest (e.g. a parallel Gomory-Hu build whose max flows run parallel
+ * BFS levels).
+ *
+ * With pinning, workers are bound to the CPUs the process may use,
+ * alternating between NUMA nodes (read from sysfs) so memory bandwidth
+ * of every node is used before any node gets a second worker.
+ *
+ * Time Complexity: O(chunks) per parallel loop besides the tasks
+ * Space Complexity: O(threads × POOL_DEQUE_SIZE)
+ */
+
+#define _GNU_SOURCE // For sched_getaffinity() and pthread_setaffinity_np()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "graph_internal.h"
+
+#define POOL_DEQUE_SIZE 1024 // Tasks per deque (power of two); a full deque runs new tasks inline
+#define POOL_MAX_NODES 64    // Highest NUMA node number looked up
+
+/**
+ * @brief Structure to count the unfinished tasks of one parallel loop
+ */
+struct PoolJob
+{
+    int pending; // Tasks queued or running
+};
+
+/**
+ * @brief Structure to describe one chunk of a parallel loop
+ */
+struct PoolTask
+{
+    PoolChunkFn run;     // Loop body
+    void *context;       // Argument of the loop body
+    int chunk;           // Chunk to run
+    struct PoolJob *job; // Loop the chunk belongs to
+};
+
+/**
+ * @brief Structure to hold the deque of one worker
+ *
+ * head and tail are free-running counters; the deque holds
+ * tasks[head .. tail - 1] modulo POOL_DEQUE_SIZE. Both are changed under the lock and read
+ * without it to skip empty deques.
+ */
+struct PoolDeque
+{
+    pthread_mutex_t lock;
+    unsigned head;           // Next task to steal
+    unsigned tail;           // Next free slot
+    int node;                // NUMA node of the worker (-1 for deque 0)
+    int index;               // Index of the deque in the pool
+    struct ThreadPool *pool; // Pool the deque belongs to
+    struct PoolTask tasks[POOL_DEQUE_SIZE];
+};
+
+/**
+ * @brief Structure to hold the shared pool
+ */
+struct ThreadPool
+{
+    int threads;               // Deques, i.e. workers + 1 (callers share deque 0)
+    int nodes;                 // NUMA nodes the workers are spread over
+    bool pinned;               // true if every worker is bound to a CPU
+    struct PoolDeque *deques;  // Deque 0 for callers, deque i for worker i
+    pthread_t *ids;            // Worker threads (index 0 unused)
+    int queued;                // Tasks in all deques
+    bool started;              // Set once threads and every node are final
+    bool stop;                 // Set to end the workers
+    pthread_mutex_t sleepLock; // Guards started, stop and the sleep of idle workers
+    pthread_cond_t wake;       // Signalled when tasks are queued or the pool stops
+};
+
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER; // Guards the variables below
+static struct ThreadPool *sharedPool = NULL; // Running pool (NULL until first needed)
+static int configuredThreads = 0;            // 0 = number of online CPUs
+static bool configuredPin = false;
+static __thread int workerIndex = 0; // Deque of the calling thread (0 = not a worker)
+
+/**
+ * @brief Count the online CPUs
+ * @return Number of CPUs, at least 1
+ */
+static int onlineCpus(void)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+/**
+ * @brief Read the NUMA node of every CPU from sysfs
+ * @param nodeOf Output: node of every CPU below CPU_SETSIZE (0 if unknown)
+ * @return Number of nodes found (1 without NUMA information)
+ */
+static int readNodes(int nodeOf[])
+{
+    int nodes = 0;
+    memset(nodeOf, 0, CPU_SETSIZE * sizeof(int));
+
+    for (int node = 0; node < POOL_MAX_NODES; node++)
+    {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *file = fopen(path, "r");
+        if (!file)
+        {
+            continue;
+        }
+
+        // Ranges like "0-3,8-11"
+        int first, last;
+        while (fscanf(file, "%d", &first) == 1)
+        {
+            last = first;
+            int c = fgetc(file);
+            if (c == '-' && fscanf(file, "%d", &last) == 1)
+            {
+                c = fgetc(file);
+            }
+            for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+            {
+                nodeOf[cpu] = node;
+            }
+            if (c != ',')
+            {
+                break;
+            }
+        }
+        fclose(file);
+        nodes = node + 1;
+    }
+    return nodes > 0 ? nodes : 1;
+}
+
+/**
+ * @brief Bind every worker to a CPU, alternating between NUMA nodes
+ * @param pool Pool whose workers are started but still wait for pool->started
+ * @return true if every worker was bound
+ */
+static bool pinWorkers(struct ThreadPool *pool)
+{
+    cpu_set_t allowed;
+    int *nodeOf = malloc(CPU_SETSIZE * sizeof(int));
+    int *order = malloc(CPU_SETSIZE * sizeof(int));
+    if (!nodeOf || !order || sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    {
+        free(nodeOf);
+        free(order);
+        return false;
+    }
+
+    // Take the k-th allowed CPU of every node in turn
+    int nodes = readNodes(nodeOf);
+    int count = 0;
+    for (int round = 0; count < CPU_COUNT(&allowed) && round < CPU_SETSIZE; round++)
+    {
+        for (int node = 0; node < nodes; node++)
+        {
+            int seen = 0;
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            {
+                if (CPU_ISSET(cpu, &allowed) && nodeOf[cpu] == node && seen++ == round)
+                {
+                    order[count++] = cpu;
+                    break;
+                }
+            }
+        }
+    }
+
+    bool pinned = count > 0;
+    bool used[POOL_MAX_NODES] = {false};
+    pool->nodes = 0;
+    for (int i = 1; i < pool->threads && pinned; i++)
+    {
+        cpu_set_t one;
+        int cpu = order[(i - 1) % count];
+        CPU_ZERO(&one);
+        CPU_SET(cpu, &one);
+        pinned = pthread_setaffinity_np(pool->ids[i], sizeof(one), &one) == 0;
+        pool->deques[i].node = nodeOf[cpu];
+        pool->nodes += !used[nodeOf[cpu]];
+        used[nodeOf[cpu]] = true;
+    }
+
+    free(nodeOf);
+    free(order);
+    return pinned;
+}
+
+/**
+ * @brief Queue a task at the tail of a deque
+ * @param deque Deque
+ * @param task Task
+ * @return false if the deque is full
+ */
+static bool pushTask(struct PoolDeque *deque, const struct PoolTask *task)
+{
+    pthread_mutex_lock(&deque->lock);
+    bool room = deque->tail - deque->head < POOL_DEQUE_SIZE;
+    if (room)
+    {
+        deque->tasks[deque->tail % POOL_DEQUE_SIZE] = *task;
+        __atomic_store_n(&deque->tail, deque->tail + 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return room;
+}
+
+/**
+ * @brief Take a task from a deque
+ * @param deque Deque
+ * @param steal true to take the oldest task (head), false for the newest (tail)
+ * @param task Output: the task
+ * @return false if the deque was empty
+ */
+static bool takeTask(struct PoolDeque *deque, bool steal, struct PoolTask *task)
+{
+    if (__atomic_load_n(&deque->head, __ATOMIC_RELAXED) ==
+        __atomic_load_n(&deque->tail, __ATOMIC_RELAXED))
+    {
+        return false; // Looks empty: not worth the lock
+    }
+
+    pthread_mutex_lock(&deque->lock);
+    bool found = deque->head != deque->tail;
+    if (found && steal)
+    {
+        *task = deque->tasks[deque->head % POOL_DEQUE_SIZE];
+        __atomic_store_n(&deque->head, deque->head + 1, __ATOMIC_RELAXED);
+    }
+    else if (found)
+    {
+        *task = deque->tasks[(deque->tail - 1) % POOL_DEQUE_SIZE];
+        __atomic_store_n(&deque->tail, deque->tail - 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+/**
+ * @brief Run one queued task: the own deque's newest, else a stolen one
+ * @param pool Pool
+ * @param self Deque of the calling thread
+ * @return false if no task was found
+ */
+static bool runOneTask(struct ThreadPool *pool, int self)
+{
+    struct PoolTask task;
+    bool found = takeTask(&pool->deques[self], false, &task);
+
+    // Steal from the same node first, then from anywhere
+    int node = pool->deques[self].node;
+    for (int pass = 0; pass < 2 && !found; pass++)
+    {
+        for (int k = 1; k < pool->threads && !found; k++)
+        {
+            struct PoolDeque *victim = &pool->deques[(self + k) % pool->threads];
+            if ((victim->node == node || victim->node < 0) == (pass == 0))
+            {
+                found = takeTask(victim, true, &task);
+            }
+        }
+    }
+    if (!found)
+    {
+        return false;
+    }
+
+    __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_RELAXED);
+    task.run(task.context, task.chunk);
+    __atomic_sub_fetch(&task.job->pending, 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Thread entry point of a worker
+ * @param arg Pointer to the worker's struct PoolDeque
+ * @return NULL
+ */
+static void *poolWorker(void *arg)
+{
+    struct PoolDeque *own = arg;
+    struct ThreadPool *pool = own->pool;
+    workerIndex = own->index;
+
+    // Wait until createPool() has settled threads and the deques' nodes
+    pthread_mutex_lock(&pool->sleepLock);
+    while (!pool->started && !pool->stop)
+    {
+        pthread_cond_wait(&pool->wake, &pool->sleepLock);
+    }
+    pthread_mutex_unlock(&pool->sleepLock);
+
+    while (true)
+    {
+        if (runOneTask(pool, own->index))
+        {
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->sleepLock);
+        while (!pool->stop && __atomic_load_n(&pool->queued, __ATOMIC_RELAXED) == 0)
+        {
+            pthread_cond_wait(&pool->wake, &pool->sleepLock);
+        }
+        bool stop = pool->stop;
+        pthread_mutex_unlock(&pool->sleepLock);
+        if (stop)
+        {
+            return NULL;
+        }
+    }
+}
+
+/**
+ * @brief Stop the workers of a pool and free it
+ * @param pool Pool (may be NULL)
+ */
+static void destroyPool(struct ThreadPool *pool)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->sleepLock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->sleepLock);
+    for (int i = 1; i < pool->threads; i++)
+    {
+        pthread_join(pool->ids[i], NULL);
+    }
+
+    for (int i = 0; i < pool->threads; i++)
+    {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+    }
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->sleepLock);
+    free(pool->deques);
+    free(pool->ids);
+    free(pool);
+}
+
+/**
+ * @brief Start a pool
+ * @param threads Threads running tasks, callers included (0 = online CPUs)
+ * @param pin true to bind workers to CPUs
+ * @return Pool (with fewer threads if some could not be started), or
+ *         NULL if memory ran out
+ */
+static struct ThreadPool *createPool(int threads, bool pin)
+{
+    threads = threads > 0 ? threads : onlineCpus();
+
+    struct ThreadPool *pool = calloc(1, sizeof(struct ThreadPool));
+    if (!pool)
+    {
+        return NULL;
+    }
+    pool->deques = calloc(threads, sizeof(struct PoolDeque));
+    pool->ids = calloc(threads, sizeof(pthread_t));
+    if (!pool->deques || !pool->ids)
+    {
+        free(pool->deques);
+        free(pool->ids);
+        free(pool);
+        return NULL;
+    }
+
+    pool->nodes = 1;
+    pthread_mutex_init(&pool->sleepLock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_mutex_init(&pool->deques[i].lock, NULL);
+        pool->deques[i].node = i == 0 ? -1 : 0;
+        pool->deques[i].index = i;
+        pool->deques[i].pool = pool;
+    }
+
+    // Deque 0 belongs to the callers; a worker that fails to start ends the pool there
+    pool->threads = 1;
+    for (int i = 1; i < threads; i++)
+    {
+        if (pthread_create(&pool->ids[i], NULL, poolWorker, &pool->deques[i]) != 0)
+        {
+            break;
+        }
+        pool->threads++;
+    }
+    for (int i = pool->threads; i < threads; i++)
+    {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+    }
+
+    if (pin && pool->threads > 1)
+    {
+        pool->pinned = pinWorkers(pool);
+    }
+
+    // Release the workers; the lock publishes threads and the nodes to them
+    pthread_mutex_lock(&pool->sleepLock);
+    pool->started = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->sleepLock);
+    return pool;
+}
+
+/**
+ * @brief Get the shared pool, starting it on first use
+ * @return Pool, or NULL if it cannot be started
+ */
+static struct ThreadPool *getPool(void)
+{
+    struct ThreadPool *pool = __atomic_load_n(&sharedPool, __ATOMIC_ACQUIRE);
+    if (pool)
+    {
+        return pool;
+    }
+
+    pthread_mutex_lock(&poolLock);
+    if (!sharedPool)
+    {
+        __atomic_store_n(&sharedPool, createPool(configuredThreads, configuredPin),
+                         __ATOMIC_RELEASE);
+    }
+    pool = sharedPool;
+    pthread_mutex_unlock(&poolLock);
+    return pool;
+}
+
+int poolThreads(void)
+{
+    pthread_mutex_lock(&poolLock);
+    int threads = sharedPool ? sharedPool->threads
+                  : configuredThreads > 0 ? configuredThreads
+                                          : onlineCpus();
+    pthread_mutex_unlock(&poolLock);
+    return threads;
+}
+
+int poolNodes(void)
+{
+    struct ThreadPool *pool = getPool();
+    return pool && pool->pinned ? pool->nodes : 1;
+}
+
+void poolFor(int chunks, PoolChunkFn run, void *context)
+{
+    struct ThreadPool *pool = chunks > 1 ? getPool() : NULL;
+    if (!pool || pool->threads == 1)
+    {
+        for (int chunk = 0; chunk < chunks; chunk++)
+        {
+            run(context, chunk);
+        }
+        return;
+    }
+
+    // Queue chunks 1 .. chunks - 1 and run chunk 0 here
+    int self = workerIndex;
+    struct PoolJob job = {chunks - 1};
+    for (int chunk = chunks - 1; chunk > 0; chunk--)
+    {
+        struct PoolTask task = {run, context, chunk, &job};
+        if (pushTask(&pool->deques[self], &task))
+        {
+            __atomic_add_fetch(&pool->queued, 1, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            run(context, chunk);
+            __atomic_sub_fetch(&job.pending, 1, __ATOMIC_RELAXED);
+        }
+    }
+    pthread_mutex_lock(&pool->sleepLock);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->sleepLock);
+
+    run(context, 0);
+
+    // Help with any queued work until the last chunk of this loop is done
+    while (__atomic_load_n(&job.pending, __ATOMIC_ACQUIRE) > 0)
+    {
+        if (!runOneTask(pool, self))
+        {
+            sched_yield();
+        }
+    }
+}
+
+/**
+ * @brief Structure to pass a summing loop through poolFor()
+ */
+struct PoolSum
+{
+    PoolSumFn run;
+    void *context;
+    long long total;
+};
+
+/**
+ * @brief Loop body of poolSum(): add one chunk's value to the total
+ * @param context Pointer to a struct PoolSum
+ * @param chunk Chunk to run
+ */
+static void sumChunk(void *context, int chunk)
+{
+    struct PoolSum *sum = context;
+    __atomic_add_fetch(&sum->total, sum->run(sum->context, chunk), __ATOMIC_RELAXED);
+}
+
+long long poolSum(int chunks, PoolSumFn run, void *context)
+{
+    struct PoolSum sum = {run, context, 0};
+    poolFor(chunks, sumChunk, &sum);
+    return sum.total;
+}
+
+int graphThreadPoolConfigure(int threads, bool pin)
+{
+    if (threads < 0)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    pthread_mutex_lock(&poolLock);
+    struct ThreadPool *old = sharedPool;
+    __atomic_store_n(&sharedPool, NULL, __ATOMIC_RELEASE);
+    configuredThreads = threads;
+    configuredPin = pin;
+    pthread_mutex_unlock(&poolLock);
+
+    destroyPool(old); // The next parallel query starts the new pool
+    return GRAPH_OK;
+}
+
+void graphThreadPoolShutdown(void)
+{
+    pthread_mutex_lock(&poolLock);
+    struct ThreadPool *old = sharedPool;
+    __atomic_store_n(&sharedPool, NULL, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&poolLock);
+
+    destroyPool(old);
+}
+
+int graphThreadPoolInfo(struct GraphThreadPoolInfo *info)
+{
+    if (!info)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    pthread_mutex_lock(&poolLock);
+    struct ThreadPool *pool = sharedPool;
+    info->running = pool != NULL;
+    info->threads = pool ? pool->threads : configuredThreads > 0 ? configuredThreads : onlineCpus();
+    info->nodes = pool && pool->pinned ? pool->nodes : 1;
+    info->pinned = pool && pool->pinned;
+    pthread_mutex_unlock(&poolLock);
+    return GRAPH_OK;
+}
@@ -0,0 +1,739 @@
+/**
+ * @file reorder.c
+ * @brief Cache-locality vertex reordering of libgraph: degree sort,
+ *        Reverse Cuthill-McKee and Gorder
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Traversals read dist[], key[] and the CSR row of every neighbour they
+ * touch. With the input's vertex numbering those neighbours are spread
+ * over the whole array, so nearly every access misses the cache. The
+ * orders below give vertices that are used together nearby slots:
+ *
+ * - Degree sort puts the high-degree vertices, which most arcs point
+ *   at, into one small block at the front.
+ * - Reverse Cuthill-McKee numbers vertices in BFS order from a
+ *   peripheral vertex, so every arc spans few slots (small bandwidth).
+ * - Gorder (Wei et al., 2016) greedily places next the vertex that
+ *   shares the most neighbours with the last few placed vertices.
+ *
+ * The reordered graph remembers the permutation, and the query functions
+ * translate vertex IDs on the way in and out, so callers never see it.
+ *
+ * Time Complexity: O(V + E) for degree sort, O(V + E log Δ) for RCM,
+ *                  O(Σ deg_in(v) · min(deg_out, √V)) for Gorder
+ * Space Complexity: O(V + E)
+ */
+
+#include <stdlib.h>
+
+#include "graph_internal.h"
+#include "bfs.h"
+
+#define GORDER_WINDOW 5           // Number of recently placed vertices Gorder scores against
+#define GORDER_INITIAL_BUCKETS 64 // First size of the Gorder bucket array
+#define PERIPHERAL_ROUNDS 8       // Restarts of the pseudo-peripheral vertex search
+
+/**
+ * @brief Structure to give access to the in-arcs of a graph
+ *
+ * An undirected graph's in-arcs are its out-arcs. A directed graph gets
+ * its own in-arc arrays, owned by this structure.
+ */
+struct InArcs
+{
+    const int *offset; // In-arc offsets (n + 1 entries)
+    const int *source; // Tail of every in-arc
+    int *owned[3];     // Arrays to free (NULL for an undirected graph)
+};
+
+/**
+ * @brief Set up the in-arcs of a graph
+ * @param graph Graph
+ * @param in Output: in-arc view
+ * @return false if memory ran out
+ */
+static bool loadInArcs(const struct Graph *graph, struct InArcs *in)
+{
+    in->owned[0] = in->owned[1] = in->owned[2] = NULL;
+    if (!graph->directed)
+    {
+        in->offset = graph->offset;
+        in->source = graph->target;
+        return true;
+    }
+
+    in->owned[0] = malloc((graph->n + 1) * sizeof(int));
+    in->owned[1] = malloc(graph->arcCount * sizeof(int) + 1);
+    in->owned[2] = malloc(graph->arcCount * sizeof(int) + 1);
+    if (!in->owned[0] || !in->owned[1] || !in->owned[2])
+    {
+        return false;
+    }
+    buildInArcs(graph->n, graph->offset, graph->target, in->owned[0], in->owned[1], in->owned[2]);
+    in->offset = in->owned[0];
+    in->source = in->owned[1];
+    return true;
+}
+
+/**
+ * @brief Free the arrays owned by an in-arc view
+ * @param in In-arc view
+ */
+static void freeInArcs(struct InArcs *in)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        free(in->owned[i]);
+    }
+}
+
+/**
+ * @brief Compute the degree of every vertex, counting out- and in-arcs
+ *
+ * An undirected arc is counted once, like an out-arc.
+ *
+ * @param graph Graph
+ * @param in In-arc view
+ * @param degree Output: n degrees
+ * @return Largest degree
+ */
+static int loadDegrees(const struct Graph *graph, const struct InArcs *in, int degree[])
+{
+    int maxDegree = 0;
+    for (int v = 0; v < graph->n; v++)
+    {
+        degree[v] = graph->offset[v + 1] - graph->offset[v];
+        if (graph->directed)
+        {
+            degree[v] += in->offset[v + 1] - in->offset[v];
+        }
+        if (degree[v] > maxDegree)
+        {
+            maxDegree = degree[v];
+        }
+    }
+    return maxDegree;
+}
+
+/**
+ * @brief Stable counting sort of the vertices by degree
+ * @param n Number of vertices
+ * @param degree Degree of every vertex
+ * @param maxDegree Largest degree
+ * @param descending true for highest degree first
+ * @param order Output: n vertices in degree order
+ * @return false if memory ran out
+ */
+static bool sortByDegree(int n, const int degree[], int maxDegree, bool descending, int order[])
+{
+    int *start = calloc((size_t)maxDegree + 2, sizeof(int));
+    if (!start)
+    {
+        return false;
+    }
+
+    for (int v = 0; v < n; v++)
+    {
+        int k = descending ? maxDegree - degree[v] : degree[v];
+        start[k + 1]++;
+    }
+    for (int k = 0; k <= maxDegree; k++)
+    {
+        start[k + 1] += start[k];
+    }
+    for (int v = 0; v < n; v++)
+    {
+        int k = descending ? maxDegree - degree[v] : degree[v];
+        order[start[k]++] = v;
+    }
+
+    free(start);
+    return true;
+}
+
+/**
+ * @brief Structure to hold one neighbour while RCM sorts it by degree
+ */
+struct DegreeKey
+{
+    int degree; // Degree of the vertex
+    int vertex; // Vertex
+};
+
+/**
+ * @brief Order neighbours by degree, then by vertex for a stable result
+ * @param a Pointer to the first struct DegreeKey
+ * @param b Pointer to the second struct DegreeKey
+ * @return Negative, zero or positive as for qsort()
+ */
+static int compareByDegree(const void *a, const void *b)
+{
+    const struct DegreeKey *x = a, *y = b;
+    if (x->degree != y->degree)
+    {
+        return x->degree < y->degree ? -1 : 1;
+    }
+    return (x->vertex > y->vertex) - (x->vertex < y->vertex);
+}
+
+/**
+ * @brief Structure to hold the scratch arrays of Reverse Cuthill-McKee
+ */
+struct RcmState
+{
+    const struct Graph *graph;
+    const struct InArcs *in;
+    const int *degree;
+    int *level;              // BFS level during the peripheral search, -1 otherwise
+    int *queue;              // BFS queue of the peripheral search
+    char *placed;            // true once a vertex has its Cuthill-McKee number
+    struct DegreeKey *batch; // Unplaced neighbours of the vertex being expanded
+};
+
+/**
+ * @brief Get the i-th neighbour of a vertex, out-arcs first, then in-arcs
+ *
+ * Vertex u has degree[u] neighbours; in-arcs only count for a directed
+ * graph, as in loadDegrees().
+ *
+ * @param state RCM state
+ * @param u Vertex
+ * @param i Neighbour index, 0 <= i < degree[u]
+ * @return Neighbour vertex
+ */
+static int neighbourAt(const struct RcmState *state, int u, int i)
+{
+    const struct Graph *graph = state->graph;
+    int out = graph->offset[u + 1] - graph->offset[u];
+    if (i < out)
+    {
+        return graph->target[graph->offset[u] + i];
+    }
+    return state->in->source[state->in->offset[u] + i - out];
+}
+
+/**
+ * @brief Run a BFS over one component and report its last level
+ * @param state RCM state with level[] at -1 for the whole component
+ * @param root Start vertex
+ * @param lastStart Output: index in queue[] where the last level starts
+ * @return Number of vertices reached; queue[] holds them in BFS order
+ *         and level[] is set for them
+ */
+static int levelStructure(struct RcmState *state, int root, int *lastStart)
+{
+    int head = 0, tail = 0;
+    state->queue[tail++] = root;
+    state->level[root] = 0;
+    *lastStart = 0;
+
+    while (head < tail)
+    {
+        int u = state->queue[head++];
+        for (int i = 0; i < state->degree[u]; i++)
+        {
+            int w = neighbourAt(state, u, i);
+            if (state->level[w] == -1)
+            {
+                state->level[w] = state->level[u] + 1;
+                if (state->level[w] != state->level[state->queue[*lastStart]])
+                {
+                    *lastStart = tail;
+                }
+                state->queue[tail++] = w;
+            }
+        }
+    }
+    return tail;
+}
+
+/**
+ * @brief Find a pseudo-peripheral vertex with the George-Liu heuristic
+ *
+ * Starting from root, repeatedly jump to the lowest-degree vertex of the
+ * last BFS level while that increases the number of levels.
+ *
+ * @param state RCM state
+ * @param root Any vertex of the component
+ * @return A vertex of nearly maximal eccentricity
+ */
+static int peripheralVertex(struct RcmState *state, int root)
+{
+    int depth = -1;
+    for (int round = 0; round < PERIPHERAL_ROUNDS; round++)
+    {
+        int lastStart;
+        int reached = levelStructure(state, root, &lastStart);
+        int rootDepth = state->level[state->queue[reached - 1]];
+
+        int best = state->queue[lastStart];
+        for (int i = lastStart; i < reached; i++)
+        {
+            int v = state->queue[i];
+            if (state->degree[v] < state->degree[best])
+            {
+                best = v;
+            }
+        }
+        for (int i = 0; i < reached; i++)
+        {
+            state->level[state->queue[i]] = -1;
+        }
+
+        if (rootDepth <= depth)
+        {
+            break; // The last jump did not lengthen the level structure
+        }
+        depth = rootDepth;
+        root = best;
+    }
+    return root;
+}
+
+/**
+ * @brief Number the vertices in Reverse Cuthill-McKee order
+ *
+ * Every component is numbered by a BFS from a pseudo-peripheral vertex
+ * that visits the neighbours of each vertex by increasing degree;
+ * components are taken lowest degree first. The whole numbering is then
+ * reversed.
+ *
+ * @param graph Graph
+ * @param in In-arc view
+ * @param degree Degree of every vertex
+ * @param maxDegree Largest degree
+ * @param order Output: n vertices in RCM order
+ * @return false if memory ran out
+ */
+static bool rcmOrder(const struct Graph *graph, const struct InArcs *in, const int degree[],
+                     int maxDegree, int order[])
+{
+    int n = graph->n;
+    struct RcmState state = {graph, in, degree, NULL, NULL, NULL, NULL};
+    state.level = malloc(n * sizeof(int) + 1);
+    state.queue = malloc(n * sizeof(int) + 1);
+    state.placed = calloc((size_t)n + 1, sizeof(char));
+    state.batch = malloc(((size_t)maxDegree + 1) * sizeof(struct DegreeKey));
+    int *byDegree = malloc(n * sizeof(int) + 1);
+
+    bool ok = state.level && state.queue && state.placed && state.batch && byDegree &&
+              sortByDegree(n, degree, maxDegree, false, byDegree);
+    if (ok)
+    {
+        for (int v = 0; v < n; v++)
+        {
+            state.level[v] = -1;
+        }
+
+        int count = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (state.placed[byDegree[i]])
+            {
+                continue;
+            }
+            int start = peripheralVertex(&state, byDegree[i]);
+            state.placed[start] = true;
+            order[count++] = start;
+
+            // Cuthill-McKee BFS: order[] doubles as the queue
+            for (int head = count - 1; head < count; head++)
+            {
+                int u = order[head];
+                int found = 0;
+                for (int k = 0; k < degree[u]; k++)
+                {
+                    int w = neighbourAt(&state, u, k);
+                    if (!state.placed[w])
+                    {
+                        state.placed[w] = true;
+                        state.batch[found].degree = degree[w];
+                        state.batch[found].vertex = w;
+                        found++;
+                    }
+                }
+                qsort(state.batch, found, sizeof(struct DegreeKey), compareByDegree);
+                for (int k = 0; k < found; k++)
+                {
+                    order[count++] = state.batch[k].vertex;
+                }
+            }
+        }
+
+        for (int i = 0, j = n - 1; i < j; i++, j--)
+        {
+            int tmp = order[i];
+            order[i] = order[j];
+            order[j] = tmp;
+        }
+    }
+
+    free(state.level);
+    free(state.queue);
+    free(state.placed);
+    free(state.batch);
+    free(byDegree);
+    return ok;
+}
+
+/**
+ * @brief Structure to represent the unit heap of Gorder
+ *
+ * Unplaced vertices sit in doubly linked buckets by score. Scores only
+ * change by ±1, so an update is O(1) and the maximum is found by walking
+ * top down from the last known maximum.
+ */
+struct UnitHeap
+{
+    int *score;    // Current score of every vertex
+    int *prev;     // Previous vertex in the same bucket (-1 at the front)
+    int *next;     // Next vertex in the same bucket (-1 at the end)
+    int *bucket;   // First vertex of every bucket (-1 if empty)
+    int buckets;   // Number of buckets allocated
+    int top;       // No bucket above this one is non-empty
+    char *placed;  // true once a vertex has its Gorder number
+    bool failed;   // true if growing the bucket array ran out of memory
+};
+
+/**
+ * @brief Unlink a vertex from its bucket
+ * @param heap Unit heap
+ * @param v Vertex
+ */
+static void unitUnlink(struct UnitHeap *heap, int v)
+{
+    if (heap->prev[v] != -1)
+    {
+        heap->next[heap->prev[v]] = heap->next[v];
+    }
+    else
+    {
+        heap->bucket[heap->score[v]] = heap->next[v];
+    }
+    if (heap->next[v] != -1)
+    {
+        heap->prev[heap->next[v]] = heap->prev[v];
+    }
+}
+
+/**
+ * @brief Push a vertex to the front of the bucket of its score
+ * @param heap Unit heap
+ * @param v Vertex
+ */
+static void unitLink(struct UnitHeap *heap, int v)
+{
+    int s = heap->score[v];
+    heap->prev[v] = -1;
+    heap->next[v] = heap->bucket[s];
+    if (heap->bucket[s] != -1)
+    {
+        heap->prev[heap->bucket[s]] = v;
+    }
+    heap->bucket[s] = v;
+    if (s > heap->top)
+    {
+        heap->top = s;
+    }
+}
+
+/**
+ * @brief Change the score of an unplaced vertex by ±1
+ * @param heap Unit heap
+ * @param v Vertex (ignored if already placed)
+ * @param delta +1 or -1
+ */
+static void unitAdd(struct UnitHeap *heap, int v, int delta)
+{
+    if (heap->placed[v] || heap->failed)
+    {
+        return;
+    }
+    if (heap->score[v] + delta >= heap->buckets)
+    {
+        int *grown = realloc(heap->bucket, 2 * heap->buckets * sizeof(int));
+        if (!grown)
+        {
+            heap->failed = true;
+            return;
+        }
+        for (int s = heap->buckets; s < 2 * heap->buckets; s++)
+        {
+            grown[s] = -1;
+        }
+        heap->bucket = grown;
+        heap->buckets *= 2;
+    }
+    unitUnlink(heap, v);
+    heap->score[v] += delta;
+    unitLink(heap, v);
+}
+
+/**
+ * @brief Add ±1 to every score a vertex contributes to
+ *
+ * A vertex v adds one point to each out-neighbour, one to each
+ * in-neighbour, and one to each sibling (out-neighbour of an
+ * in-neighbour x). Siblings through hubs (out-degree above hubDegree)
+ * are skipped: they would cost deg(x) updates for almost no signal.
+ *
+ * @param heap Unit heap
+ * @param graph Graph
+ * @param in In-arc view
+ * @param v Vertex entering (+1) or leaving (-1) the window
+ * @param delta +1 or -1
+ * @param hubDegree Largest out-degree whose siblings are scored
+ */
+static void scoreNeighbours(struct UnitHeap *heap, const struct Graph *graph,
+                            const struct InArcs *in, int v, int delta, int hubDegree)
+{
+    for (int a = graph->offset[v]; a < graph->offset[v + 1]; a++)
+    {
+        unitAdd(heap, graph->target[a], delta);
+    }
+    for (int k = in->offset[v]; k < in->offset[v + 1]; k++)
+    {
+        int x = in->source[k];
+        unitAdd(heap, x, delta);
+        if (graph->offset[x + 1] - graph->offset[x] <= hubDegree)
+        {
+            for (int a = graph->offset[x]; a < graph->offset[x + 1]; a++)
+            {
+                unitAdd(heap, graph->target[a], delta);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Number the vertices in Gorder order
+ *
+ * The first vertex is the one with the most in-arcs. Each next vertex is
+ * the unplaced one with the highest score against the last
+ * GORDER_WINDOW placed vertices.
+ *
+ * @param graph Graph
+ * @param in In-arc view
+ * @param order Output: n vertices in Gorder order
+ * @return false if memory ran out
+ */
+static bool gorderOrder(const struct Graph *graph, const struct InArcs *in, int order[])
+{
+    int n = graph->n;
+    struct UnitHeap heap = {NULL, NULL, NULL, NULL, GORDER_INITIAL_BUCKETS, 0, NULL, false};
+    heap.score = calloc((size_t)n + 1, sizeof(int));
+    heap.prev = malloc(n * sizeof(int) + 1);
+    heap.next = malloc(n * sizeof(int) + 1);
+    heap.bucket = malloc(GORDER_INITIAL_BUCKETS * sizeof(int));
+    heap.placed = calloc((size_t)n + 1, sizeof(char));
+
+    bool ok = heap.score && heap.prev && heap.next && heap.bucket && heap.placed;
+    if (ok && n > 0)
+    {
+        int hubDegree = 1;
+        while ((long long)hubDegree * hubDegree < n)
+        {
+            hubDegree++;
+        }
+
+        for (int s = 0; s < GORDER_INITIAL_BUCKETS; s++)
+        {
+            heap.bucket[s] = -1;
+        }
+        int first = 0;
+        for (int v = n - 1; v >= 0; v--)
+        {
+            unitLink(&heap, v); // Linked in reverse, so ties go to the lower ID
+            if (in->offset[v + 1] - in->offset[v] >= in->offset[first + 1] - in->offset[first])
+            {
+                first = v;
+            }
+        }
+
+        for (int i = 0; i < n && !heap.failed; i++)
+        {
+            int v = first;
+            if (i > 0)
+            {
+                while (heap.bucket[heap.top] == -1)
+                {
+                    heap.top--;
+                }
+                v = heap.bucket[heap.top];
+            }
+            unitUnlink(&heap, v);
+            heap.placed[v] = true;
+            order[i] = v;
+
+            scoreNeighbours(&heap, graph, in, v, 1, hubDegree);
+            if (i >= GORDER_WINDOW)
+            {
+                scoreNeighbours(&heap, graph, in, order[i - GORDER_WINDOW], -1, hubDegree);
+            }
+        }
+        ok = !heap.failed;
+    }
+
+    free(heap.score);
+    free(heap.prev);
+    free(heap.next);
+    free(heap.bucket);
+    free(heap.placed);
+    return ok;
+}
+
+/**
+ * @brief Copy a graph's edges into a new graph in slot order
+ *
+ * Edges are relabelled to their new slots and sorted by (u, v) with two
+ * stable counting sorts, so every vertex's out-arcs are contiguous and
+ * ascending.
+ *
+ * @param graph Source graph
+ * @param slotOf New slot of every source slot
+ * @param out New graph from allocGraph() with inputEdge allocated
+ * @return false if memory ran out
+ */
+static bool copyEdges(const struct Graph *graph, const int slotOf[], struct Graph *out)
+{
+    int n = graph->n, m = graph->edgeCount;
+    int *count = malloc((n + 1) * sizeof(int));
+    int *byHead = malloc(m * sizeof(int) + 1);
+    int *byTail = malloc(m * sizeof(int) + 1);
+    bool ok = count && byHead && byTail;
+
+    // Pass 0 sorts by new head, pass 1 stably by new tail
+    for (int pass = 0; ok && pass < 2; pass++)
+    {
+        const int *input = pass ? byHead : NULL;
+        int *output = pass ? byTail : byHead;
+        for (int v = 0; v <= n; v++)
+        {
+            count[v] = 0;
+        }
+        for (int i = 0; i < m; i++)
+        {
+            const struct GraphEdge *e = &graph->edges[i];
+            count[slotOf[pass ? e->u : e->v] + 1]++;
+        }
+        for (int v = 0; v < n; v++)
+        {
+            count[v + 1] += count[v];
+        }
+        for (int k = 0; k < m; k++)
+        {
+            int i = input ? input[k] : k;
+            const struct GraphEdge *e = &graph->edges[i];
+            output[count[slotOf[pass ? e->u : e->v]]++] = i;
+        }
+    }
+
+    if (ok)
+    {
+        for (int k = 0; k < m; k++)
+        {
+            int i = byTail[k];
+            out->edges[k].u = slotOf[graph->edges[i].u];
+            out->edges[k].v = slotOf[graph->edges[i].v];
+            out->edges[k].weight = graph->edges[i].weight;
+            out->inputEdge[k] = graph->inputEdge ? graph->inputEdge[i] : i;
+        }
+    }
+
+    free(count);
+    free(byHead);
+    free(byTail);
+    return ok;
+}
+
+int graphReorder(const struct Graph *graph, int order, struct Graph **reordered)
+{
+    if (!graph || !reordered ||
+        (order != GRAPH_ORDER_DEGREE && order != GRAPH_ORDER_RCM && order != GRAPH_ORDER_GORDER))
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (isCompressed(graph))
+    {
+        return GRAPH_NEEDS_EDGE_LIST;
+    }
+    if (graph->wideArc)
+    {
+        return GRAPH_WEIGHT_TYPE; // Typed weights stay in input order
+    }
+
+    int n = graph->n;
+    struct InArcs in;
+    int *degree = malloc(n * sizeof(int) + 1);
+    int *sequence = malloc(n * sizeof(int) + 1); // Source slot of every new slot
+    int *slotOf = malloc(n * sizeof(int) + 1);   // New slot of every source slot
+    bool ok = loadInArcs(graph, &in) && degree && sequence && slotOf;
+
+    if (ok)
+    {
+        int maxDegree = loadDegrees(graph, &in, degree);
+        if (order == GRAPH_ORDER_DEGREE)
+        {
+            ok = sortByDegree(n, degree, maxDegree, true, sequence);
+        }
+        else if (order == GRAPH_ORDER_RCM)
+        {
+            ok = rcmOrder(graph, &in, degree, maxDegree, sequence);
+        }
+        else
+        {
+            ok = gorderOrder(graph, &in, sequence);
+        }
+    }
+    freeInArcs(&in);
+    free(degree);
+
+    struct Graph *g = ok ? allocGraph(n, graph->edgeCount, graph->directed) : NULL;
+    if (g)
+    {
+        g->position = malloc(n * sizeof(int) + 1);
+        g->vertexAt = malloc(n * sizeof(int) + 1);
+        g->inputEdge = malloc(graph->edgeCount * sizeof(int) + 1);
+    }
+    if (g && g->position && g->vertexAt && g->inputEdge)
+    {
+        g->weightType = graph->weightType;
+        // Compose with the source graph's own permutation, if any
+        for (int p = 0; p < n; p++)
+        {
+            slotOf[sequence[p]] = p;
+            g->vertexAt[p] = graph->vertexAt ? graph->vertexAt[sequence[p]] : sequence[p];
+            g->position[g->vertexAt[p]] = p;
+        }
+        ok = copyEdges(graph, slotOf, g);
+    }
+    else
+    {
+        ok = false;
+    }
+    free(sequence);
+    free(slotOf);
+
+    if (!ok)
+    {
+        graphFree(g);
+        return GRAPH_NO_MEMORY;
+    }
+    buildArcs(g);
+    *reordered = g;
+    return GRAPH_OK;
+}
+
+int graphVertexPositions(const struct Graph *graph, int position[])
+{
+    if (!graph || !position)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    for (int v = 0; v < graph->n; v++)
+    {
+        position[v] = vertexSlot(graph, v);
+    }
+    return GRAPH_OK;
+}
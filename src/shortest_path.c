@@ -0,0 +1,696 @@
+/**
+ * @file shortest_path.c
+ * @brief Single-source shortest paths of libgraph: Dijkstra and Bellman-Ford
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Dijkstra scans the CSR arcs of each settled vertex (decoding them on a
+ * compressed graph) and keeps the frontier in an indexed binary heap.
+ * Bellman-Ford sweeps the edge list and stops as soon as a pass changes
+ * nothing; the batched variant sweeps it once per pass for 16 sources
+ * whose distances sit side by side. Unweighted queries go to the
+ * direction-optimizing BFS engine.
+ *
+ * Scratch arrays come from the query's workspace (see workspace.c).
+ *
+ * Time Complexity: O((V + E) log V) for Dijkstra, O(VE) for Bellman-Ford,
+ *                  O(V + E) for BFS
+ * Space Complexity: O(V) besides the outputs (O(V + E) for BFS on a
+ *                   directed graph)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph_internal.h"
+#include "bfs.h"
+
+#define BF_LANES 16   // Sources of a batched Bellman-Ford group: one 64-byte line per vertex
+#define VECTOR_LANES 4 // Lanes of a LaneVector (the 128-bit SIMD width of SSE2 and NEON)
+#define BF_VECTORS (BF_LANES / VECTOR_LANES)
+
+/**
+ * @brief Lower dist[v] through u if that is shorter
+ * @param heap Heap of the search
+ * @param dist Distances
+ * @param parent Parents (may be NULL)
+ * @param u Settled tail
+ * @param v Head
+ * @param weight Arc weight
+ */
+static inline void relaxArc(struct VertexHeap *heap, int dist[], int parent[], int u, int v,
+                            int weight)
+{
+    if (dist[u] + weight < dist[v])
+    {
+        dist[v] = dist[u] + weight;
+        if (parent)
+        {
+            parent[v] = u;
+        }
+        heapDecrease(heap, v);
+        STAT_ADD(heap->stats, relaxations, 1);
+    }
+}
+
+/**
+ * @brief Run Dijkstra's algorithm on the slots of a graph
+ * @param graph Graph with non-negative weights
+ * @param workspace Workspace of the query
+ * @param source Source slot
+ * @param dist Output: n distances by slot
+ * @param parent Output: n parent slots by slot (may be NULL)
+ * @return GRAPH_OK or GRAPH_NO_MEMORY
+ */
+static int dijkstraSlots(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                         int dist[], int parent[])
+{
+    struct VertexHeap heap;
+    if (!heapInit(&heap, workspace, graph->n, dist))
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    for (int v = 0; v < graph->n; v++)
+    {
+        dist[v] = GRAPH_INF;
+        if (parent)
+        {
+            parent[v] = -1;
+        }
+    }
+    dist[source] = 0;
+    heapDecrease(&heap, source);
+    STAT_PHASE(workspace, GRAPH_PHASE_SEARCH);
+
+    while (heap.size > 0)
+    {
+        int u = heapPopMin(&heap);
+        STAT_ADD(heap.stats, edgesScanned, graph->offset[u + 1] - graph->offset[u]);
+        TRACE_VERBOSE("dijkstra", "settle", "\"vertex\": %d, \"dist\": %d", slotVertex(graph, u),
+                      dist[u]);
+
+        // Relax every arc leaving the settled vertex
+        if (isCompressed(graph))
+        {
+            struct ArcCursor arcs;
+            for (arcsBegin(graph, u, &arcs); arcsNext(graph, &arcs, true);)
+            {
+                relaxArc(&heap, dist, parent, u, arcs.target, arcs.weight);
+            }
+            continue;
+        }
+        for (int a = graph->offset[u]; a < graph->offset[u + 1]; a++)
+        {
+            relaxArc(&heap, dist, parent, u, graph->target[a], graph->weight[a]);
+        }
+    }
+    return GRAPH_OK;
+}
+
+/**
+ * @brief Check a saturating run for a reachable vertex whose distance was clamped
+ *
+ * A vertex is reachable if an arc leads to it from a vertex whose distance
+ * is not GRAPH_INF, so one pass over the arcs finds every reachable vertex
+ * left at GRAPH_INF and every vertex clamped to -GRAPH_INF: O(V + E).
+ *
+ * @param graph Graph with widePaths set
+ * @param dist Distances by slot
+ * @param status Result of the run
+ * @return status, or GRAPH_OVERFLOW if it is GRAPH_OK and a distance saturated
+ */
+static int saturationStatus(const struct Graph *graph, const int dist[], int status)
+{
+    for (int u = 0; u < graph->n && status == GRAPH_OK; u++)
+    {
+        if (dist[u] == GRAPH_INF)
+        {
+            continue;
+        }
+        if (dist[u] == -GRAPH_INF)
+        {
+            return GRAPH_OVERFLOW;
+        }
+        if (isCompressed(graph))
+        {
+            struct ArcCursor arcs;
+            for (arcsBegin(graph, u, &arcs); arcsNext(graph, &arcs, false);)
+            {
+                if (dist[arcs.target] == GRAPH_INF)
+                {
+                    return GRAPH_OVERFLOW;
+                }
+            }
+            continue;
+        }
+        for (int a = graph->offset[u]; a < graph->offset[u + 1]; a++)
+        {
+            if (dist[graph->target[a]] == GRAPH_INF)
+            {
+                return GRAPH_OVERFLOW;
+            }
+        }
+    }
+    return status;
+}
+
+int graphDijkstraWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                    int dist[], int parent[])
+{
+    if (!graph || !dist || source < 0 || source >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (graph->wideArc)
+    {
+        return GRAPH_WEIGHT_TYPE;
+    }
+    if (graph->minWeight < 0)
+    {
+        return GRAPH_NEGATIVE_WEIGHT;
+    }
+
+    // Sums that may overflow int take the saturating kernel, which is then
+    // checked for distances that did overflow
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int *slotDist = ws ? slotArray(graph, ws, dist) : NULL;
+    int *slotParent = ws ? slotArray(graph, ws, parent) : NULL;
+    int status = GRAPH_NO_MEMORY;
+    if (slotDist && (slotParent || !parent))
+    {
+        status = (graph->widePaths ? saturatingDijkstra : dijkstraSlots)(
+            graph, ws, vertexSlot(graph, source), slotDist, slotParent);
+        status = graph->widePaths ? saturationStatus(graph, slotDist, status) : status;
+        TRACE_INFO("dijkstra", "done", "\"source\": %d, \"vertices\": %d, \"status\": \"%s\"",
+                   source, graph->n, graphStatusMessage(status));
+        STAT_PHASE(ws, GRAPH_PHASE_EXPORT);
+        exportSlots(graph, slotDist, dist, false);
+        exportSlots(graph, slotParent, parent, true);
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphDijkstra(const struct Graph *graph, int source, int dist[], int parent[])
+{
+    return graphDijkstraWs(graph, NULL, source, dist, parent);
+}
+
+/**
+ * @brief Extend a distance by one arc
+ * @param dist Distance other than GRAPH_INF
+ * @param weight Arc weight
+ * @param saturate Clamp to ±GRAPH_INF instead of wrapping (graphs with widePaths)
+ * @return dist + weight
+ */
+static inline int extend(int dist, int weight, bool saturate)
+{
+    int sum;
+    if (__builtin_add_overflow(dist, weight, &sum) && saturate)
+    {
+        return weight > 0 ? GRAPH_INF : -GRAPH_INF;
+    }
+    return sum;
+}
+
+/**
+ * @brief Relax one arc u → v for Bellman-Ford
+ * @param dist Distances
+ * @param parent Parents (may be NULL)
+ * @param u Tail
+ * @param v Head
+ * @param weight Arc weight
+ * @param saturate Clamp the sum to ±GRAPH_INF
+ * @return true if dist[v] was lowered
+ */
+static bool relax(int dist[], int parent[], int u, int v, int weight, bool saturate)
+{
+    int candidate = dist[u] != GRAPH_INF ? extend(dist[u], weight, saturate) : GRAPH_INF;
+    if (candidate < dist[v])
+    {
+        dist[v] = candidate;
+        if (parent)
+        {
+            parent[v] = u;
+        }
+        return true;
+    }
+    return false;
+}
+
+int bellmanFordCheckpointed(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                            int dist[], int parent[], struct Checkpointer *checkpoint)
+{
+    for (int v = 0; v < graph->n; v++)
+    {
+        dist[v] = GRAPH_INF;
+        if (parent)
+        {
+            parent[v] = -1;
+        }
+    }
+    dist[source] = 0;
+
+    // A snapshot taken after pass k resumes with pass k + 1
+    long long done = 0;
+    if (checkpoint)
+    {
+        int status = checkpointRestore(checkpoint, graph->n, dist, parent, &done);
+        if (status != GRAPH_OK)
+        {
+            return status;
+        }
+        done = done < 0 ? 0 : done;
+    }
+    STAT_PHASE(workspace, GRAPH_PHASE_SEARCH);
+
+    // Relax all edges up to V - 1 times; an undirected edge is two arcs.
+    // Graphs with widePaths only get here with checkpoints
+    bool saturate = graph->widePaths;
+    bool updated = true;
+    for (int pass = (int)done + 1; pass < graph->n && updated; pass++)
+    {
+        updated = false;
+        for (int i = 0; i < graph->edgeCount; i++)
+        {
+            const struct GraphEdge *e = &graph->edges[i];
+            bool lowered = relax(dist, parent, e->u, e->v, e->weight, saturate);
+            if (!graph->directed)
+            {
+                lowered |= relax(dist, parent, e->v, e->u, e->weight, saturate);
+            }
+            STAT_ADD(&workspace->stats, relaxations, lowered);
+            updated |= lowered;
+        }
+        STAT_ADD(&workspace->stats, passes, 1);
+        STAT_ADD(&workspace->stats, edgesScanned, graph->arcCount);
+        TRACE_DEBUG("bellman-ford", "pass", "\"pass\": %d, \"updated\": %s", pass,
+                    updated ? "true" : "false");
+        if (checkpoint && updated && checkpointDue(checkpoint))
+        {
+            checkpointSave(checkpoint, pass, graph->n, dist, parent);
+        }
+    }
+    if (!updated)
+    {
+        // Converged: no further pass can change anything
+        return saturate ? saturationStatus(graph, dist, GRAPH_OK) : GRAPH_OK;
+    }
+
+    // Any edge that can still be relaxed lies on or behind a negative cycle
+    for (int i = 0; i < graph->edgeCount; i++)
+    {
+        const struct GraphEdge *e = &graph->edges[i];
+        if (dist[e->u] != GRAPH_INF && extend(dist[e->u], e->weight, saturate) < dist[e->v])
+        {
+            return GRAPH_NEGATIVE_CYCLE;
+        }
+        if (!graph->directed && dist[e->v] != GRAPH_INF &&
+            extend(dist[e->v], e->weight, saturate) < dist[e->u])
+        {
+            return GRAPH_NEGATIVE_CYCLE;
+        }
+    }
+    return saturate ? saturationStatus(graph, dist, GRAPH_OK) : GRAPH_OK;
+}
+
+/**
+ * @brief Run Bellman-Ford on the slots of a graph
+ * @param graph Graph
+ * @param workspace Workspace of the query (statistics only)
+ * @param source Source slot
+ * @param dist Output: n distances by slot
+ * @param parent Output: n parent slots by slot (may be NULL)
+ * @return GRAPH_OK or GRAPH_NEGATIVE_CYCLE
+ */
+static int bellmanFordSlots(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                            int dist[], int parent[])
+{
+    return bellmanFordCheckpointed(graph, workspace, source, dist, parent, NULL);
+}
+
+int graphBellmanFordWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                       int dist[], int parent[])
+{
+    if (!graph || !dist || source < 0 || source >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (isCompressed(graph))
+    {
+        return GRAPH_NEEDS_EDGE_LIST;
+    }
+    if (graph->wideArc)
+    {
+        return GRAPH_WEIGHT_TYPE;
+    }
+
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int *slotDist = ws ? slotArray(graph, ws, dist) : NULL;
+    int *slotParent = ws ? slotArray(graph, ws, parent) : NULL;
+    int status = GRAPH_NO_MEMORY;
+    if (slotDist && (slotParent || !parent))
+    {
+        status = (graph->widePaths ? saturatingBellmanFord : bellmanFordSlots)(
+            graph, ws, vertexSlot(graph, source), slotDist, slotParent);
+        status = graph->widePaths ? saturationStatus(graph, slotDist, status) : status;
+        TRACE_INFO("bellman-ford", "done", "\"source\": %d, \"status\": \"%s\"", source,
+                   graphStatusMessage(status));
+        STAT_PHASE(ws, GRAPH_PHASE_EXPORT);
+        exportSlots(graph, slotDist, dist, false);
+        exportSlots(graph, slotParent, parent, true);
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphBellmanFord(const struct Graph *graph, int source, int dist[], int parent[])
+{
+    return graphBellmanFordWs(graph, NULL, source, dist, parent);
+}
+
+/**
+ * @brief VECTOR_LANES distances (or parents) of one vertex, one per source
+ *
+ * A GCC vector: arithmetic and comparisons work lane by lane and compile
+ * to SIMD instructions; a comparison yields -1 in true lanes, 0 elsewhere.
+ */
+typedef int LaneVector __attribute__((vector_size(VECTOR_LANES * sizeof(int))));
+
+/**
+ * @brief Structure to hold one group of sources of a batched Bellman-Ford
+ *
+ * dist[v * BF_VECTORS .. v * BF_VECTORS + BF_VECTORS - 1] hold the
+ * distances of vertex v from every source of the group, so relaxing an
+ * edge for all of them reads one 64-byte line per endpoint.
+ */
+struct BellmanFordGroup
+{
+    const struct Graph *graph;
+    LaneVector *dist;               // n × BF_VECTORS distance vectors by slot
+    LaneVector *parent;             // n × BF_VECTORS parent slot vectors (NULL = not wanted)
+    LaneVector lowered[BF_VECTORS]; // Distances every lane lowered in the current pass
+    LaneVector cycle[BF_VECTORS];   // -1 in lanes that reached a negative cycle
+    int lanes;                      // Lanes holding a source (the rest stay GRAPH_INF)
+    int source[BF_LANES];           // Source slot of every used lane
+    long long relaxations;          // Successful relaxations of all lanes
+    int passes;                     // Passes run
+};
+
+/**
+ * @brief Relax arc u → v (u may equal v) in every lane
+ *
+ * An unreached lane adds 0 instead of the weight, keeping GRAPH_INF
+ * without overflowing.
+ *
+ * @param group Group
+ * @param u Tail slot
+ * @param v Head slot
+ * @param weight Arc weight
+ */
+static inline void relaxLanes(struct BellmanFordGroup *group, int u, int v, int weight)
+{
+    LaneVector *du = group->dist + (size_t)u * BF_VECTORS;
+    LaneVector *dv = group->dist + (size_t)v * BF_VECTORS;
+    LaneVector *pv = group->parent ? group->parent + (size_t)v * BF_VECTORS : NULL;
+
+    for (int k = 0; k < BF_VECTORS; k++)
+    {
+        LaneVector from = du[k];
+        LaneVector to = dv[k];
+        LaneVector candidate = from + ((from != GRAPH_INF) & weight);
+        LaneVector lower = candidate < to;
+
+        dv[k] = (candidate & lower) | (to & ~lower);
+        if (pv)
+        {
+            pv[k] = (lower & u) | (pv[k] & ~lower);
+        }
+        group->lowered[k] -= lower; // lower is -1 where a lane improved
+    }
+}
+
+/**
+ * @brief Mark the lanes in which arc u → v can still be relaxed
+ * @param group Group
+ * @param u Tail slot
+ * @param v Head slot
+ * @param weight Arc weight
+ */
+static inline void checkLanes(struct BellmanFordGroup *group, int u, int v, int weight)
+{
+    const LaneVector *du = group->dist + (size_t)u * BF_VECTORS;
+    const LaneVector *dv = group->dist + (size_t)v * BF_VECTORS;
+    for (int k = 0; k < BF_VECTORS; k++)
+    {
+        group->cycle[k] |= du[k] + ((du[k] != GRAPH_INF) & weight) < dv[k];
+    }
+}
+
+/**
+ * @brief Run Bellman-Ford for one group of sources (pool task)
+ * @param context Array of struct BellmanFordGroup
+ * @param g Index of the group
+ */
+static void bellmanFordGroup(void *context, int g)
+{
+    struct BellmanFordGroup *group = (struct BellmanFordGroup *)context + g;
+    const struct Graph *graph = group->graph;
+    LaneVector unreached = (LaneVector){0} + GRAPH_INF;
+    LaneVector none = (LaneVector){0} - 1;
+
+    for (size_t k = 0; k < (size_t)graph->n * BF_VECTORS; k++)
+    {
+        group->dist[k] = unreached;
+        if (group->parent)
+        {
+            group->parent[k] = none;
+        }
+    }
+    for (int j = 0; j < group->lanes; j++)
+    {
+        group->dist[(size_t)group->source[j] * BF_VECTORS + j / VECTOR_LANES][j % VECTOR_LANES] = 0;
+    }
+
+    // Every pass loads each edge once for all lanes; stop once no lane changes
+    bool updated = true;
+    for (int pass = 1; pass < graph->n && updated; pass++)
+    {
+        memset(group->lowered, 0, sizeof(group->lowered));
+        for (int i = 0; i < graph->edgeCount; i++)
+        {
+            const struct GraphEdge *e = &graph->edges[i];
+            relaxLanes(group, e->u, e->v, e->weight);
+            if (!graph->directed)
+            {
+                relaxLanes(group, e->v, e->u, e->weight);
+            }
+        }
+
+        updated = false;
+        for (int j = 0; j < BF_LANES; j++)
+        {
+            int lowered = group->lowered[j / VECTOR_LANES][j % VECTOR_LANES];
+            group->relaxations += lowered;
+            updated |= lowered > 0;
+        }
+        group->passes++;
+        TRACE_DEBUG("bellman-ford", "batch_pass", "\"group\": %d, \"pass\": %d", g, pass);
+    }
+    if (!updated)
+    {
+        return; // Every lane converged
+    }
+
+    // Lanes whose distances can still drop reached a negative cycle
+    for (int i = 0; i < graph->edgeCount; i++)
+    {
+        const struct GraphEdge *e = &graph->edges[i];
+        checkLanes(group, e->u, e->v, e->weight);
+        if (!graph->directed)
+        {
+            checkLanes(group, e->v, e->u, e->weight);
+        }
+    }
+}
+
+int graphBellmanFordBatchWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                            const int sources[], int count, int dist[], int parent[],
+                            int status[])
+{
+    if (!graph || !sources || !dist || !status || count < 0)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (sources[i] < 0 || sources[i] >= graph->n)
+        {
+            return GRAPH_INVALID_ARGUMENT;
+        }
+    }
+    if (isCompressed(graph))
+    {
+        return GRAPH_NEEDS_EDGE_LIST;
+    }
+    if (graph->wideArc)
+    {
+        return GRAPH_WEIGHT_TYPE;
+    }
+    if (graph->widePaths)
+    {
+        // The lanes add without saturating: run the sources one at a time
+        int result = GRAPH_OK;
+        for (int i = 0; i < count && result != GRAPH_NO_MEMORY; i++)
+        {
+            size_t row = (size_t)i * graph->n;
+            status[i] = graphBellmanFordWs(graph, workspace, sources[i], dist + row,
+                                           parent ? parent + row : NULL);
+            result = status[i] == GRAPH_OK ? result : status[i];
+        }
+        return result;
+    }
+
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int n = graph->n;
+    int groups = (count + BF_LANES - 1) / BF_LANES;
+
+    // Every group gets its own blocks, so groups run in parallel
+    struct BellmanFordGroup *group = ws ? wsAlloc(ws, groups * sizeof(*group) + 1) : NULL;
+    bool ready = group != NULL;
+    for (int g = 0; g < groups && ready; g++)
+    {
+        memset(&group[g], 0, sizeof(*group));
+        group[g].graph = graph;
+        group[g].dist = wsAlloc(ws, (size_t)n * BF_VECTORS * sizeof(LaneVector));
+        group[g].parent = parent ? wsAlloc(ws, (size_t)n * BF_VECTORS * sizeof(LaneVector)) : NULL;
+        group[g].lanes = count - g * BF_LANES < BF_LANES ? count - g * BF_LANES : BF_LANES;
+        for (int j = 0; j < group[g].lanes; j++)
+        {
+            group[g].source[j] = vertexSlot(graph, sources[g * BF_LANES + j]);
+        }
+        ready = group[g].dist && (group[g].parent || !parent);
+    }
+    if (!ready)
+    {
+        wsEnd(owned);
+        return GRAPH_NO_MEMORY;
+    }
+
+    STAT_PHASE(ws, GRAPH_PHASE_SEARCH);
+    poolFor(groups, bellmanFordGroup, group);
+
+    // Transpose the lanes back to one row per source, in vertex IDs
+    STAT_PHASE(ws, GRAPH_PHASE_EXPORT);
+    int result = GRAPH_OK;
+    for (int i = 0; i < count; i++)
+    {
+        const struct BellmanFordGroup *own = &group[i / BF_LANES];
+        int k = i % BF_LANES / VECTOR_LANES;
+        int lane = i % VECTOR_LANES;
+        for (int p = 0; p < n; p++)
+        {
+            size_t cell = (size_t)p * BF_VECTORS + k;
+            int v = slotVertex(graph, p);
+            dist[(size_t)i * n + v] = own->dist[cell][lane];
+            if (parent)
+            {
+                int u = own->parent[cell][lane];
+                parent[(size_t)i * n + v] = u >= 0 ? slotVertex(graph, u) : -1;
+            }
+        }
+        status[i] = own->cycle[k][lane] ? GRAPH_NEGATIVE_CYCLE : GRAPH_OK;
+        result = status[i] != GRAPH_OK ? GRAPH_NEGATIVE_CYCLE : result;
+    }
+    for (int g = 0; g < groups; g++)
+    {
+        STAT_ADD(&ws->stats, relaxations, group[g].relaxations);
+        STAT_ADD(&ws->stats, passes, group[g].passes);
+        STAT_ADD(&ws->stats, edgesScanned, (long long)group[g].passes * graph->arcCount);
+    }
+    STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    TRACE_INFO("bellman-ford", "batch_done", "\"sources\": %d, \"groups\": %d, \"status\": \"%s\"",
+               count, groups, graphStatusMessage(result));
+
+    wsEnd(owned);
+    return result;
+}
+
+int graphBellmanFordBatch(const struct Graph *graph, const int sources[], int count, int dist[],
+                          int parent[], int status[])
+{
+    return graphBellmanFordBatchWs(graph, NULL, sources, count, dist, parent, status);
+}
+
+int graphBfsWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source, int threads,
+               int dist[], int parent[])
+{
+    if (!graph || !dist || source < 0 || source >= graph->n || threads < 0)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    struct BfsGraph bfsGraph = {graph->n, graph->offset, graph->target, graph->offset,
+                                graph->target, NULL, NULL, NULL};
+    if (isCompressed(graph))
+    {
+        // Decode arcs as they are scanned; a directed graph has no in-arcs to go bottom-up with
+        bfsGraph.compressed = graph;
+        bfsGraph.inOffset = graph->directed ? NULL : graph->offset;
+    }
+    else if (ws && graph->directed)
+    {
+        // Bottom-up levels look for parents along in-arcs
+        if (!wsInArcs(ws, graph))
+        {
+            ws = NULL;
+        }
+        else
+        {
+            bfsGraph.inOffset = ws->inOffset;
+            bfsGraph.inSource = ws->inSource;
+        }
+    }
+
+    struct BfsEngine *engine = ws ? wsBfsEngine(ws, graph->n, threads) : NULL;
+    int *slotDist = engine ? slotArray(graph, ws, dist) : NULL;
+    int *slotParent = engine ? slotArray(graph, ws, parent) : NULL;
+    int status = GRAPH_NO_MEMORY;
+    if (slotDist && (slotParent || !parent))
+    {
+        STAT_PHASE(ws, GRAPH_PHASE_SEARCH);
+        STAT_ADD(&ws->stats, edgesScanned, -engine->arcsScanned);
+        bfsSearch(engine, &bfsGraph, vertexSlot(graph, source), -1, slotDist, slotParent, NULL);
+        STAT_ADD(&ws->stats, edgesScanned, engine->arcsScanned);
+        STAT_ADD(&ws->stats, passes, engine->levels);
+        TRACE_INFO("bfs", "done", "\"source\": %d, \"levels\": %d, \"bottom_up_levels\": %d",
+                   source, engine->levels, engine->bottomUpLevels);
+        STAT_PHASE(ws, GRAPH_PHASE_EXPORT);
+        for (int v = 0; v < graph->n; v++)
+        {
+            if (slotDist[v] == -1)
+            {
+                slotDist[v] = GRAPH_INF;
+            }
+        }
+        exportSlots(graph, slotDist, dist, false);
+        exportSlots(graph, slotParent, parent, true);
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+        status = GRAPH_OK;
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphBfs(const struct Graph *graph, int source, int threads, int dist[], int parent[])
+{
+    return graphBfsWs(graph, NULL, source, threads, dist, parent);
+}
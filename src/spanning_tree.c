@@ -0,0 +1,302 @@
+/**
+ * @file spanning_tree.c
+ * @brief Minimum spanning trees of libgraph: Kruskal and Prim
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * Kruskal sorts the edges once and joins components with a union-find
+ * structure (union by size, path halving). Prim grows one tree from a
+ * root with an indexed binary heap over the CSR arcs (or the decoded
+ * arcs of a compressed graph).
+ *
+ * Scratch arrays come from the query's workspace (see workspace.c).
+ *
+ * Time Complexity: O(E log E) for Kruskal, O((V + E) log V) for Prim
+ * Space Complexity: O(V + E) for Kruskal, O(V) for Prim
+ */
+
+#include <stdlib.h>
+
+#include "graph_internal.h"
+
+/**
+ * @brief Find the representative of a vertex's set, halving the path
+ * @param link Parent links of the union-find forest
+ * @param v Vertex
+ * @return Representative of the set containing v
+ */
+static int findSet(int link[], int v)
+{
+    while (link[v] != v)
+    {
+        link[v] = link[link[v]];
+        v = link[v];
+    }
+    return v;
+}
+
+/**
+ * @brief Structure to hold the sort key of one edge
+ */
+struct EdgeKey
+{
+    int weight; // Edge weight
+    int index;  // Position in the input edge list
+};
+
+/**
+ * @brief Order edges by weight, then by input position for a stable result
+ * @param a Pointer to the first struct EdgeKey
+ * @param b Pointer to the second struct EdgeKey
+ * @return Negative, zero or positive as for qsort()
+ */
+static int compareByWeight(const void *a, const void *b)
+{
+    const struct EdgeKey *x = a, *y = b;
+    if (x->weight != y->weight)
+    {
+        return x->weight < y->weight ? -1 : 1;
+    }
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+int graphKruskalWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                   struct GraphEdge tree[], int *treeEdges, long long *totalWeight)
+{
+    if (!graph || !tree || !treeEdges)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (graph->directed)
+    {
+        return GRAPH_NEEDS_UNDIRECTED;
+    }
+    if (isCompressed(graph))
+    {
+        return GRAPH_NEEDS_EDGE_LIST;
+    }
+    if (graph->wideArc)
+    {
+        return GRAPH_WEIGHT_TYPE;
+    }
+
+    int n = graph->n, m = graph->edgeCount;
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    struct EdgeKey *order = ws ? wsAlloc(ws, m * sizeof(struct EdgeKey)) : NULL;
+    int *link = ws ? wsAlloc(ws, n * sizeof(int)) : NULL;
+    int *size = ws ? wsAlloc(ws, n * sizeof(int)) : NULL;
+    if (!order || !link || !size)
+    {
+        wsEnd(owned);
+        return GRAPH_NO_MEMORY;
+    }
+
+    // Sort edge indices by weight without touching the graph
+    STAT_PHASE(ws, GRAPH_PHASE_SORT);
+    for (int i = 0; i < m; i++)
+    {
+        order[i].weight = graph->edges[i].weight;
+        order[i].index = i;
+    }
+    qsort(order, m, sizeof(struct EdgeKey), compareByWeight);
+    STAT_PHASE(ws, GRAPH_PHASE_SEARCH);
+
+    for (int v = 0; v < n; v++)
+    {
+        link[v] = v;
+        size[v] = 1;
+    }
+
+    long long total = 0;
+    int count = 0;
+    for (int k = 0; k < m && count < n - 1; k++)
+    {
+        const struct GraphEdge *e = &graph->edges[order[k].index];
+        int a = findSet(link, e->u);
+        int b = findSet(link, e->v);
+        STAT_ADD(&ws->stats, edgesScanned, 1);
+        STAT_ADD(&ws->stats, findCalls, 2);
+        if (a == b)
+        {
+            TRACE_VERBOSE("kruskal", "skip", "\"u\": %d, \"v\": %d, \"weight\": %d",
+                          slotVertex(graph, e->u), slotVertex(graph, e->v), e->weight);
+            continue; // Would close a cycle
+        }
+
+        // Hang the smaller set below the larger one
+        if (size[a] < size[b])
+        {
+            int tmp = a;
+            a = b;
+            b = tmp;
+        }
+        link[b] = a;
+        size[a] += size[b];
+        STAT_ADD(&ws->stats, unionCalls, 1);
+
+        tree[count] = *e;
+        tree[count].u = slotVertex(graph, e->u);
+        tree[count].v = slotVertex(graph, e->v);
+        TRACE_VERBOSE("kruskal", "accept", "\"u\": %d, \"v\": %d, \"weight\": %d", tree[count].u,
+                      tree[count].v, e->weight);
+        count++;
+        total += e->weight;
+    }
+    STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    TRACE_INFO("kruskal", "done", "\"tree_edges\": %d, \"total_weight\": %lld", count, total);
+    wsEnd(owned);
+
+    *treeEdges = count;
+    if (totalWeight)
+    {
+        *totalWeight = total;
+    }
+    return n > 0 && count < n - 1 ? GRAPH_NOT_CONNECTED : GRAPH_OK;
+}
+
+int graphKruskal(const struct Graph *graph, struct GraphEdge tree[], int *treeEdges,
+                 long long *totalWeight)
+{
+    return graphKruskalWs(graph, NULL, tree, treeEdges, totalWeight);
+}
+
+/**
+ * @brief Make u → v the cheapest link of v if it beats the current one
+ * @param heap Heap of the search
+ * @param key Cheapest link weights
+ * @param parent Parents
+ * @param u Vertex just added to the tree
+ * @param v Head
+ * @param weight Arc weight
+ */
+static inline void offerArc(struct VertexHeap *heap, int key[], int parent[], int u, int v,
+                            int weight)
+{
+    if (!heapPopped(heap, v) && weight < key[v])
+    {
+        key[v] = weight;
+        parent[v] = u;
+        heapDecrease(heap, v);
+        STAT_ADD(heap->stats, relaxations, 1);
+    }
+}
+
+/**
+ * @brief Run Prim's algorithm on the slots of a graph
+ * @param graph Undirected graph
+ * @param workspace Workspace of the query
+ * @param root Root slot
+ * @param parent Output: n parent slots by slot
+ * @param weight Output: n parent edge weights by slot (may be NULL)
+ * @param totalWeight Output: sum of the tree edge weights (may be NULL)
+ * @return GRAPH_OK, GRAPH_NOT_CONNECTED or GRAPH_NO_MEMORY
+ */
+static int primSlots(const struct Graph *graph, struct GraphWorkspace *workspace, int root,
+                     int parent[], int weight[], long long *totalWeight)
+{
+    int n = graph->n;
+    int *key = wsAlloc(workspace, n * sizeof(int));
+    if (!key)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    for (int v = 0; v < n; v++)
+    {
+        key[v] = GRAPH_INF;
+        parent[v] = -1;
+    }
+
+    // A vertex is in the tree once the heap has popped it
+    struct VertexHeap heap;
+    if (!heapInit(&heap, workspace, n, key))
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    key[root] = 0;
+    heapDecrease(&heap, root);
+    STAT_PHASE(workspace, GRAPH_PHASE_SEARCH);
+
+    long long total = 0;
+    int reached = 0;
+    while (heap.size > 0)
+    {
+        int u = heapPopMin(&heap);
+        total += key[u];
+        reached++;
+        TRACE_VERBOSE("prim", "add", "\"vertex\": %d, \"parent\": %d, \"weight\": %d",
+                      slotVertex(graph, u), parent[u] == -1 ? -1 : slotVertex(graph, parent[u]),
+                      key[u]);
+        STAT_ADD(heap.stats, edgesScanned, graph->offset[u + 1] - graph->offset[u]);
+
+        // Offer every arc leaving the tree as the new cheapest link
+        if (isCompressed(graph))
+        {
+            struct ArcCursor arcs;
+            for (arcsBegin(graph, u, &arcs); arcsNext(graph, &arcs, true);)
+            {
+                offerArc(&heap, key, parent, u, arcs.target, arcs.weight);
+            }
+            continue;
+        }
+        for (int a = graph->offset[u]; a < graph->offset[u + 1]; a++)
+        {
+            offerArc(&heap, key, parent, u, graph->target[a], graph->weight[a]);
+        }
+    }
+
+    STAT_PHASE(workspace, GRAPH_PHASE_EXPORT);
+    TRACE_INFO("prim", "done", "\"reached\": %d, \"vertices\": %d, \"total_weight\": %lld",
+               reached, n, total);
+    if (weight)
+    {
+        for (int v = 0; v < n; v++)
+        {
+            weight[v] = parent[v] == -1 ? 0 : key[v];
+        }
+    }
+    if (totalWeight)
+    {
+        *totalWeight = total;
+    }
+    return reached < n ? GRAPH_NOT_CONNECTED : GRAPH_OK;
+}
+
+int graphPrimWs(const struct Graph *graph, struct GraphWorkspace *workspace, int root,
+                int parent[], int weight[], long long *totalWeight)
+{
+    if (!graph || !parent || root < 0 || root >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (graph->directed)
+    {
+        return GRAPH_NEEDS_UNDIRECTED;
+    }
+    if (graph->wideArc)
+    {
+        return GRAPH_WEIGHT_TYPE;
+    }
+
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int *slotParent = ws ? slotArray(graph, ws, parent) : NULL;
+    int *slotWeight = ws ? slotArray(graph, ws, weight) : NULL;
+    int status = GRAPH_NO_MEMORY;
+    if (slotParent && (slotWeight || !weight))
+    {
+        status = primSlots(graph, ws, vertexSlot(graph, root), slotParent, slotWeight, totalWeight);
+        exportSlots(graph, slotParent, parent, true);
+        exportSlots(graph, slotWeight, weight, false);
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphPrim(const struct Graph *graph, int root, int parent[], int weight[],
+              long long *totalWeight)
+{
+    return graphPrimWs(graph, NULL, root, parent, weight, totalWeight);
+}
@@ -0,0 +1,566 @@
+/**
+ * @file typed.c
+ * @brief Graphs with int64, float or double weights and their typed queries
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * weight_kernels.h is instantiated once per weight type. A typed graph
+ * whose weights are all integral and whose path and flow sums fit int
+ * is narrowed at creation: it is an ordinary int graph that remembers
+ * its type, so it keeps the int32 kernels (the fastest: half the bytes
+ * per weight, no saturation checks) and reordering and compression, and
+ * its typed queries widen the int results in place. Any other typed
+ * graph keeps its weights in their own type next to a clamped int copy
+ * and is answered by the kernels of that type. The int32 instantiation
+ * also gives the int API saturating kernels for int graphs whose sums
+ * may overflow.
+ *
+ * Time Complexity: as the int kernels
+ * Space Complexity: O(V + E) of the weight type per query
+ */
+
+#include <math.h> // INFINITY and isnan() only, no libm
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph_internal.h"
+
+#define W int
+#define W_NAME(name) name##Int32
+#define W_INF GRAPH_INF
+#define W_FLOATING 0
+#define W_SUM long long
+#define W_SUM_INF LLONG_MAX
+#define W_TOLERANCE 0
+#define W_ARC(graph, a) ((graph)->weight[a])
+#define W_EDGE(graph, i) ((graph)->edges[i].weight)
+#include "weight_kernels.h"
+
+#define W long long
+#define W_NAME(name) name##Int64
+#define W_INF LLONG_MAX
+#define W_FLOATING 0
+#define W_SUM long long
+#define W_SUM_INF LLONG_MAX
+#define W_TOLERANCE 0
+#define W_ARC(graph, a) (((const long long *)(graph)->wideArc)[a])
+#define W_EDGE(graph, i) (((const long long *)(graph)->wideEdge)[i])
+#include "weight_kernels.h"
+
+#define W float
+#define W_NAME(name) name##Float
+#define W_INF INFINITY
+#define W_FLOATING 1
+#define W_SUM double
+#define W_SUM_INF INFINITY
+#define W_TOLERANCE 1e-6
+#define W_ARC(graph, a) (((const float *)(graph)->wideArc)[a])
+#define W_EDGE(graph, i) (((const float *)(graph)->wideEdge)[i])
+#include "weight_kernels.h"
+
+#define W double
+#define W_NAME(name) name##Double
+#define W_INF INFINITY
+#define W_FLOATING 1
+#define W_SUM double
+#define W_SUM_INF INFINITY
+#define W_TOLERANCE 1e-12
+#define W_ARC(graph, a) (((const double *)(graph)->wideArc)[a])
+#define W_EDGE(graph, i) (((const double *)(graph)->wideEdge)[i])
+#include "weight_kernels.h"
+
+/**
+ * @brief Read one caller weight as a double
+ * @param weightType enum GraphWeightType
+ * @param weights Caller's weight array
+ * @param i Index
+ * @return weights[i]
+ */
+static double weightAt(int weightType, const void *weights, int i)
+{
+    switch (weightType)
+    {
+    case GRAPH_WEIGHT_INT32:
+        return ((const int *)weights)[i];
+    case GRAPH_WEIGHT_INT64:
+        return (double)((const long long *)weights)[i];
+    case GRAPH_WEIGHT_FLOAT:
+        return ((const float *)weights)[i];
+    default:
+        return ((const double *)weights)[i];
+    }
+}
+
+/**
+ * @brief Clamp a weight to int, keeping its sign
+ *
+ * Fractions round toward minus infinity so that a negative weight never
+ * becomes 0.
+ *
+ * @param weightType enum GraphWeightType
+ * @param weights Caller's weight array
+ * @param i Index
+ * @return weights[i] clamped to ±GRAPH_INF
+ */
+static int clampedWeight(int weightType, const void *weights, int i)
+{
+    if (weightType == GRAPH_WEIGHT_INT64)
+    {
+        long long w = ((const long long *)weights)[i]; // Exact beyond 2^53
+        return w > GRAPH_INF ? GRAPH_INF : w < -GRAPH_INF ? -GRAPH_INF : (int)w;
+    }
+    double w = weightAt(weightType, weights, i);
+    if (w >= GRAPH_INF || w <= -GRAPH_INF)
+    {
+        return w > 0 ? GRAPH_INF : -GRAPH_INF;
+    }
+    int truncated = (int)w;
+    return truncated > w ? truncated - 1 : truncated;
+}
+
+/**
+ * @brief Check whether a weight is an integer int can hold
+ * @param weightType enum GraphWeightType
+ * @param weights Caller's weight array
+ * @param i Index
+ * @return true if weights[i] survives a round trip through int
+ */
+static bool fitsInt(int weightType, const void *weights, int i)
+{
+    if (weightType == GRAPH_WEIGHT_INT64)
+    {
+        long long w = ((const long long *)weights)[i];
+        return w >= -GRAPH_INF && w <= GRAPH_INF;
+    }
+    double w = weightAt(weightType, weights, i);
+    return w >= -GRAPH_INF && w <= GRAPH_INF && w == (int)w;
+}
+
+int graphCreateTyped(int n, int edgeCount, const struct GraphEdge edges[], int weightType,
+                     const void *weights, bool directed, struct Graph **graph)
+{
+    if (!graph || n < 0 || edgeCount < 0 || (edgeCount > 0 && (!edges || !weights)) ||
+        weightType < GRAPH_WEIGHT_INT32 || weightType > GRAPH_WEIGHT_DOUBLE)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    bool narrow = true;
+    for (int i = 0; i < edgeCount; i++)
+    {
+        if (edges[i].u < 0 || edges[i].u >= n || edges[i].v < 0 || edges[i].v >= n ||
+            isnan(weightAt(weightType, weights, i)))
+        {
+            return GRAPH_INVALID_ARGUMENT;
+        }
+        narrow &= fitsInt(weightType, weights, i);
+    }
+
+    struct Graph *g = allocGraph(n, edgeCount, directed);
+    if (!g)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    g->weightType = weightType;
+    for (int i = 0; i < edgeCount; i++)
+    {
+        g->edges[i].u = edges[i].u;
+        g->edges[i].v = edges[i].v;
+        g->edges[i].weight = clampedWeight(weightType, weights, i);
+    }
+    buildArcs(g);
+
+    // Integral weights whose sums fit int need nothing but the int arrays;
+    // int32 sums that may overflow go to the saturating int32 kernels
+    if (weightType != GRAPH_WEIGHT_INT32 && (!narrow || g->widePaths || g->wideFlow))
+    {
+        size_t size = weightSize(weightType);
+        g->wideEdge = malloc(edgeCount * size + 1);
+        g->wideArc = malloc(g->arcCount * size + 1);
+        if (!g->wideEdge || !g->wideArc)
+        {
+            graphFree(g);
+            return GRAPH_NO_MEMORY;
+        }
+        memcpy(g->wideEdge, weights, edgeCount * size);
+        for (int a = 0; a < g->arcCount; a++)
+        {
+            memcpy((char *)g->wideArc + a * size, (const char *)weights + g->edgeOf[a] * size,
+                   size);
+        }
+    }
+
+    *graph = g;
+    return GRAPH_OK;
+}
+
+int graphWeightType(const struct Graph *graph)
+{
+    return graph->weightType;
+}
+
+bool graphHasIntWeights(const struct Graph *graph)
+{
+    return graph->wideArc == NULL;
+}
+
+int saturatingDijkstra(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                       int dist[], int parent[])
+{
+    return dijkstraInt32(graph, workspace, source, dist, parent);
+}
+
+int saturatingBellmanFord(const struct Graph *graph, struct GraphWorkspace *workspace,
+                          int source, int dist[], int parent[])
+{
+    return bellmanFordInt32(graph, workspace, source, dist, parent);
+}
+
+int saturatingMaxFlow(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                      int sink, int *flow, int edgeFlow[], struct Checkpointer *checkpoint)
+{
+    long long total = 0;
+    int status = maxFlowInt32(graph, workspace, source, sink, &total, edgeFlow, checkpoint);
+    if (total > GRAPH_INF)
+    {
+        *flow = GRAPH_INF;
+        return status == GRAPH_OK ? GRAPH_OVERFLOW : status;
+    }
+    *flow = (int)total;
+    return status;
+}
+
+/**
+ * @brief Widen int results in place to the graph's weight type
+ *
+ * 8-byte types are filled from the back and float from the front, so no
+ * int is overwritten before it is read.
+ *
+ * @param weightType enum GraphWeightType
+ * @param values Array holding count ints, with room for count weights
+ * @param count Number of values
+ * @param infinity true to map GRAPH_INF to the type's infinity
+ */
+static void widenInts(int weightType, void *values, int count, bool infinity)
+{
+    const int *in = values;
+    if (weightType == GRAPH_WEIGHT_INT64)
+    {
+        for (int i = count - 1; i >= 0; i--)
+        {
+            int v = in[i];
+            ((long long *)values)[i] = infinity && v == GRAPH_INF ? LLONG_MAX : v;
+        }
+    }
+    else if (weightType == GRAPH_WEIGHT_DOUBLE)
+    {
+        for (int i = count - 1; i >= 0; i--)
+        {
+            int v = in[i];
+            ((double *)values)[i] = infinity && v == GRAPH_INF ? INFINITY : v;
+        }
+    }
+    else if (weightType == GRAPH_WEIGHT_FLOAT)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            int v = in[i];
+            ((float *)values)[i] = infinity && v == GRAPH_INF ? INFINITY : (float)v;
+        }
+    }
+}
+
+/**
+ * @brief Store a tree weight or flow value as the sum type of a weight type
+ * @param weightType enum GraphWeightType
+ * @param out long long for integer types, double otherwise (may be NULL)
+ * @param integral Value for integer types
+ * @param real Value for float and double
+ */
+static void storeSum(int weightType, void *out, long long integral, double real)
+{
+    if (!out)
+    {
+        return;
+    }
+    if (weightType == GRAPH_WEIGHT_INT32 || weightType == GRAPH_WEIGHT_INT64)
+    {
+        *(long long *)out = integral;
+    }
+    else
+    {
+        *(double *)out = real;
+    }
+}
+
+int graphDijkstraTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                         void *dist, int parent[])
+{
+    if (!graph || !dist || source < 0 || source >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (!graph->wideArc)
+    {
+        int status = graphDijkstraWs(graph, workspace, source, dist, parent);
+        if (status == GRAPH_OK)
+        {
+            widenInts(graph->weightType, dist, graph->n, true);
+        }
+        return status;
+    }
+    if (graph->minWeight < 0)
+    {
+        return GRAPH_NEGATIVE_WEIGHT;
+    }
+
+    // Typed weights are never reordered, so slots are vertex IDs
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int status = GRAPH_NO_MEMORY;
+    if (ws)
+    {
+        switch (graph->weightType)
+        {
+        case GRAPH_WEIGHT_INT64:
+            status = dijkstraInt64(graph, ws, source, dist, parent);
+            break;
+        case GRAPH_WEIGHT_FLOAT:
+            status = dijkstraFloat(graph, ws, source, dist, parent);
+            break;
+        default:
+            status = dijkstraDouble(graph, ws, source, dist, parent);
+            break;
+        }
+        TRACE_INFO("dijkstra", "done", "\"source\": %d, \"vertices\": %d, \"status\": \"%s\"",
+                   source, graph->n, graphStatusMessage(status));
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphDijkstraTyped(const struct Graph *graph, int source, void *dist, int parent[])
+{
+    return graphDijkstraTypedWs(graph, NULL, source, dist, parent);
+}
+
+int graphBellmanFordTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                            int source, void *dist, int parent[])
+{
+    if (!graph || !dist || source < 0 || source >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (!graph->wideArc)
+    {
+        int status = graphBellmanFordWs(graph, workspace, source, dist, parent);
+        if (status == GRAPH_OK || status == GRAPH_NEGATIVE_CYCLE)
+        {
+            widenInts(graph->weightType, dist, graph->n, true);
+        }
+        return status;
+    }
+
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int status = GRAPH_NO_MEMORY;
+    if (ws)
+    {
+        switch (graph->weightType)
+        {
+        case GRAPH_WEIGHT_INT64:
+            status = bellmanFordInt64(graph, ws, source, dist, parent);
+            break;
+        case GRAPH_WEIGHT_FLOAT:
+            status = bellmanFordFloat(graph, ws, source, dist, parent);
+            break;
+        default:
+            status = bellmanFordDouble(graph, ws, source, dist, parent);
+            break;
+        }
+        TRACE_INFO("bellman-ford", "done", "\"source\": %d, \"status\": \"%s\"", source,
+                   graphStatusMessage(status));
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphBellmanFordTyped(const struct Graph *graph, int source, void *dist, int parent[])
+{
+    return graphBellmanFordTypedWs(graph, NULL, source, dist, parent);
+}
+
+int graphKruskalTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace,
+                        int treeEdge[], int *treeEdges, void *totalWeight)
+{
+    if (!graph || !treeEdge || !treeEdges)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (graph->directed)
+    {
+        return GRAPH_NEEDS_UNDIRECTED;
+    }
+    if (isCompressed(graph))
+    {
+        return GRAPH_NEEDS_EDGE_LIST;
+    }
+
+    // Kruskal only compares and adds weights, so even int graphs take the
+    // template to report edge indices
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int status = GRAPH_NO_MEMORY;
+    double total = 0;
+    if (ws)
+    {
+        long long integral = 0;
+        switch (graph->wideArc ? graph->weightType : GRAPH_WEIGHT_INT32)
+        {
+        case GRAPH_WEIGHT_INT32:
+            status = kruskalInt32(graph, ws, treeEdge, treeEdges, &integral);
+            break;
+        case GRAPH_WEIGHT_INT64:
+            status = kruskalInt64(graph, ws, treeEdge, treeEdges, &integral);
+            break;
+        case GRAPH_WEIGHT_FLOAT:
+            status = kruskalFloat(graph, ws, treeEdge, treeEdges, &total);
+            break;
+        default:
+            status = kruskalDouble(graph, ws, treeEdge, treeEdges, &total);
+            break;
+        }
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+        TRACE_INFO("kruskal", "done", "\"tree_edges\": %d", *treeEdges);
+
+        // Stored edge i is the caller's edge inputEdge[i]
+        for (int k = 0; graph->inputEdge && status != GRAPH_NO_MEMORY && k < *treeEdges; k++)
+        {
+            treeEdge[k] = graph->inputEdge[treeEdge[k]];
+        }
+        if (status != GRAPH_NO_MEMORY)
+        {
+            storeSum(graph->weightType, totalWeight, integral,
+                     graph->wideArc ? total : (double)integral);
+        }
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphKruskalTyped(const struct Graph *graph, int treeEdge[], int *treeEdges,
+                      void *totalWeight)
+{
+    return graphKruskalTypedWs(graph, NULL, treeEdge, treeEdges, totalWeight);
+}
+
+int graphPrimTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace, int root,
+                     int parent[], void *weight, void *totalWeight)
+{
+    if (!graph || !parent || root < 0 || root >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (!graph->wideArc)
+    {
+        long long total = 0;
+        int status = graphPrimWs(graph, workspace, root, parent, weight, &total);
+        if (status == GRAPH_OK || status == GRAPH_NOT_CONNECTED)
+        {
+            widenInts(graph->weightType, weight, weight ? graph->n : 0, false);
+            storeSum(graph->weightType, totalWeight, total, (double)total);
+        }
+        return status;
+    }
+    if (graph->directed)
+    {
+        return GRAPH_NEEDS_UNDIRECTED;
+    }
+
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int status = GRAPH_NO_MEMORY;
+    if (ws)
+    {
+        long long integral = 0;
+        double total = 0;
+        switch (graph->weightType)
+        {
+        case GRAPH_WEIGHT_INT64:
+            status = primInt64(graph, ws, root, parent, weight, &integral);
+            break;
+        case GRAPH_WEIGHT_FLOAT:
+            status = primFloat(graph, ws, root, parent, weight, &total);
+            break;
+        default:
+            status = primDouble(graph, ws, root, parent, weight, &total);
+            break;
+        }
+        if (status != GRAPH_NO_MEMORY)
+        {
+            storeSum(graph->weightType, totalWeight, integral, total);
+        }
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphPrimTyped(const struct Graph *graph, int root, int parent[], void *weight,
+                   void *totalWeight)
+{
+    return graphPrimTypedWs(graph, NULL, root, parent, weight, totalWeight);
+}
+
+int graphMaxFlowTypedWs(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                        int sink, void *flow, void *edgeFlow)
+{
+    if (!graph || !flow || source < 0 || source >= graph->n || sink < 0 || sink >= graph->n)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    if (!graph->wideArc)
+    {
+        int value = 0;
+        int status = graphMaxFlowWs(graph, workspace, source, sink, &value, edgeFlow);
+        if (status == GRAPH_OK)
+        {
+            widenInts(graph->weightType, edgeFlow, edgeFlow ? graph->edgeCount : 0, false);
+            storeSum(graph->weightType, flow, value, value);
+        }
+        return status;
+    }
+    if (graph->minWeight < 0)
+    {
+        return GRAPH_NEGATIVE_WEIGHT;
+    }
+
+    struct GraphWorkspace *owned;
+    struct GraphWorkspace *ws = wsBegin(workspace, &owned);
+    int status = GRAPH_NO_MEMORY;
+    if (ws)
+    {
+        switch (graph->weightType)
+        {
+        case GRAPH_WEIGHT_INT64:
+            status = maxFlowInt64(graph, ws, source, sink, flow, edgeFlow, NULL);
+            break;
+        case GRAPH_WEIGHT_FLOAT:
+            status = maxFlowFloat(graph, ws, source, sink, flow, edgeFlow, NULL);
+            break;
+        default:
+            status = maxFlowDouble(graph, ws, source, sink, flow, edgeFlow, NULL);
+            break;
+        }
+        STAT_PHASE(ws, GRAPH_PHASE_COUNT);
+    }
+    wsEnd(owned);
+    return status;
+}
+
+int graphMaxFlowTyped(const struct Graph *graph, int source, int sink, void *flow,
+                      void *edgeFlow)
+{
+    return graphMaxFlowTypedWs(graph, NULL, source, sink, flow, edgeFlow);
+}
@@ -0,0 +1,698 @@
+/**
+ * @file weight_kernels.h
+ * @brief Shortest-path, spanning-tree and max-flow kernels for one weight type
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * A template in the preprocessor: typed.c includes this file once per
+ * weight type (so it has no include guard) after defining
+ *
+ *   W                  weight type
+ *   W_NAME(name)       name with the type's suffix appended
+ *   W_INF              infinity of the type (the distance of unreachable vertices)
+ *   W_FLOATING         1 for float and double, 0 for integer types
+ *   W_SUM              type of tree weights, flow values and residuals
+ *   W_SUM_INF          largest W_SUM
+ *   W_TOLERANCE        residual at or below capacity * W_TOLERANCE of its own edge
+ *                      counts as empty (infinite capacities are never empty)
+ *   W_ARC(graph, a)    weight of arc a
+ *   W_EDGE(graph, i)   weight of stored edge i
+ *
+ * and undefines them again at the end. Every kernel works on slots and
+ * stored edges; the public functions in typed.c translate at the
+ * boundary. Integer sums saturate at ±W_INF instead of wrapping, and
+ * IEEE arithmetic already saturates at ±infinity.
+ */
+
+/**
+ * @brief Add two weights, saturating instead of overflowing
+ * @param a Distance other than W_INF
+ * @param b Weight
+ * @return a + b clamped to the range of W
+ */
+static inline W W_NAME(add)(W a, W b)
+{
+#if W_FLOATING
+    return a + b;
+#else
+    W sum;
+    if (__builtin_add_overflow(a, b, &sum))
+    {
+        return b > 0 ? W_INF : -W_INF;
+    }
+    return sum;
+#endif
+}
+
+/**
+ * @brief Add two sums, saturating instead of overflowing
+ * @param a Sum
+ * @param b Amount
+ * @return a + b clamped to ±W_SUM_INF
+ */
+static inline W_SUM W_NAME(addSum)(W_SUM a, W_SUM b)
+{
+#if W_FLOATING
+    return a + b;
+#else
+    W_SUM sum;
+    if (__builtin_add_overflow(a, b, &sum))
+    {
+        return b > 0 ? W_SUM_INF : -W_SUM_INF;
+    }
+    return sum;
+#endif
+}
+
+/**
+ * @brief Structure to represent an indexed binary min-heap keyed by W
+ *
+ * Same layout and epoch marks as struct VertexHeap (see graph.c).
+ */
+struct W_NAME(Heap)
+{
+    int size;        // Number of vertices in the heap
+    int *vertex;     // Heap-ordered vertices
+    int *position;   // position[v] = index of v in vertex[], -1 once popped
+    unsigned *stamp; // stamp[v] == epoch once v has been inserted
+    unsigned epoch;  // Epoch of this heap's marks
+    const W *key;    // Keys of all vertices
+    struct GraphStats *stats; // Statistics of the workspace the heap lives in
+};
+
+/**
+ * @brief Set up an empty heap for n vertices in a workspace
+ * @param heap Heap to initialize
+ * @param workspace Workspace of the query (its marks are taken)
+ * @param n Number of vertices
+ * @param key Key array the heap orders by
+ * @return false if memory ran out
+ */
+static bool W_NAME(heapInit)(struct W_NAME(Heap) *heap, struct GraphWorkspace *workspace, int n,
+                             const W key[])
+{
+    heap->size = 0;
+    heap->key = key;
+    heap->stats = &workspace->stats;
+    heap->vertex = wsAlloc(workspace, n * sizeof(int));
+    heap->position = wsAlloc(workspace, n * sizeof(int));
+    heap->stamp = wsMarks(workspace, n, &heap->epoch);
+    return heap->vertex && heap->position && heap->stamp;
+}
+
+/**
+ * @brief Insert v, or restore heap order after key[v] was lowered
+ * @param heap Heap
+ * @param v Vertex
+ */
+static void W_NAME(heapDecrease)(struct W_NAME(Heap) *heap, int v)
+{
+    if (heap->stamp[v] != heap->epoch)
+    {
+        heap->stamp[v] = heap->epoch;
+        heap->vertex[heap->size] = v;
+        heap->position[v] = heap->size++;
+        STAT_ADD(heap->stats, heapPushes, 1);
+    }
+    else
+    {
+        STAT_ADD(heap->stats, heapDecreases, 1);
+    }
+
+    int i = heap->position[v];
+    while (i > 0)
+    {
+        int p = (i - 1) / 2;
+        int u = heap->vertex[p];
+        if (heap->key[u] <= heap->key[v])
+        {
+            break;
+        }
+        heap->vertex[i] = u;
+        heap->position[u] = i;
+        i = p;
+    }
+    heap->vertex[i] = v;
+    heap->position[v] = i;
+}
+
+/**
+ * @brief Remove and return the vertex with the smallest key
+ * @param heap Non-empty heap
+ * @return Vertex with the smallest key
+ */
+static int W_NAME(heapPopMin)(struct W_NAME(Heap) *heap)
+{
+    int top = heap->vertex[0];
+    heap->position[top] = -1;
+    STAT_ADD(heap->stats, heapPops, 1);
+
+    int last = heap->vertex[--heap->size];
+    if (heap->size == 0)
+    {
+        return top;
+    }
+
+    int i = 0;
+    while (2 * i + 1 < heap->size)
+    {
+        int child = 2 * i + 1;
+        if (child + 1 < heap->size &&
+            heap->key[heap->vertex[child + 1]] < heap->key[heap->vertex[child]])
+        {
+            child++;
+        }
+        if (heap->key[heap->vertex[child]] >= heap->key[last])
+        {
+            break;
+        }
+        heap->vertex[i] = heap->vertex[child];
+        heap->position[heap->vertex[i]] = i;
+        i = child;
+    }
+    heap->vertex[i] = last;
+    heap->position[last] = i;
+    return top;
+}
+
+/**
+ * @brief Lower dist[v] through the settled vertex u if that is shorter
+ * @param heap Heap of the search
+ * @param dist Distances
+ * @param parent Parents (may be NULL)
+ * @param u Settled tail
+ * @param v Head
+ * @param weight Arc weight
+ */
+static inline void W_NAME(relaxArc)(struct W_NAME(Heap) *heap, W dist[], int parent[], int u,
+                                    int v, W weight)
+{
+    W candidate = W_NAME(add)(dist[u], weight);
+    if (candidate < dist[v])
+    {
+        dist[v] = candidate;
+        if (parent)
+        {
+            parent[v] = u;
+        }
+        W_NAME(heapDecrease)(heap, v);
+        STAT_ADD(heap->stats, relaxations, 1);
+    }
+}
+
+/**
+ * @brief Run Dijkstra's algorithm on the slots of a graph
+ * @param graph Graph with non-negative weights
+ * @param workspace Workspace of the query
+ * @param source Source slot
+ * @param dist Output: n distances by slot
+ * @param parent Output: n parent slots by slot (may be NULL)
+ * @return GRAPH_OK or GRAPH_NO_MEMORY
+ */
+static int W_NAME(dijkstra)(const struct Graph *graph, struct GraphWorkspace *workspace,
+                            int source, W dist[], int parent[])
+{
+    struct W_NAME(Heap) heap;
+    if (!W_NAME(heapInit)(&heap, workspace, graph->n, dist))
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    for (int v = 0; v < graph->n; v++)
+    {
+        dist[v] = W_INF;
+        if (parent)
+        {
+            parent[v] = -1;
+        }
+    }
+    dist[source] = 0;
+    W_NAME(heapDecrease)(&heap, source);
+    STAT_PHASE(workspace, GRAPH_PHASE_SEARCH);
+
+    while (heap.size > 0)
+    {
+        int u = W_NAME(heapPopMin)(&heap);
+        STAT_ADD(heap.stats, edgesScanned, graph->offset[u + 1] - graph->offset[u]);
+        if (isCompressed(graph))
+        {
+            struct ArcCursor arcs;
+            for (arcsBegin(graph, u, &arcs); arcsNext(graph, &arcs, true);)
+            {
+                W_NAME(relaxArc)(&heap, dist, parent, u, arcs.target, (W)arcs.weight);
+            }
+            continue;
+        }
+        for (int a = graph->offset[u]; a < graph->offset[u + 1]; a++)
+        {
+            W_NAME(relaxArc)(&heap, dist, parent, u, graph->target[a], W_ARC(graph, a));
+        }
+    }
+    return GRAPH_OK;
+}
+
+/**
+ * @brief Relax one arc u → v for Bellman-Ford
+ * @param dist Distances
+ * @param parent Parents (may be NULL)
+ * @param u Tail
+ * @param v Head
+ * @param weight Arc weight
+ * @return true if dist[v] was lowered
+ */
+static inline bool W_NAME(relax)(W dist[], int parent[], int u, int v, W weight)
+{
+    W candidate = dist[u] != W_INF ? W_NAME(add)(dist[u], weight) : W_INF;
+    if (candidate < dist[v])
+    {
+        dist[v] = candidate;
+        if (parent)
+        {
+            parent[v] = u;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Run Bellman-Ford on the slots of a graph
+ * @param graph Graph with its edge list
+ * @param workspace Workspace of the query (statistics only)
+ * @param source Source slot
+ * @param dist Output: n distances by slot
+ * @param parent Output: n parent slots by slot (may be NULL)
+ * @return GRAPH_OK or GRAPH_NEGATIVE_CYCLE
+ */
+static int W_NAME(bellmanFord)(const struct Graph *graph, struct GraphWorkspace *workspace,
+                               int source, W dist[], int parent[])
+{
+    for (int v = 0; v < graph->n; v++)
+    {
+        dist[v] = W_INF;
+        if (parent)
+        {
+            parent[v] = -1;
+        }
+    }
+    dist[source] = 0;
+    STAT_PHASE(workspace, GRAPH_PHASE_SEARCH);
+
+    bool updated = true;
+    for (int pass = 1; pass < graph->n && updated; pass++)
+    {
+        updated = false;
+        for (int i = 0; i < graph->edgeCount; i++)
+        {
+            const struct GraphEdge *e = &graph->edges[i];
+            W weight = W_EDGE(graph, i);
+            bool lowered = W_NAME(relax)(dist, parent, e->u, e->v, weight);
+            if (!graph->directed)
+            {
+                lowered |= W_NAME(relax)(dist, parent, e->v, e->u, weight);
+            }
+            STAT_ADD(&workspace->stats, relaxations, lowered);
+            updated |= lowered;
+        }
+        STAT_ADD(&workspace->stats, passes, 1);
+        STAT_ADD(&workspace->stats, edgesScanned, graph->arcCount);
+    }
+    if (!updated)
+    {
+        return GRAPH_OK;
+    }
+
+    for (int i = 0; i < graph->edgeCount; i++)
+    {
+        const struct GraphEdge *e = &graph->edges[i];
+        W weight = W_EDGE(graph, i);
+        if (dist[e->u] != W_INF && W_NAME(add)(dist[e->u], weight) < dist[e->v])
+        {
+            return GRAPH_NEGATIVE_CYCLE;
+        }
+        if (!graph->directed && dist[e->v] != W_INF && W_NAME(add)(dist[e->v], weight) < dist[e->u])
+        {
+            return GRAPH_NEGATIVE_CYCLE;
+        }
+    }
+    return GRAPH_OK;
+}
+
+/**
+ * @brief Grow a minimum spanning tree from a root with Prim's algorithm
+ *
+ * Only typed graphs whose weights do not fit int get here, and those are
+ * never compressed; the int32 instantiation is unused (graphPrim() is
+ * already exact in int).
+ *
+ * @param graph Undirected graph
+ * @param workspace Workspace of the query
+ * @param root Root slot
+ * @param parent Output: n parent slots by slot
+ * @param weight Output: n weights of the edge to the parent by slot (may be NULL)
+ * @param total Output: sum of the tree edge weights
+ * @return GRAPH_OK, GRAPH_NOT_CONNECTED or GRAPH_NO_MEMORY
+ */
+__attribute__((unused)) static int W_NAME(prim)(const struct Graph *graph,
+                                                struct GraphWorkspace *workspace, int root,
+                                                int parent[], W weight[], W_SUM *total)
+{
+    int n = graph->n;
+    W *key = wsAlloc(workspace, n * sizeof(W));
+    struct W_NAME(Heap) heap;
+    if (!key || !W_NAME(heapInit)(&heap, workspace, n, key))
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    for (int v = 0; v < n; v++)
+    {
+        key[v] = W_INF;
+        parent[v] = -1;
+    }
+    key[root] = 0;
+    W_NAME(heapDecrease)(&heap, root);
+    STAT_PHASE(workspace, GRAPH_PHASE_SEARCH);
+
+    W_SUM sum = 0;
+    int reached = 0;
+    while (heap.size > 0)
+    {
+        int u = W_NAME(heapPopMin)(&heap);
+        sum = W_NAME(addSum)(sum, key[u]);
+        reached++;
+        STAT_ADD(heap.stats, edgesScanned, graph->offset[u + 1] - graph->offset[u]);
+
+        // A vertex is in the tree once the heap has popped it
+        for (int a = graph->offset[u]; a < graph->offset[u + 1]; a++)
+        {
+            int v = graph->target[a];
+            bool popped = heap.stamp[v] == heap.epoch && heap.position[v] == -1;
+            if (!popped && W_ARC(graph, a) < key[v])
+            {
+                key[v] = W_ARC(graph, a);
+                parent[v] = u;
+                W_NAME(heapDecrease)(&heap, v);
+                STAT_ADD(heap.stats, relaxations, 1);
+            }
+        }
+    }
+
+    if (weight)
+    {
+        for (int v = 0; v < n; v++)
+        {
+            weight[v] = parent[v] == -1 ? 0 : key[v];
+        }
+    }
+    *total = sum;
+    return reached < n ? GRAPH_NOT_CONNECTED : GRAPH_OK;
+}
+
+/**
+ * @brief Structure to hold the sort key of one edge
+ */
+struct W_NAME(EdgeKey)
+{
+    W weight;  // Edge weight
+    int index; // Stored edge
+};
+
+/**
+ * @brief Order edges by weight, then by stored position, for qsort()
+ * @param a Pointer to the first key
+ * @param b Pointer to the second key
+ * @return Negative, zero or positive
+ */
+static int W_NAME(compareByWeight)(const void *a, const void *b)
+{
+    const struct W_NAME(EdgeKey) *x = a, *y = b;
+    if (x->weight != y->weight)
+    {
+        return x->weight < y->weight ? -1 : 1;
+    }
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+/**
+ * @brief Build a minimum spanning forest with Kruskal's algorithm
+ * @param graph Undirected graph with its edge list
+ * @param workspace Workspace of the query
+ * @param treeEdge Output: stored indices of up to n - 1 tree edges
+ * @param treeEdges Output: number of tree edges
+ * @param total Output: sum of the tree edge weights
+ * @return GRAPH_OK, GRAPH_NOT_CONNECTED or GRAPH_NO_MEMORY
+ */
+static int W_NAME(kruskal)(const struct Graph *graph, struct GraphWorkspace *workspace,
+                           int treeEdge[], int *treeEdges, W_SUM *total)
+{
+    int n = graph->n, m = graph->edgeCount;
+    struct W_NAME(EdgeKey) *order = wsAlloc(workspace, m * sizeof(struct W_NAME(EdgeKey)));
+    int *link = wsAlloc(workspace, n * sizeof(int));
+    int *size = wsAlloc(workspace, n * sizeof(int));
+    if (!order || !link || !size)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    STAT_PHASE(workspace, GRAPH_PHASE_SORT);
+    for (int i = 0; i < m; i++)
+    {
+        order[i].weight = W_EDGE(graph, i);
+        order[i].index = i;
+    }
+    qsort(order, m, sizeof(struct W_NAME(EdgeKey)), W_NAME(compareByWeight));
+    STAT_PHASE(workspace, GRAPH_PHASE_SEARCH);
+
+    for (int v = 0; v < n; v++)
+    {
+        link[v] = v;
+        size[v] = 1;
+    }
+
+    W_SUM sum = 0;
+    int count = 0;
+    for (int k = 0; k < m && count < n - 1; k++)
+    {
+        const struct GraphEdge *e = &graph->edges[order[k].index];
+        int a = e->u, b = e->v;
+        while (link[a] != a)
+        {
+            link[a] = link[link[a]];
+            a = link[a];
+        }
+        while (link[b] != b)
+        {
+            link[b] = link[link[b]];
+            b = link[b];
+        }
+        STAT_ADD(&workspace->stats, edgesScanned, 1);
+        STAT_ADD(&workspace->stats, findCalls, 2);
+        if (a == b)
+        {
+            continue; // Would close a cycle
+        }
+        if (size[a] < size[b])
+        {
+            int tmp = a;
+            a = b;
+            b = tmp;
+        }
+        link[b] = a;
+        size[a] += size[b];
+        STAT_ADD(&workspace->stats, unionCalls, 1);
+
+        treeEdge[count++] = order[k].index;
+        sum = W_NAME(addSum)(sum, order[k].weight);
+    }
+
+    *treeEdges = count;
+    *total = sum;
+    return n > 0 && count < n - 1 ? GRAPH_NOT_CONNECTED : GRAPH_OK;
+}
+
+/**
+ * @brief Get the residual at or below which an arc of the residual copy is empty
+ *
+ * Rounding leaves float residuals a few ulps above zero. The threshold
+ * scales with the capacity of the arc's own edge, so one huge or
+ * infinite capacity does not swallow the small ones.
+ *
+ * @param graph Graph
+ * @param a Arc of the residual copy (2i or 2i + 1 for stored edge i)
+ * @return Largest residual that counts as empty
+ */
+static inline W_SUM W_NAME(emptyBelow)(const struct Graph *graph, int a)
+{
+#if W_FLOATING
+    W_SUM capacity = W_EDGE(graph, a >> 1);
+    return capacity < W_SUM_INF ? capacity * W_TOLERANCE : 0;
+#else
+    (void)graph;
+    (void)a;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Compute a maximum flow with Edmonds-Karp on a residual copy of the graph
+ *
+ * Every stored edge i gets arcs 2i (forward) and 2i + 1 (backward, with
+ * the capacity again if undirected), grouped by tail in a CSR of arc
+ * numbers so each BFS scans the arcs of one vertex at a time. Snapshots
+ * hold the net flow of every stored edge, which fits int for int32
+ * capacities; the residuals and the flow value follow from it.
+ *
+ * @param graph Graph with non-negative weights and its edge list
+ * @param workspace Workspace of the query
+ * @param source Source slot
+ * @param sink Sink slot
+ * @param flow Output: flow value
+ * @param edgeFlow Output: flow of every stored edge, negative from v to u
+ *                 (may be NULL)
+ * @param checkpoint Checkpointer (int32 only; NULL = none)
+ * @return GRAPH_OK, GRAPH_NO_MEMORY or the failure of checkpointRestore()
+ */
+static int W_NAME(maxFlow)(const struct Graph *graph, struct GraphWorkspace *workspace, int source,
+                           int sink, W_SUM *flow, W edgeFlow[], struct Checkpointer *checkpoint)
+{
+    int n = graph->n, m = graph->edgeCount;
+    int *first = wsAlloc(workspace, (n + 1) * sizeof(int));
+    int *arcAt = wsAlloc(workspace, 2 * (size_t)m * sizeof(int));
+    int *tail = wsAlloc(workspace, 2 * (size_t)m * sizeof(int));
+    W_SUM *residual = wsAlloc(workspace, 2 * (size_t)m * sizeof(W_SUM));
+    int *via = wsAlloc(workspace, n * sizeof(int)); // Arc that reached every vertex
+    int *queue = wsAlloc(workspace, n * sizeof(int));
+    // Net flow of every stored edge: capacity - residual is NaN for infinite capacities
+    W_SUM *net = edgeFlow || checkpoint ? wsAlloc(workspace, (size_t)m * sizeof(W_SUM) + 1) : NULL;
+    int *saved = checkpoint ? wsAlloc(workspace, (size_t)m * sizeof(int) + 1) : NULL;
+    if (!first || !arcAt || !tail || !residual || !via || !queue || (edgeFlow && !net) ||
+        (checkpoint && (!net || !saved)))
+    {
+        return GRAPH_NO_MEMORY;
+    }
+
+    // Residual arcs grouped by tail
+    memset(first, 0, (n + 1) * sizeof(int));
+    for (int i = 0; i < m; i++)
+    {
+        W_SUM capacity = W_EDGE(graph, i);
+        tail[2 * i] = graph->edges[i].u;
+        tail[2 * i + 1] = graph->edges[i].v;
+        residual[2 * i] = capacity;
+        residual[2 * i + 1] = graph->directed ? 0 : capacity;
+        if (net)
+        {
+            net[i] = 0;
+        }
+        first[tail[2 * i] + 1]++;
+        first[tail[2 * i + 1] + 1]++;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        first[v + 1] += first[v];
+    }
+    for (int a = 0; a < 2 * m; a++)
+    {
+        arcAt[first[tail[a]]++] = a;
+    }
+    for (int v = n; v > 0; v--)
+    {
+        first[v] = first[v - 1];
+    }
+    first[0] = 0;
+
+    // A resumed run pushes the saved net flows back through their arcs
+    W_SUM total = 0;
+    long long resumed = -1;
+    int status = checkpoint ? checkpointRestore(checkpoint, m, saved, NULL, &resumed) : GRAPH_OK;
+    if (status != GRAPH_OK)
+    {
+        return status;
+    }
+    for (int i = 0; resumed >= 0 && i < m; i++)
+    {
+        net[i] = saved[i];
+        residual[2 * i] -= net[i];
+        residual[2 * i + 1] += net[i];
+        const struct GraphEdge *e = &graph->edges[i];
+        total += e->u == e->v ? 0 : e->u == source ? net[i] : e->v == source ? -net[i] : 0;
+    }
+    STAT_PHASE(workspace, GRAPH_PHASE_SEARCH);
+
+    while (source != sink)
+    {
+        // Shortest augmenting path by BFS; via[v] == -1 until v is reached
+        for (int v = 0; v < n; v++)
+        {
+            via[v] = -1;
+        }
+        via[source] = 2 * m;
+        int head = 0, size = 0;
+        queue[size++] = source;
+        while (head < size && via[sink] == -1)
+        {
+            int u = queue[head++];
+            STAT_ADD(&workspace->stats, edgesScanned, first[u + 1] - first[u]);
+            for (int k = first[u]; k < first[u + 1]; k++)
+            {
+                int a = arcAt[k];
+                int v = tail[a ^ 1];
+                if (via[v] == -1 && residual[a] > W_NAME(emptyBelow)(graph, a))
+                {
+                    via[v] = a;
+                    queue[size++] = v;
+                }
+            }
+        }
+        if (via[sink] == -1)
+        {
+            break;
+        }
+
+        W_SUM bottleneck = W_SUM_INF;
+        for (int v = sink; v != source; v = tail[via[v]])
+        {
+            bottleneck = residual[via[v]] < bottleneck ? residual[via[v]] : bottleneck;
+        }
+        for (int v = sink; v != source; v = tail[via[v]])
+        {
+            residual[via[v]] -= bottleneck;
+            residual[via[v] ^ 1] = W_NAME(addSum)(residual[via[v] ^ 1], bottleneck);
+            if (net)
+            {
+                net[via[v] >> 1] += via[v] & 1 ? -bottleneck : bottleneck;
+            }
+        }
+        total = W_NAME(addSum)(total, bottleneck);
+        STAT_ADD(&workspace->stats, augmentingPaths, 1);
+        if (checkpoint && checkpointDue(checkpoint))
+        {
+            for (int i = 0; i < m; i++)
+            {
+                saved[i] = (int)net[i];
+            }
+            checkpointSave(checkpoint, (long long)total, m, saved, NULL);
+        }
+    }
+
+    if (edgeFlow)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            edgeFlow[i] = (W)net[i];
+        }
+    }
+    *flow = total;
+    return GRAPH_OK;
+}
+
+#undef W
+#undef W_NAME
+#undef W_INF
+#undef W_FLOATING
+#undef W_SUM
+#undef W_SUM_INF
+#undef W_TOLERANCE
+#undef W_ARC
+#undef W_EDGE
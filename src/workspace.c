@@ -0,0 +1,235 @@
+/**
+ * @file workspace.c
+ * @brief Reusable query workspaces of libgraph: scratch arena, epoch
+ *        marks and cached per-graph state
+ * @author İshak Duran (22060664)
+ * @date 2025
+ *
+ * A query asks the workspace for its scratch arrays instead of calling
+ * malloc(). The arena hands them out by bumping an offset and is rewound
+ * at the start of the next query, so a service that reuses one
+ * workspace per thread stops allocating after its first (largest)
+ * queries.
+ *
+ * Time Complexity: O(1) per scratch array and per set of marks
+ * Space Complexity: O(peak scratch of one query) plus the cached state
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph_internal.h"
+#include "bfs.h"
+#include "flow.h"
+
+#define WS_ALIGN 64 // Alignment of every scratch array (one cache line)
+
+int graphWorkspaceCreate(struct GraphWorkspace **workspace)
+{
+    if (!workspace)
+    {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+    *workspace = calloc(1, sizeof(struct GraphWorkspace));
+    if (!*workspace)
+    {
+        return GRAPH_NO_MEMORY;
+    }
+    (*workspace)->phase = GRAPH_PHASE_COUNT;
+    return GRAPH_OK;
+}
+
+/**
+ * @brief Free the extra blocks of the current query
+ * @param workspace Workspace
+ */
+static void freeExtraBlocks(struct GraphWorkspace *workspace)
+{
+    while (workspace->extra)
+    {
+        void *next = *(void **)workspace->extra;
+        free(workspace->extra);
+        workspace->extra = next;
+    }
+}
+
+void graphWorkspaceFree(struct GraphWorkspace *workspace)
+{
+    if (!workspace)
+    {
+        return;
+    }
+    freeExtraBlocks(workspace);
+    graphFreeLarge(workspace->block);
+    free(workspace->stamp);
+    freeBfsEngine(workspace->bfs);
+    free(workspace->inOffset);
+    free(workspace->inSource);
+    free(workspace->inArc);
+    freeFlowNetwork(workspace->flow);
+    free(workspace->edgeArc);
+    free(workspace);
+}
+
+long long graphWorkspaceAllocations(const struct GraphWorkspace *workspace)
+{
+    return workspace->allocations;
+}
+
+struct GraphWorkspace *wsBegin(struct GraphWorkspace *workspace, struct GraphWorkspace **owned)
+{
+    *owned = NULL;
+    if (!workspace)
+    {
+        if (graphWorkspaceCreate(owned) != GRAPH_OK)
+        {
+            return NULL;
+        }
+        return *owned;
+    }
+    STAT_ADD(&workspace->stats, queries, 1);
+    STAT_PHASE(workspace, GRAPH_PHASE_SETUP);
+
+    // Merge the last query's extra blocks into one block that fits it all
+    if (workspace->extra)
+    {
+        size_t need = workspace->used + workspace->overflow + WS_ALIGN;
+        freeExtraBlocks(workspace);
+        graphFreeLarge(workspace->block);
+        workspace->block = graphAllocLarge(need);
+        workspace->capacity = workspace->block ? need : 0;
+        workspace->allocations++;
+    }
+    workspace->used = 0;
+    workspace->overflow = 0;
+    return workspace;
+}
+
+void wsEnd(struct GraphWorkspace *owned)
+{
+    graphWorkspaceFree(owned);
+}
+
+void *wsAlloc(struct GraphWorkspace *workspace, size_t bytes)
+{
+    // Align the address, not the offset: malloc() only promises 16 bytes
+    if (workspace->block)
+    {
+        uintptr_t base = (uintptr_t)workspace->block;
+        size_t start = ((base + workspace->used + WS_ALIGN - 1) & ~(uintptr_t)(WS_ALIGN - 1)) - base;
+        if (start + bytes <= workspace->capacity)
+        {
+            workspace->used = start + bytes;
+            return workspace->block + start;
+        }
+    }
+
+    // Out of room: serve this array from an extra block. Its first
+    // WS_ALIGN bytes link it into the list freed at the next rewind.
+    size_t size = 2 * WS_ALIGN + bytes;
+    unsigned char *extra = malloc(size);
+    if (!extra)
+    {
+        return NULL;
+    }
+    workspace->allocations++;
+    workspace->overflow += size;
+    *(void **)extra = workspace->extra;
+    workspace->extra = extra;
+
+    uintptr_t start = ((uintptr_t)extra + WS_ALIGN + WS_ALIGN - 1) & ~(uintptr_t)(WS_ALIGN - 1);
+    return (void *)start;
+}
+
+unsigned *wsMarks(struct GraphWorkspace *workspace, int n, unsigned *epoch)
+{
+    if (n > workspace->stampCount)
+    {
+        free(workspace->stamp);
+        workspace->stamp = calloc((size_t)n, sizeof(unsigned));
+        workspace->stampCount = workspace->stamp ? n : 0;
+        workspace->epoch = 0;
+        workspace->allocations++;
+        if (!workspace->stamp)
+        {
+            return NULL;
+        }
+    }
+
+    // The O(n) clear only happens once every 2^32 uses
+    if (++workspace->epoch == 0)
+    {
+        memset(workspace->stamp, 0, workspace->stampCount * sizeof(unsigned));
+        workspace->epoch = 1;
+    }
+    *epoch = workspace->epoch;
+    return workspace->stamp;
+}
+
+struct BfsEngine *wsBfsEngine(struct GraphWorkspace *workspace, int n, int threads)
+{
+    // The pool may have been reconfigured since the engine was made
+    int parts = threads > 0 ? threads : poolThreads();
+    struct BfsEngine *engine = workspace->bfs;
+    if (engine && engine->n == n && engine->threads == parts)
+    {
+        return engine;
+    }
+
+    freeBfsEngine(engine);
+    workspace->bfs = createBfsEngine(n, parts);
+    workspace->allocations++;
+    return workspace->bfs;
+}
+
+bool wsInArcs(struct GraphWorkspace *workspace, const struct Graph *graph)
+{
+    if (workspace->inSerial == graph->serial)
+    {
+        return true;
+    }
+
+    free(workspace->inOffset);
+    free(workspace->inSource);
+    free(workspace->inArc);
+    workspace->inOffset = malloc((graph->n + 1) * sizeof(int));
+    workspace->inSource = malloc(graph->arcCount * sizeof(int) + 1);
+    workspace->inArc = malloc(graph->arcCount * sizeof(int) + 1);
+    workspace->allocations++;
+    if (!workspace->inOffset || !workspace->inSource || !workspace->inArc)
+    {
+        workspace->inSerial = 0;
+        return false;
+    }
+
+    buildInArcs(graph->n, graph->offset, graph->target, workspace->inOffset,
+                workspace->inSource, workspace->inArc);
+    workspace->inSerial = graph->serial;
+    return true;
+}
+
+struct FlowNetwork *wsFlowNetwork(struct GraphWorkspace *workspace, const struct Graph *graph)
+{
+    if (workspace->flowSerial == graph->serial)
+    {
+        return workspace->flow;
+    }
+
+    freeFlowNetwork(workspace->flow);
+    free(workspace->edgeArc);
+    workspace->flow = NULL;
+    workspace->flowSerial = 0;
+    workspace->edgeArc = malloc(graph->edgeCount * sizeof(int) + 1);
+    workspace->allocations++;
+    if (workspace->edgeArc)
+    {
+        workspace->flow = createFlowNetworkFromEdges(graph->n, graph->edgeCount, graph->edges,
+                                                     graph->directed, workspace->edgeArc);
+    }
+    if (workspace->flow)
+    {
+        workspace->flowSerial = graph->serial;
+    }
+    return workspace->flow;
+}